@@ -1,5 +1,7 @@
 import re # Expresiones regulares
 import sys # Argumentos de línea de comandos
+from math import gcd # Máximo común divisor para elegir la unidad de tiempo
+from collections import Counter # Conteo de segmentos para verificar la optimización
 
 # Mapeo de funciones a códigos
 MAPA_DIRECCIONES = {
@@ -15,7 +17,30 @@ MAPA_DIRECCIONES = {
     "PLOTTER_ARRIBA_NO_BAJAR": "u"
 }
 
-# Convierte una línea de código a formato de paso
+# Formato empaquetado (lo lee EJECUTAR_FIGURA desde la memoria de programa, byte por byte):
+#   unidad (número variable): ms de cada cuenta de los movimientos (el máximo común divisor de sus tiempos)
+#   movimiento: un byte [dirección (2 bits) | pluma (1 bit) | cuenta (5 bits)]
+#       dirección: 0 = D, 1 = I, 2 = U, 3 = A; pluma: 1 = mayúscula (con la pluma), 0 = minúscula (sin bajar)
+#       cuenta 1 a 30: tiempo = cuenta · unidad; cuenta 31: le sigue un número variable n y el tiempo es (31 + n) · unidad
+#   'B' = 0x00 y 'S' = 0x40, seguidos del tiempo en ms como número variable
+#   fin de figura = 0xC0
+# Los números variables van de a 7 bits, empezando por los bajos, con el bit 7 en 1 si sigue otro byte.
+# Los movimientos consecutivos con el mismo código se unen en uno solo sumando sus tiempos.
+DIRECCIONES = "DIUA" # Índice de cada dirección en el campo de 2 bits
+CUENTA_DIRECTA = 30 # Mayor cuenta que entra en el byte del movimiento
+CODIGO_BAJAR, CODIGO_SUBIR, CODIGO_FIN = 0x00, 0x40, 0xC0 # Bytes de los comandos
+
+# Datos de los firmwares para estimar el tiempo de dibujo
+SOLENOIDE_LAB2 = 250 # ms que esperan PLOTTER_BAJAR y PLOTTER_SUBIR en el Laboratorio N°2 (más el tiempo del paso)
+ESCALA_LAB3 = 3 / 10 # Pasos por ms de figura en el Laboratorio N°3 (ESCALA_FIGURAS = Q12(0.3) en Q4.12, 1229/4096 ≈ 0,3)
+FLANCOS_POR_SEGUNDO_LAB3 = 20000 # Velocidad de crucero del Laboratorio N°3 (2 · FRECUENCIA_MAXIMA)
+BAJAR_LAB3 = 0.030 # Segundos que espera el Laboratorio N°3 al bajar el solenoide (TIEMPO_BAJAR_MS)
+
+# Optimización del recorrido con la pluma levantada
+VECTORES = {"D": (1, 0), "I": (-1, 0), "U": (0, 1), "A": (0, -1)} # Desplazamiento de cada dirección
+OPUESTA = {"D": "I", "I": "D", "U": "A", "A": "U", "d": "i", "i": "d", "u": "a", "a": "u"} # Dirección contraria
+
+# Convierte una línea de código a un paso (código, tiempo)
 def convertir_linea(linea):
     match = re.search(r'(PLOTTER_[A-Z_]+).*?_delay_ms\((\d+)\)', linea) # Busca función y tiempo
     # Si no hay coincidencia, retorna None
@@ -26,41 +51,271 @@ def convertir_linea(linea):
     if funcion not in MAPA_DIRECCIONES:
         print(f"[ADVERTENCIA] Dirección desconocida: {funcion}") # Función no mapeada
         return None # Retorna None
-    codigo = MAPA_DIRECCIONES[funcion] # Obtiene el código correspondiente
-    return f"{{'{codigo}', {tiempo}}}" # Formatea el paso
+    return MAPA_DIRECCIONES[funcion], int(tiempo) # Código y tiempo del paso
 
-# Convierte un archivo de entrada a un archivo de salida
-def convertir_archivo(entrada, salida):
-    with open(entrada, "r", encoding="utf-8") as f: # Abre archivo de entrada
-        lineas = f.readlines() # Lee todas las líneas
+# Busca los arreglos de pasos ya convertidos (const Paso NOMBRE[] PROGMEM = {...}) y devuelve {nombre: pasos}
+def leer_arreglos(texto):
+    arreglos = {} # Arreglos encontrados en orden
+    for m in re.finditer(r'const\s+Paso\s+(\w+)\[\]\s*PROGMEM\s*=\s*\{(.*?)\n\};', texto, re.S): # Cada arreglo
+        pasos = re.findall(r"\{'(.)'(?:\s*,\s*(\d+))?\}", m.group(2)) # Cada paso {'X', t} o {'X'}
+        arreglos[m.group(1)] = [(c, int(t or 0)) for c, t in pasos] # Los pasos sin tiempo valen 0
+    return arreglos
 
-    pasos = [] # Lista para almacenar los pasos convertidos
-    for linea in lineas: # Itera sobre cada línea
-        paso = convertir_linea(linea) # Convierte la línea
-        if paso: # Si se obtuvo un paso válido
-            pasos.append(paso) # Agrega el paso a la lista
+# Agrega un número de longitud variable a los datos
+def agregar_variable(datos, valor):
+    while True:
+        byte = valor & 0x7F # 7 bits bajos
+        valor >>= 7 # Se descartan
+        datos.append(byte | (0x80 if valor else 0)) # El bit 7 indica que sigue otro byte
+        if not valor:
+            return
 
-    # Escribe los pasos convertidos en el archivo de salida
-    with open(salida, "w", encoding="utf-8") as out:
-        out.write("const Paso figura[] PROGMEM = {\n    ")
+# Une los movimientos consecutivos con el mismo código y descarta los que no tienen tiempo
+def unir_movimientos(pasos):
+    unidos = [] # Pasos resultantes
+    for codigo, tiempo in pasos:
+        if codigo in "BS": # Los comandos del solenoide se conservan tal cual
+            unidos.append((codigo, tiempo))
+        elif tiempo > 0: # Los movimientos sin tiempo no hacen nada
+            if unidos and unidos[-1][0] == codigo: # Mismo movimiento que el anterior
+                unidos[-1] = (codigo, unidos[-1][1] + tiempo) # Se suma el tiempo
+            else:
+                unidos.append((codigo, tiempo))
+    return unidos
+
+# Empaqueta una lista de pasos y devuelve los bytes y la cantidad de pasos resultantes
+def empaquetar(pasos):
+    unidos = unir_movimientos(pasos) # Movimientos unidos
+
+    unidad = 0 # Máximo común divisor de los tiempos de los movimientos
+    for codigo, tiempo in unidos:
+        if codigo not in "BS":
+            unidad = gcd(unidad, tiempo)
+    unidad = unidad or 1 # Una figura sin movimientos usa unidad 1
+
+    datos = bytearray() # Bytes empaquetados
+    agregar_variable(datos, unidad) # Encabezado con la unidad
+    for codigo, tiempo in unidos:
+        if codigo in "BS": # Comando del solenoide con su tiempo
+            datos.append(CODIGO_BAJAR if codigo == "B" else CODIGO_SUBIR)
+            agregar_variable(datos, tiempo)
+            continue
+        cuenta = tiempo // unidad # Tiempo en unidades
+        cabecera = (DIRECCIONES.index(codigo.upper()) << 6) | (0x20 if codigo.isupper() else 0) # Dirección y pluma
+        if cuenta <= CUENTA_DIRECTA: # La cuenta entra en el byte
+            datos.append(cabecera | cuenta)
+        else: # La cuenta sigue como número variable
+            datos.append(cabecera | 31)
+            agregar_variable(datos, cuenta - 31)
+    datos.append(CODIGO_FIN) # Fin de la figura
+    return bytes(datos), len(unidos)
+
+# Recorre los bytes empaquetados y devuelve los pasos (se usa para verificar la conversión)
+def desempaquetar(datos):
+    pos = 0 # Posición de lectura
+    def leer_variable():
+        nonlocal pos
+        valor = desplazamiento = 0
+        while True:
+            byte = datos[pos]; pos += 1
+            valor |= (byte & 0x7F) << desplazamiento # Se agregan 7 bits
+            desplazamiento += 7
+            if not byte & 0x80:
+                return valor
+    unidad = leer_variable() # Encabezado
+    pasos = []
+    while True:
+        byte = datos[pos]; pos += 1
+        cuenta = byte & 0x1F # Cuenta del movimiento (0 en los comandos)
+        if cuenta == 0: # Comando
+            if byte == CODIGO_FIN:
+                return pasos
+            pasos.append(("B" if byte == CODIGO_BAJAR else "S", leer_variable()))
+            continue
+        if cuenta == 31: # La cuenta sigue como número variable
+            cuenta += leer_variable()
+        letra = DIRECCIONES[byte >> 6] # Dirección
+        pasos.append((letra if byte & 0x20 else letra.lower(), cuenta * unidad))
+
+# Divide una figura en trazos: bloques de pasos separados por traslados con la pluma levantada (minúsculas). Devuelve
+# los bloques con su punto de entrada y de salida, y el punto final de la figura (la figura arranca en (0, 0))
+def separar_trazos(pasos):
+    x = y = 0 # Posición actual
+    bloques = [] # Trazos encontrados
+    actual = None # Trazo en curso
+    for codigo, tiempo in pasos:
+        if codigo in "diua": # Traslado: termina el trazo en curso
+            actual = None
+        else: # Movimiento con pluma o comando del solenoide: pertenece a un trazo
+            if actual is None: # Empieza un trazo nuevo
+                actual = {"pasos": [], "entrada": (x, y)}
+                bloques.append(actual)
+            actual["pasos"].append((codigo, tiempo))
+        if codigo.upper() in VECTORES: # Se actualiza la posición
+            vx, vy = VECTORES[codigo.upper()]
+            x, y = x + vx * tiempo, y + vy * tiempo
+        if actual is not None:
+            actual["salida"] = (x, y)
+    for b in bloques: # Un trazo se puede recorrer al revés si los comandos están solo al principio y al final
+        codigos = "".join("C" if c in "BS" else "M" for c, _ in b["pasos"])
+        b["reversible"] = "C" not in codigos.strip("C") # Sin comandos entre los movimientos
+    return bloques, (x, y)
+
+# Devuelve los pasos de un trazo recorrido al revés (los comandos del principio y del final quedan en su lugar)
+def invertir_trazo(pasos):
+    i = 0
+    while i < len(pasos) and pasos[i][0] in "BS": # Comandos iniciales
+        i += 1
+    j = len(pasos)
+    while j > i and pasos[j - 1][0] in "BS": # Comandos finales
+        j -= 1
+    medio = [(OPUESTA[c], t) for c, t in reversed(pasos[i:j])] # Movimientos en orden inverso y sentido contrario
+    return pasos[:i] + medio + pasos[j:]
+
+# Distancia de un traslado: los ejes se mueven uno después del otro
+def distancia(p, q):
+    return abs(p[0] - q[0]) + abs(p[1] - q[1])
 
-        for i, p in enumerate(pasos): # Itera sobre los pasos convertidos
-            out.write(p) # Escribe el paso
-            # Escribe la coma y el salto de línea si es necesario
-            if i != len(pasos) - 1:
-                out.write(", ") # Coma entre pasos
-            # Añade un salto de línea cada 10 pasos para mejor legibilidad
-            if (i + 1) % 10 == 0 and i != len(pasos) - 1:
-                out.write("\n    ") # Salto de línea y sangría
+# Ordena los trazos para minimizar el recorrido con la pluma levantada desde el inicio hasta el final de la figura:
+# vecino más cercano (eligiendo también el sentido de cada trazo) y luego 2-opt, que invierte tramos de la secuencia
+# mientras eso acorte los traslados. Devuelve la lista de (trazo, invertido)
+def ordenar_trazos(bloques, fin):
+    pendientes = list(range(len(bloques))) # Trazos sin ubicar
+    orden = [] # Secuencia resultante de (índice, invertido)
+    pos = (0, 0) # Se parte del inicio de la figura
+    while pendientes: # Vecino más cercano
+        mejor = None
+        for k in pendientes:
+            for invertido in ((False, True) if bloques[k]["reversible"] else (False,)):
+                entrada = bloques[k]["salida" if invertido else "entrada"]
+                d = distancia(pos, entrada)
+                if mejor is None or d < mejor[0]:
+                    mejor = (d, k, invertido)
+        _, k, invertido = mejor
+        pendientes.remove(k)
+        orden.append((k, invertido))
+        pos = bloques[k]["entrada" if invertido else "salida"]
 
-        out.write("\n};\n") # Cierra la definición del array
+    def entrada(e): # Punto donde empieza un trazo según su sentido
+        return bloques[e[0]]["salida" if e[1] else "entrada"]
+    def salida(e): # Punto donde termina un trazo según su sentido
+        return bloques[e[0]]["entrada" if e[1] else "salida"]
+
+    mejora = True
+    while mejora: # 2-opt: se invierte el tramo i..j si acorta los traslados de sus extremos
+        mejora = False
+        for i in range(len(orden)):
+            anterior = salida(orden[i - 1]) if i else (0, 0)
+            for j in range(i, len(orden)):
+                if not all(bloques[k]["reversible"] for k, _ in orden[i:j + 1]):
+                    break # No se puede invertir un tramo con trazos que no admiten el sentido contrario
+                siguiente = entrada(orden[j + 1]) if j + 1 < len(orden) else fin
+                antes = distancia(anterior, entrada(orden[i])) + distancia(salida(orden[j]), siguiente)
+                despues = distancia(anterior, salida(orden[j])) + distancia(entrada(orden[i]), siguiente)
+                if despues < antes: # Se invierte el tramo: cambia el orden y el sentido de cada trazo
+                    orden[i:j + 1] = [(k, not inv) for k, inv in reversed(orden[i:j + 1])]
+                    mejora = True
+    return orden
+
+# Pasos de traslado con la pluma levantada desde p hasta q (primero X y después Y)
+def trasladar(p, q):
+    pasos = []
+    dx, dy = q[0] - p[0], q[1] - p[1]
+    if dx:
+        pasos.append(("d" if dx > 0 else "i", abs(dx)))
+    if dy:
+        pasos.append(("u" if dy > 0 else "a", abs(dy)))
+    return pasos
+
+# Reordena los trazos de una figura y devuelve los pasos nuevos. El dibujo y el punto final no cambian
+def optimizar_recorrido(pasos):
+    bloques, fin = separar_trazos(pasos)
+    resultado = []
+    pos = (0, 0)
+    for k, invertido in ordenar_trazos(bloques, fin):
+        b = bloques[k]
+        entrada, salida = (b["salida"], b["entrada"]) if invertido else (b["entrada"], b["salida"])
+        resultado += trasladar(pos, entrada) # Traslado hasta el trazo
+        resultado += invertir_trazo(b["pasos"]) if invertido else b["pasos"] # Trazo
+        pos = salida
+    resultado += trasladar(pos, fin) # Traslado hasta el final original de la figura
+    return resultado
+
+# Segmentos dibujados con la pluma (sin importar orden ni sentido), para verificar que el dibujo no cambió
+def segmentos_dibujados(pasos):
+    x = y = 0
+    segmentos = Counter()
+    for codigo, tiempo in pasos:
+        if codigo.upper() in VECTORES:
+            vx, vy = VECTORES[codigo.upper()]
+            nx, ny = x + vx * tiempo, y + vy * tiempo
+            if codigo.isupper():
+                segmentos[tuple(sorted(((x, y), (nx, ny))))] += 1
+            x, y = nx, ny
+    return segmentos, (x, y)
+
+# Devuelve el recorrido con la pluma levantada y el tiempo estimado de dibujo en cada laboratorio (en segundos)
+def medir(pasos):
+    traslado = sum(t for c, t in pasos if c in "diua") # Unidades recorridas sin dibujar
+    movimiento = sum(t for c, t in pasos if c.upper() in VECTORES) # Unidades recorridas en total
+    comandos = [t for c, t in pasos if c in "BS"] # Tiempos de los comandos del solenoide
+    lab2 = (movimiento + sum(SOLENOIDE_LAB2 + t for t in comandos)) / 1000 # Los movimientos se miden en ms
+    lab3 = movimiento * ESCALA_LAB3 / FLANCOS_POR_SEGUNDO_LAB3 + BAJAR_LAB3 * sum(1 for c, _ in pasos if c == "B") # Sin rampas
+    return traslado, lab2, lab3
+
+# Escribe un arreglo empaquetado como código C
+def escribir_empaquetado(out, nombre, datos):
+    out.write(f"const uint8_t {nombre}[] PROGMEM = {{\n    ")
+    for i, b in enumerate(datos): # Itera sobre los bytes
+        out.write(f"0x{b:02X}") # Escribe el byte
+        if i != len(datos) - 1:
+            out.write(", ") # Coma entre bytes
+        # Añade un salto de línea cada 16 bytes para mejor legibilidad
+        if (i + 1) % 16 == 0 and i != len(datos) - 1:
+            out.write("\n    ") # Salto de línea y sangría
+    out.write("\n};\n")
+
+# Convierte un archivo de entrada a un archivo de salida con las figuras empaquetadas. La entrada puede ser código con
+# llamadas PLOTTER_*() y _delay_ms() (genera un arreglo 'figura') o un archivo con arreglos 'const Paso' (los convierte a todos)
+def convertir_archivo(entrada, salida, optimizar=True):
+    with open(entrada, "r", encoding="utf-8") as f: # Abre archivo de entrada
+        texto = f.read() # Lee todo el archivo
+
+    figuras = leer_arreglos(texto) # Arreglos ya existentes
+    if not figuras: # Si no hay, se convierten las llamadas a funciones
+        pasos = [] # Lista para almacenar los pasos convertidos
+        for linea in texto.splitlines(): # Itera sobre cada línea
+            paso = convertir_linea(linea) # Convierte la línea
+            if paso: # Si se obtuvo un paso válido
+                pasos.append(paso) # Agrega el paso a la lista
+        figuras = {"figura": pasos}
+
+    total_original = total_bytes = 0 # Totales para el informe
+    with open(salida, "w", encoding="utf-8") as out:
+        for nombre, pasos in figuras.items():
+            original = len(pasos) * 3 # Cada Paso ocupa 3 bytes en flash
+            if optimizar: # Se reordenan los trazos para acortar los traslados
+                nuevos = optimizar_recorrido(pasos)
+                if segmentos_dibujados(nuevos) != segmentos_dibujados(pasos): # El dibujo y el final deben ser los mismos
+                    raise ValueError(f"{nombre}: la optimización cambió el dibujo")
+                antes, despues = medir(pasos), medir(nuevos)
+                print(f"{nombre}: traslados {antes[0]} -> {despues[0]} | tiempo estimado Lab 2 {antes[1]:.1f} -> {despues[1]:.1f} s | Lab 3 {antes[2]:.2f} -> {despues[2]:.2f} s")
+                pasos = nuevos
+            datos, n_unidos = empaquetar(pasos) # Formato empaquetado
+            if desempaquetar(datos) != unir_movimientos(pasos): # Verificación de ida y vuelta
+                raise ValueError(f"{nombre}: la figura empaquetada no coincide con la original")
+            escribir_empaquetado(out, nombre, datos)
+            out.write("\n")
+            print(f"{nombre}: {original // 3} pasos ({original} bytes) -> {n_unidos} pasos en {len(datos)} bytes | relación {original / len(datos):.2f}:1")
+            total_original += original
+            total_bytes += len(datos)
 
-    print(f"Conversión completa. {len(pasos)} pasos generados → {salida}")
+    print(f"Conversión completa. {total_original} bytes -> {total_bytes} bytes ({100 * total_bytes / total_original:.1f} %) → {salida}")
 
 # Punto de entrada del script
 if __name__ == "__main__":
     # Verifica argumentos de línea de comandos
-    if len(sys.argv) < 3: 
-        print("Uso: python convertir_figura.py <entrada.c> <salida.c>") # Muestra uso correcto
+    if len(sys.argv) < 3:
+        print("Uso: python convertir_figura.py <entrada.c> <salida.c> [--sin-optimizar]") # Muestra uso correcto
     else:
-        convertir_archivo(sys.argv[1], sys.argv[2]) # Llama a la función de conversión con los archivos proporcionados
+        convertir_archivo(sys.argv[1], sys.argv[2], "--sin-optimizar" not in sys.argv[3:]) # Llama a la función de conversión con los archivos proporcionados
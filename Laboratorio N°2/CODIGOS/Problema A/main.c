@@ -3,7 +3,7 @@
 #define BPS ((F_CPU / (16UL * BAUD)) - 1) // Se calculan los baudios por segundo
 
 #include <avr/io.h> // Libreria de entrada y salida de AVR
-#include <util/delay.h> // Libreria de retardos
+#include <avr/interrupt.h> // Libreria de interrupciones
 #include <stdint.h> // Libreria de tipos de datos estandarizados
 #include <avr/pgmspace.h> // Libreria para manejo de memoria en programa
 
@@ -34,294 +34,366 @@ void UART_TX_CADENA(const char *str){
 	}
 }
 
-// Funciones para controlar el plotter
-void PLOTTER_SUBIR(void){ // Se levanta la solenoide
-	PORTD = 0b00001000; // Se pone en alto el pin PD3
-	_delay_ms(250); // Se espera 250 ms para asegurar que la solenoide se levante
+// Planificador de movimientos: las figuras no esperan con retardos sino que cargan cada paso (estado del puerto D y su
+// duracion en ms) en una cola circular que consume la interrupcion de comparacion del Timer1, que ocurre cada 1 ms.
+// Asi los tiempos no dependen del compilador ni del codigo que corre entre pasos, y mientras se dibuja el programa
+// sigue atendiendo la UART para pausar ('P'), continuar ('C') o cancelar ('X') la figura
+#define COLA_N 16 // Cantidad de pasos de la cola (potencia de 2)
+#define TIEMPO_SOLENOIDE 250 // Tiempo en ms que se espera para que la solenoide termine de moverse
+#define PINES_SOLENOIDE 0b00001100 // Pines PD2 y PD3 de la solenoide (se mantienen durante una pausa)
+#define ESTADO_SUBIR 0b00001000 // Estado del puerto D con la solenoide levantada y los motores detenidos
+
+typedef struct {
+	uint8_t estado; // Valor del puerto D durante el paso
+	uint16_t ms; // Duracion del paso en ms
+} Paso;
+
+Paso cola[COLA_N]; // Cola circular de pasos
+volatile uint8_t cola_lectura = 0; // Proximo paso a ejecutar (lo avanza la interrupcion)
+volatile uint8_t cola_escritura = 0; // Proximo lugar libre (lo avanza el programa)
+volatile uint16_t restante = 0; // Tiempo en ms que falta del paso en curso
+volatile uint8_t estado_actual = 0; // Estado del puerto D del paso en curso
+volatile uint8_t pausa = 0; // Vale 1 mientras la figura esta en pausa
+uint8_t cancelado = 0; // Vale 1 desde que se cancela la figura hasta que se elige otra
+
+// Funcion para inicializar el Timer1 en modo CTC con una interrupcion cada 1 ms
+void TIMER1_INICIAR(void){
+	TCCR1A = 0; // Se limpia el registro TCCR1A
+	TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10); // Modo CTC con prescaler 64 (250 kHz)
+	OCR1A = 249; // 250 cuentas = 1 ms
+	TIMSK1 = (1 << OCIE1A); // Se habilita la interrupcion de comparacion A
+	sei(); // Se habilitan las interrupciones globales
+}
+
+// Interrupcion del Timer1: descuenta 1 ms del paso en curso y, al terminar, pone en el puerto D el estado del siguiente.
+// Si la cola esta vacia se mantiene el ultimo estado, igual que al terminar una figura con retardos
+ISR(TIMER1_COMPA_vect){
+	if (pausa) return; // En pausa no corre el tiempo
+	if (restante && --restante) return; // El paso en curso todavia no termino
+	if (cola_lectura == cola_escritura) return; // No hay pasos pendientes
+	estado_actual = cola[cola_lectura].estado; // Se toma el proximo paso
+	restante = cola[cola_lectura].ms; // Su duracion
+	PORTD = estado_actual; // Se aplica el estado en el mismo tick en que termino el anterior
+	cola_lectura = (cola_lectura + 1) & (COLA_N - 1); // Se libera el lugar en la cola
+}
+
+// Funcion que atiende un caracter recibido por UART sin bloquearse (pausa, continua o cancela la figura en curso)
+void ATENDER_UART(void){
+	if (!(UCSR0A & (1 << RXC0))) return; // No hay datos recibidos
+	switch (UDR0){ // Se evalua el caracter recibido
+		case 'P': // Pausa: se detienen los motores y la solenoide queda como esta
+			if (pausa) break; // Ya estaba en pausa
+			cli(); // La interrupcion no debe cambiar el puerto mientras tanto
+			pausa = 1; // Se detiene el descuento del tiempo
+			PORTD = estado_actual & PINES_SOLENOIDE; // Motores detenidos
+			sei(); // Se habilitan las interrupciones
+			UART_TX_CADENA("\r\nPausa (C = continuar, X = cancelar)\r\n"); // Se informa la pausa
+			break;
+		case 'C': // Continua: se retoma el paso en curso con el tiempo que le faltaba
+			if (!pausa) break; // No estaba en pausa
+			cli(); // La interrupcion no debe cambiar el puerto mientras tanto
+			PORTD = estado_actual; // Se restituye el estado
+			pausa = 0; // Vuelve a correr el tiempo
+			sei(); // Se habilitan las interrupciones
+			UART_TX_CADENA("\r\nContinua\r\n"); // Se informa que continua
+			break;
+		case 'X': // Cancela: se descartan los pasos y se levanta la solenoide
+			cli(); // La interrupcion no debe tomar pasos mientras tanto
+			cola_lectura = cola_escritura; // Cola vacia
+			restante = 0; // Sin paso en curso
+			estado_actual = ESTADO_SUBIR; // Estado que queda al terminar
+			PORTD = ESTADO_SUBIR; // Motores detenidos y solenoide levantada
+			pausa = 0; // Se sale de una pausa
+			sei(); // Se habilitan las interrupciones
+			cancelado = 1; // La figura deja de cargar pasos
+			UART_TX_CADENA("\r\nFigura cancelada\r\n"); // Se informa la cancelacion
+			break;
+		default: break; // Otros caracteres se ignoran mientras se dibuja
+	}
+}
+
+// Funcion que agrega un paso a la cola. Si la cola esta llena espera atendiendo la UART; los pasos de mas de 65535 ms se
+// parten en varios. Despues de una cancelacion no agrega nada
+void PROGRAMAR(uint8_t estado, uint32_t ms){
+	while (ms && !cancelado){ // Mientras quede tiempo por programar
+		uint16_t parte = (ms > 0xFFFF) ? 0xFFFF : (uint16_t)ms; // Duracion de este paso
+		while (((cola_escritura + 1) & (COLA_N - 1)) == cola_lectura){ // Se espera un lugar libre
+			ATENDER_UART(); // Mientras tanto se atiende la UART
+			if (cancelado) return; // Se cancelo la figura mientras se esperaba
+		}
+		cola[cola_escritura].estado = estado; // Se completa el paso
+		cola[cola_escritura].ms = parte; // y su duracion
+		cola_escritura = (cola_escritura + 1) & (COLA_N - 1); // Se publica el paso
+		ms -= parte; // Tiempo que queda por programar
+	}
 }
-void PLOTTER_BAJAR(void){ // Se baja la solenoide
-	PORTD = 0b00000100; // Se pone en alto el pin PD2
-	_delay_ms(250); // Se espera 250 ms para asegurar que la solenoide se baje
+
+// Funcion que espera a que se ejecuten todos los pasos de la cola atendiendo la UART
+void ESPERAR_FIN(void){
+	for (;;){ // Hasta que termine el ultimo paso
+		uint8_t sreg = SREG; // Se guarda el estado de las interrupciones
+		cli(); // restante es de 16 bits: la interrupcion no debe cambiarlo entre la lectura de sus dos bytes
+		uint8_t ocupado = restante || cola_lectura != cola_escritura; // Queda un paso en curso o en la cola
+		SREG = sreg; // Se restaura el estado de las interrupciones
+		if (!ocupado) break; // Se terminaron los pasos
+		ATENDER_UART(); // Mientras tanto se atiende la UART
+	}
 }
-void PLOTTER_ARRIBA_NO_BAJAR(void){ // Se mueve el plotter hacia arriba sin bajar la solenoide
-	PORTD = 0b00100000; // Se pone en alto el pin PD5
+
+// Funciones para controlar el plotter: cada una programa un estado del puerto D durante ms milisegundos
+void PLOTTER_SUBIR(uint32_t ms){ // Se levanta la solenoide
+	PROGRAMAR(0b00001000, TIEMPO_SOLENOIDE + ms); // Se pone en alto el pin PD3 y se espera a que la solenoide se levante
 }
-void PLOTTER_ABAJO_NO_BAJAR(void){ // Se mueve el plotter hacia abajo sin bajar la solenoide
-	PORTD = 0b00010000; // Se pone en alto el pin PD4
+void PLOTTER_BAJAR(uint32_t ms){ // Se baja la solenoide
+	PROGRAMAR(0b00000100, TIEMPO_SOLENOIDE + ms); // Se pone en alto el pin PD2 y se espera a que la solenoide se baje
 }
-void PLOTTER_DERECHA_NO_BAJAR(void){ // Se mueve el plotter hacia la derecha sin bajar la solenoide
-	PORTD = 0b01000000; // Se pone en alto el pin PD6
+void PLOTTER_ARRIBA_NO_BAJAR(uint32_t ms){ // Se mueve el plotter hacia arriba sin bajar la solenoide
+	PROGRAMAR(0b00100000, ms); // Se pone en alto el pin PD5
 }
-void PLOTTER_IZQUIERDA_NO_BAJAR(void){ // Se mueve el plotter hacia la izquierda sin bajar la solenoide
-	PORTD = 0b10000000; // Se pone en alto el pin PD7
+void PLOTTER_ABAJO_NO_BAJAR(uint32_t ms){ // Se mueve el plotter hacia abajo sin bajar la solenoide
+	PROGRAMAR(0b00010000, ms); // Se pone en alto el pin PD4
 }
-void PLOTTER_ARRIBA(void){ // Se mueve el plotter hacia arriba
-	PORTD = 0b00100100; // Se ponen en alto los pines PD2 y PD5
+void PLOTTER_DERECHA_NO_BAJAR(uint32_t ms){ // Se mueve el plotter hacia la derecha sin bajar la solenoide
+	PROGRAMAR(0b01000000, ms); // Se pone en alto el pin PD6
 }
-void PLOTTER_ABAJO(void){ // Se mueve el plotter hacia abajo
-	PORTD = 0b00010100; // Se ponen en alto los pines PD2 y PD4
+void PLOTTER_IZQUIERDA_NO_BAJAR(uint32_t ms){ // Se mueve el plotter hacia la izquierda sin bajar la solenoide
+	PROGRAMAR(0b10000000, ms); // Se pone en alto el pin PD7
 }
-void PLOTTER_DERECHA(void){ // Se mueve el plotter hacia la derecha
-	PORTD = 0b01000100; // Se ponen en alto los pines PD4 y PD6
+void PLOTTER_ARRIBA(uint32_t ms){ // Se mueve el plotter hacia arriba
+	PROGRAMAR(0b00100100, ms); // Se ponen en alto los pines PD2 y PD5
 }
-void PLOTTER_IZQUIERDA(void){ // Se mueve el plotter hacia la izquierda
-	PORTD = 0b10000100; // Se ponen en alto los pines PD4 y PD7
+void PLOTTER_ABAJO(uint32_t ms){ // Se mueve el plotter hacia abajo
+	PROGRAMAR(0b00010100, ms); // Se ponen en alto los pines PD2 y PD4
 }
-void PLOTTER_ARRIBA_DERECHA(void){ // Se mueve el plotter hacia arriba y a la derecha para formar una diagonal
-	PORTD = 0b01100100; // Se ponen en alto los pines PD2, PD5 y PD6
+void PLOTTER_DERECHA(uint32_t ms){ // Se mueve el plotter hacia la derecha
+	PROGRAMAR(0b01000100, ms); // Se ponen en alto los pines PD4 y PD6
 }
-void PLOTTER_ABAJO_DERECHA(void){ // Se mueve el plotter hacia abajo y a la derecha para formar una diagonal
-	PORTD = 0b01010100; // Se ponen en alto los pines PD4 y PD6
+void PLOTTER_IZQUIERDA(uint32_t ms){ // Se mueve el plotter hacia la izquierda
+	PROGRAMAR(0b10000100, ms); // Se ponen en alto los pines PD4 y PD7
 }
-void PLOTTER_ABAJO_IZQUIERDA(void){ // Se mueve el plotter hacia abajo y a la izquierda para formar una diagonal
-	PORTD = 0b10010100; // Se ponen en alto los pines PD4 y PD7
+void PLOTTER_ARRIBA_DERECHA(uint32_t ms){ // Se mueve el plotter hacia arriba y a la derecha para formar una diagonal
+	PROGRAMAR(0b01100100, ms); // Se ponen en alto los pines PD2, PD5 y PD6
 }
-void PLOTTER_ARRIBA_IZQUIERDA(void){ // Se mueve el plotter hacia arriba y a la izquierda para formar una diagonal
-	PORTD = 0b10100100; // Se ponen en alto los pines PD2, PD5 y PD7
+void PLOTTER_ABAJO_DERECHA(uint32_t ms){ // Se mueve el plotter hacia abajo y a la derecha para formar una diagonal
+	PROGRAMAR(0b01010100, ms); // Se ponen en alto los pines PD4 y PD6
+}
+void PLOTTER_ABAJO_IZQUIERDA(uint32_t ms){ // Se mueve el plotter hacia abajo y a la izquierda para formar una diagonal
+	PROGRAMAR(0b10010100, ms); // Se ponen en alto los pines PD4 y PD7
+}
+void PLOTTER_ARRIBA_IZQUIERDA(uint32_t ms){ // Se mueve el plotter hacia arriba y a la izquierda para formar una diagonal
+	PROGRAMAR(0b10100100, ms); // Se ponen en alto los pines PD2, PD5 y PD7
 }
 
-// Estructura para definir un paso en una figura
-typedef struct {
-	char dir; // Direccion del movimiento
-	uint16_t t; // Tiempo en milisegundos para el movimiento
-} Paso;
+// Formato empaquetado de las figuras (lo genera CONVERTIR_FIGURA.py a partir de los pasos 'D', 'I', 'U', 'A', 'B', 'S', 'd', 'i', 'u', 'a'):
+// un numero variable con la unidad de tiempo de los movimientos en ms y luego un byte por movimiento con la direccion
+// en los bits 7-6 (D, I, U, A), la pluma en el bit 5 (1 = mayuscula) y la cuenta de unidades en los bits 4-0. La cuenta
+// 31 continua como numero variable y la cuenta 0 indica un comando: 'B' (0x00) o 'S' (0x40) seguidos de su tiempo en
+// ms, o el fin de la figura (0xC0). Los numeros variables van de a 7 bits con el bit 7 en 1 si sigue otro byte
+#define FIGURA_SUBIR 0x40 // Byte del comando 'S' (el de 'B' es 0x00)
+#define FIGURA_FIN 0xC0 // Byte que termina una figura
 
-// Funcion para ejecutar una figura dada una secuencia de pasos
-void EJECUTAR_FIGURA(const Paso *figura, uint16_t n_pasos){
-	// Se recorren todos los pasos de la figura
-	for (uint16_t i = 0; i < n_pasos; i++){
-		char dir = pgm_read_byte(&figura[i].dir); // Se lee la direccion del paso desde la memoria de programa
-		uint16_t tiempo = pgm_read_word(&figura[i].t); // Se lee el tiempo del paso desde la memoria de programa
+// Funcion para leer un numero de longitud variable desde la memoria de programa avanzando el puntero
+uint16_t LEER_VARIABLE(const uint8_t **p){
+	uint16_t valor = 0; // Valor leido
+	uint8_t desplazamiento = 0; // Posicion de los proximos 7 bits
+	uint8_t byte; // Byte actual
+	do { // Se leen grupos de 7 bits
+		byte = pgm_read_byte((*p)++); // Se lee el byte y se avanza
+		valor |= (uint16_t)(byte & 0x7F) << desplazamiento; // Se agregan sus 7 bits
+		desplazamiento += 7; // Los siguientes van mas arriba
+	} while (byte & 0x80); // Mientras el bit 7 indique que sigue otro byte
+	return valor; // Se devuelve el numero leido
+}
 
-		// Se ejecuta el movimiento correspondiente segun la direccion
-		switch(dir){
-			case 'D': PLOTTER_DERECHA(); break; // Se mueve el plotter hacia la derecha
-			case 'I': PLOTTER_IZQUIERDA(); break; // Se mueve el plotter hacia la izquierda
-			case 'A': PLOTTER_ABAJO(); break; // Se mueve el plotter hacia abajo
-			case 'U': PLOTTER_ARRIBA(); break; // Se mueve el plotter hacia arriba
-			case 'B': PLOTTER_BAJAR(); break; // Se baja la solenoide
-			case 'S': PLOTTER_SUBIR(); break; // Se levanta la solenoide
-			case 'd': PLOTTER_DERECHA_NO_BAJAR(); break; // Se mueve el plotter hacia la derecha sin bajar la solenoide
-			case 'i': PLOTTER_IZQUIERDA_NO_BAJAR(); break; // Se mueve el plotter hacia la izquierda sin bajar la solenoide
-			case 'a': PLOTTER_ABAJO_NO_BAJAR(); break; // Se mueve el plotter hacia abajo sin bajar la solenoide
-			case 'u': PLOTTER_ARRIBA_NO_BAJAR(); break; // Se mueve el plotter hacia arriba sin bajar la solenoide
-			default: break; // Si la direccion no es valida, no se hace nada
+// Funcion para cargar una figura empaquetada en la cola de pasos leyendo la memoria de programa en orden hasta el fin
+// de la figura (o hasta que se cancele)
+void EJECUTAR_FIGURA(const uint8_t *figura){
+	uint16_t unidad = LEER_VARIABLE(&figura); // Se lee la unidad de tiempo de los movimientos
+
+	while (!cancelado){ // Hasta el fin de la figura o hasta que se cancele
+		uint8_t byte = pgm_read_byte(figura++); // Se lee el proximo byte de la figura
+		uint16_t cuenta = byte & 0x1F; // Cuenta de unidades del movimiento (0 en los comandos)
+		uint32_t tiempo; // Tiempo del paso en ms
+		char dir; // Direccion del paso con las mismas letras que el formato de pasos
+		if (cuenta == 0){ // Comando
+			if (byte == FIGURA_FIN) break; // Se termino la figura
+			dir = (byte == FIGURA_SUBIR) ? 'S' : 'B'; // Comando del solenoide
+			tiempo = LEER_VARIABLE(&figura); // Tiempo del comando en ms
+		} else { // Movimiento
+			if (cuenta == 31) cuenta += LEER_VARIABLE(&figura); // Cuenta larga
+			dir = "diuaDIUA"[(byte >> 6) | ((byte & 0x20) >> 3)]; // Letra segun la direccion y la pluma
+			tiempo = (uint32_t)cuenta * unidad; // Tiempo del movimiento en ms
 		}
-		
-		// Se espera el tiempo especificado para el movimiento
-		for (uint16_t j = 0; j < tiempo; j++){
-			_delay_ms(1); // Retardo de 1 ms
+
+		// Se programa el movimiento correspondiente segun la direccion durante el tiempo especificado
+		switch(dir){ // Segun la direccion
+			case 'D': PLOTTER_DERECHA(tiempo); break; // Se mueve el plotter hacia la derecha
+			case 'I': PLOTTER_IZQUIERDA(tiempo); break; // Se mueve el plotter hacia la izquierda
+			case 'A': PLOTTER_ABAJO(tiempo); break; // Se mueve el plotter hacia abajo
+			case 'U': PLOTTER_ARRIBA(tiempo); break; // Se mueve el plotter hacia arriba
+			case 'B': PLOTTER_BAJAR(tiempo); break; // Se baja la solenoide
+			case 'S': PLOTTER_SUBIR(tiempo); break; // Se levanta la solenoide
+			case 'd': PLOTTER_DERECHA_NO_BAJAR(tiempo); break; // Se mueve el plotter hacia la derecha sin bajar la solenoide
+			case 'i': PLOTTER_IZQUIERDA_NO_BAJAR(tiempo); break; // Se mueve el plotter hacia la izquierda sin bajar la solenoide
+			case 'a': PLOTTER_ABAJO_NO_BAJAR(tiempo); break; // Se mueve el plotter hacia abajo sin bajar la solenoide
+			case 'u': PLOTTER_ARRIBA_NO_BAJAR(tiempo); break; // Se mueve el plotter hacia arriba sin bajar la solenoide
+			default: break; // Si la direccion no es valida, no se hace nada
 		}
 	}
 }
 
 // Funcion para dibujar un triangulo
 void TRIANGULO(void){
-	PLOTTER_BAJAR(); _delay_ms(250); // Se baja la solenoide durante 250 ms
-	PLOTTER_IZQUIERDA(); _delay_ms(6000); // Se mueve a la izquierda durante 6000 ms
-	PLOTTER_ABAJO_DERECHA(); _delay_ms(3000); // Se mueve hacia abajo y a la derecha durante 3000 ms
-	PLOTTER_ARRIBA_DERECHA(); _delay_ms(3000); // Se mueve hacia arriba y a la derecha durante 3000 ms
-	PLOTTER_SUBIR(); _delay_ms(250); // Se levanta la solenoide durante 250 ms
+	PLOTTER_BAJAR(250); // Se baja la solenoide durante 250 ms
+	PLOTTER_IZQUIERDA(6000); // Se mueve a la izquierda durante 6000 ms
+	PLOTTER_ABAJO_DERECHA(3000); // Se mueve hacia abajo y a la derecha durante 3000 ms
+	PLOTTER_ARRIBA_DERECHA(3000); // Se mueve hacia arriba y a la derecha durante 3000 ms
+	PLOTTER_SUBIR(250); // Se levanta la solenoide durante 250 ms
 }
 
-// Definicion de la figura circulo a través de una estructura de pasos
-const Paso CIRCULO[] PROGMEM = {
-	{'B', 250}, {'D', 600}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 500}, {'A', 600},
-	{'I', 100}, {'A', 400}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 300}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 300}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 500}, {'I', 600}, {'U', 100}, {'I', 400},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 300}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 200}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 300}, {'I', 100},
-	{'U', 200}, {'I', 100}, {'U', 300}, {'I', 100}, {'U', 500}, {'U', 600}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 200},
-	{'D', 100}, {'U', 300}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 200},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 300}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 400}, {'U', 100}, {'D', 600}, {'S', 250}
+// Definicion de la figura circulo en formato empaquetado (generada con CONVERTIR_FIGURA.py)
+const uint8_t CIRCULO[] PROGMEM = {
+	0x64, 0x00, 0xFA, 0x01, 0x26, 0xE1, 0x24, 0xE1, 0x22, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x22, 0xE1,
+	0x21, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2, 0x21, 0xE1, 0x21, 0xE2,
+	0x21, 0xE1, 0x21, 0xE3, 0x21, 0xE2, 0x21, 0xE4, 0x21, 0xEB, 0x61, 0xE4, 0x61, 0xE2, 0x61, 0xE3,
+	0x61, 0xE1, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1,
+	0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x63, 0xE1, 0x62, 0xE1, 0x64, 0xE1, 0x6B, 0xA1,
+	0x64, 0xA1, 0x62, 0xA1, 0x63, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x61, 0xA1, 0x61, 0xA2, 0x61, 0xA1, 0x61, 0xA3, 0x61, 0xA2,
+	0x61, 0xA3, 0x61, 0xAB, 0x21, 0xA4, 0x21, 0xA2, 0x21, 0xA3, 0x21, 0xA1, 0x21, 0xA2, 0x21, 0xA1,
+	0x21, 0xA2, 0x21, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x21, 0xA1, 0x23, 0xA1, 0x22, 0xA1, 0x24, 0xA1, 0x26, 0x40, 0xFA, 0x01, 0xC0
 };
 
 // Funcion para dibujar una cruz
 void CRUZ(void){
-	PLOTTER_IZQUIERDA_NO_BAJAR(); _delay_ms(2500); // Se mueve el plotter hacia la izquierda sin bajar la solenoide durante 2500 ms
-	PLOTTER_ABAJO(); _delay_ms(5000); // Se mueve el plotter hacia abajo durante 5000 ms
-	PLOTTER_SUBIR(); _delay_ms(250); // Se levanta la solenoide durante 250 ms
-	PLOTTER_ARRIBA_NO_BAJAR(); _delay_ms(2500); // Se mueve el plotter hacia arriba sin bajar la solenoide durante 2500 ms
-	PLOTTER_DERECHA_NO_BAJAR(); _delay_ms(2500); // Se mueve el plotter hacia la derecha sin bajar la solenoide durante 2500 ms
-	PLOTTER_IZQUIERDA(); _delay_ms(5000); // Se mueve el plotter hacia la izquierda durante 5000 ms
-	PLOTTER_SUBIR(); _delay_ms(250); // Se levanta la solenoide durante 250 ms
+	PLOTTER_IZQUIERDA_NO_BAJAR(2500); // Se mueve el plotter hacia la izquierda sin bajar la solenoide durante 2500 ms
+	PLOTTER_ABAJO(5000); // Se mueve el plotter hacia abajo durante 5000 ms
+	PLOTTER_SUBIR(250); // Se levanta la solenoide durante 250 ms
+	PLOTTER_ARRIBA_NO_BAJAR(2500); // Se mueve el plotter hacia arriba sin bajar la solenoide durante 2500 ms
+	PLOTTER_DERECHA_NO_BAJAR(2500); // Se mueve el plotter hacia la derecha sin bajar la solenoide durante 2500 ms
+	PLOTTER_IZQUIERDA(5000); // Se mueve el plotter hacia la izquierda durante 5000 ms
+	PLOTTER_SUBIR(250); // Se levanta la solenoide durante 250 ms
 }
 
 // Funcion para dibujar las figuras en secuencia
 void FIGURAS(void){
 	TRIANGULO(); // Dibuja un triángulo
-	PLOTTER_IZQUIERDA_NO_BAJAR(); _delay_ms(10000); // Se mueve el plotter hacia la izquierda sin bajar la solenoide durante 10000 ms
-	EJECUTAR_FIGURA(CIRCULO, sizeof(CIRCULO) / sizeof(Paso)); // Dibuja un círculo
-	PLOTTER_IZQUIERDA_NO_BAJAR(); _delay_ms(5000); // Se mueve el plotter hacia la izquierda sin bajar la solenoide durante 5000 ms
+	PLOTTER_IZQUIERDA_NO_BAJAR(10000); // Se mueve el plotter hacia la izquierda sin bajar la solenoide durante 10000 ms
+	EJECUTAR_FIGURA(CIRCULO); // Dibuja un círculo
+	PLOTTER_IZQUIERDA_NO_BAJAR(5000); // Se mueve el plotter hacia la izquierda sin bajar la solenoide durante 5000 ms
 	CRUZ(); // Dibuja una cruz
 }
 
-// Definicion de la figura zorro a través de una estructura de pasos
-const Paso ZORRO[] PROGMEM = {
-	{'i', 10000}, {'a', 3000}, {'D', 3900}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'A', 300}, {'I', 100}, {'A', 600}, {'I', 100}, {'A', 500}, {'I', 100}, {'A', 600},
-	{'I', 100}, {'A', 500}, {'I', 100}, {'A', 600}, {'I', 100}, {'A', 500}, {'I', 100}, {'A', 600}, {'I', 100}, {'A', 300},
-	{'D', 100}, {'A', 100}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300},
-	{'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300},
-	{'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 100}, {'U', 100}, {'I', 300},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 200}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100},
-	{'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100},
-	{'U', 300}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 300}, {'I', 100}, {'U', 600}, {'I', 100},
-	{'U', 500}, {'I', 100}, {'U', 600}, {'I', 100}, {'U', 500}, {'I', 100}, {'U', 600}, {'I', 100}, {'U', 500}, {'I', 100},
-	{'U', 600}, {'I', 100}, {'U', 300}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 300}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200}, {'I', 200},
-	{'A', 100}, {'I', 400}, {'A', 100}, {'I', 300}, {'A', 100}, {'I', 500}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 400},
-	{'A', 100}, {'I', 400}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 500}, {'S', 250}, {'d', 500},
-	{'u', 100}, {'d', 400}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 400},
-	{'u', 100}, {'d', 500}, {'u', 100}, {'d', 300}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 200}, {'B', 250}, {'D', 200},
-	{'A', 300}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100},
-	{'A', 300}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 300}, {'D', 100},
-	{'A', 200}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'U', 200}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 400}, {'D', 100},
-	{'U', 400}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 400}, {'D', 100},
-	{'U', 400}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 300}, {'D', 300}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400},
-	{'A', 100}, {'D', 400}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400},
-	{'A', 100}, {'D', 400}, {'A', 100}, {'D', 600}, {'S', 250}, {'i', 600}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400},
-	{'u', 100}, {'i', 400}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400},
-	{'u', 100}, {'i', 400}, {'u', 100}, {'i', 100}, {'B', 250}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 300}, {'I', 300}, {'U', 100},
-	{'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100},
-	{'I', 200}, {'A', 300}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 200}, {'U', 200}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 400}, {'S', 250}, {'d', 1800}, {'a', 3400}, {'A', 4300}, {'S', 250}, {'u', 4300}, {'B', 250}, {'D', 200},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'S', 250}, {'a', 300}, {'i', 100}, {'a', 400}, {'i', 100}, {'a', 300}, {'B', 250}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'S', 250}, {'i', 6300}, {'B', 250}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100},
-	{'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'S', 250},
-	{'u', 1000}, {'i', 200}, {'B', 250}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'S', 250}
+// Definicion de la figura zorro en formato empaquetado (generada con CONVERTIR_FIGURA.py)
+const uint8_t ZORRO[] PROGMEM = {
+	0x64, 0x53, 0xDF, 0x37, 0x00, 0xFA, 0x01, 0x66, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64,
+	0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x63, 0xE3, 0x61, 0xE4, 0x61, 0xE4, 0x61,
+	0xE4, 0x61, 0xE4, 0x61, 0xE3, 0x61, 0xE4, 0x61, 0xE4, 0x61, 0xE4, 0x61, 0xE3, 0x61, 0xE2, 0x62,
+	0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x61, 0xA1, 0x61, 0xA1, 0x62,
+	0xE1, 0x61, 0xE1, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62,
+	0xA2, 0x61, 0xA3, 0x61, 0xA4, 0x61, 0xA4, 0x61, 0xA4, 0x61, 0xA3, 0x61, 0xA4, 0x61, 0xA4, 0x61,
+	0xA4, 0x61, 0xA4, 0x61, 0xA3, 0x62, 0x40, 0xFA, 0x01, 0x01, 0x82, 0x00, 0xFA, 0x01, 0xA1, 0x22,
+	0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22,
+	0xA1, 0x22, 0xA1, 0x22, 0x40, 0xFA, 0x01, 0x52, 0xD5, 0x00, 0xFA, 0x01, 0x62, 0xA1, 0x62, 0xA1,
+	0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x40, 0xFA, 0x01, 0x5D, 0xC8, 0x25,
+	0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x25, 0xA1, 0x23, 0xA1, 0x24,
+	0xA1, 0x22, 0xA2, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61,
+	0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61,
+	0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61,
+	0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA3, 0x23, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22,
+	0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22,
+	0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA2, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61,
+	0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x61,
+	0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61,
+	0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xE3, 0x21, 0xE6, 0x21, 0xE5, 0x21,
+	0xE6, 0x21, 0xE5, 0x21, 0xE6, 0x21, 0xE5, 0x21, 0xE6, 0x21, 0xE3, 0x61, 0xE1, 0x61, 0xE4, 0x61,
+	0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61,
+	0xE3, 0x61, 0xE3, 0x61, 0xE2, 0x21, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22,
+	0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x23, 0xE1, 0xA1, 0x23, 0xA1,
+	0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1,
+	0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1,
+	0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x22, 0xA1, 0x21, 0xA1, 0x21, 0xA2, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3,
+	0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA4, 0x61, 0xA1, 0x61, 0xA3,
+	0x21, 0xA6, 0x21, 0xA5, 0x21, 0xA6, 0x21, 0xA5, 0x21, 0xA6, 0x21, 0xA5, 0x21, 0xA6, 0x21, 0xA3,
+	0x62, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1,
+	0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1,
+	0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1,
+	0x62, 0xE1, 0x7F, 0x08, 0x40, 0xFA, 0x01, 0x02, 0x00, 0xFA, 0x01, 0xE4, 0x21, 0xE2, 0x21, 0xE2,
+	0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE1, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2,
+	0x21, 0xE2, 0x21, 0xE1, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x22, 0xA2,
+	0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA1, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2,
+	0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA1, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2,
+	0x21, 0xA3, 0x22, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1,
+	0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1,
+	0x22, 0xE1, 0x23, 0xE3, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1,
+	0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1,
+	0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1,
+	0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE2, 0x40, 0xFA, 0x01, 0x09, 0xC1, 0x00, 0xFA, 0x01,
+	0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x62, 0x40, 0xFA,
+	0x01, 0x02, 0x8A, 0x00, 0xFA, 0x01, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62,
+	0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x62, 0x40, 0xFA, 0x01, 0xFF,
+	0x0C, 0x40, 0xFA, 0x01, 0x41, 0x9F, 0x0C, 0xC0
 };
 
-// Definicion de la figura flor a través de una estructura de pasos
-const Paso FLOR[] PROGMEM = {
-	{'i', 10000}, {'B', 250}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200},
-	{'D', 100}, {'A', 100}, {'D', 500}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 400}, {'A', 400}, {'D', 100}, {'A', 700}, {'D', 200}, {'U', 100}, {'D', 300}, {'U', 100}, {'D', 700}, {'A', 600},
-	{'I', 200}, {'A', 400}, {'D', 800}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 200}, {'I', 100}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 200},
-	{'D', 500}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 500}, {'A', 200},
-	{'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 900}, {'A', 200}, {'D', 100}, {'A', 200},
-	{'D', 100}, {'A', 100}, {'D', 100}, {'A', 500}, {'I', 700}, {'U', 100}, {'I', 300}, {'U', 100}, {'I', 200}, {'A', 700},
-	{'I', 100}, {'A', 400}, {'I', 500}, {'U', 100}, {'I', 400}, {'U', 100}, {'I', 100}, {'U', 200}, {'I', 500}, {'A', 100},
-	{'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 200}, {'A', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 200},
-	{'I', 100}, {'U', 200}, {'I', 100}, {'U', 100}, {'I', 500}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 400}, {'A', 100},
-	{'I', 400}, {'U', 400}, {'I', 100}, {'U', 700}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 100}, {'I', 700}, {'U', 500},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'I', 900}, {'U', 100}, {'I', 200}, {'U', 100},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'U', 200}, {'I', 500}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 300}, {'U', 100}, {'D', 500}, {'U', 200}, {'I', 300}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 300}, {'U', 100},
-	{'D', 800}, {'U', 400}, {'I', 200}, {'U', 600}, {'D', 700}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 200}, {'U', 700},
-	{'D', 100}, {'U', 400}, {'D', 400}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100},
-	{'D', 500}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'S', 250}, {'a', 1700}, {'B', 250}, {'D', 500}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 800}, {'I', 100},
-	{'A', 300}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200},
-	{'A', 100}, {'I', 300}, {'A', 100}, {'I', 900}, {'U', 100}, {'I', 300}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 300}, {'I', 100}, {'U', 800}, {'D', 100},
-	{'U', 300}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200},
-	{'U', 100}, {'D', 300}, {'U', 100}, {'D', 400}, {'S', 250}, {'a', 5600}, {'i', 200}, {'B', 250}, {'A', 5400}, {'D', 500},
-	{'U', 5400}, {'S', 250}, {'a', 1100}, {'B', 250}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 200}, {'U', 200},
-	{'D', 200}, {'U', 100}, {'D', 500}, {'U', 200}, {'D', 700}, {'U', 100}, {'D', 1300}, {'A', 100}, {'D', 500}, {'A', 100},
-	{'D', 100}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 400},
-	{'I', 400}, {'U', 100}, {'I', 600}, {'A', 100}, {'I', 700}, {'A', 100}, {'I', 300}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 300}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 600}, {'U', 100},
-	{'I', 300}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 300}, {'D', 300},
-	{'U', 100}, {'D', 500}, {'U', 100}, {'D', 500}, {'U', 100}, {'D', 500}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 300},
-	{'U', 100}, {'D', 1500}, {'S', 250}, {'i', 7900}, {'B', 250}, {'D', 1500}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 500}, {'A', 100}, {'D', 500}, {'A', 100}, {'D', 500}, {'A', 100}, {'D', 300}, {'U', 300}, {'I', 300},
-	{'U', 100}, {'I', 100}, {'U', 200}, {'I', 200}, {'U', 200}, {'I', 200}, {'U', 100}, {'I', 500}, {'U', 200}, {'I', 700},
-	{'U', 100}, {'I', 1300}, {'A', 100}, {'I', 500}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 300},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 400}, {'D', 400}, {'U', 100}, {'D', 600}, {'A', 100}, {'D', 700},
-	{'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 400},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 600}, {'U', 100}, {'D', 300}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 200}, {'U', 100}, {'S', 250}, {'u', 1900}, {'B', 250}, {'U', 300}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 800}, {'I', 400}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 200}, {'S', 250}, {'U', 1600}, {'B', 250}, {'I', 300}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'S', 250}, {'i', 500}, {'u', 900},
-	{'B', 250}, {'D', 1400}, {'S', 250}, {'d', 3900}, {'B', 250}, {'D', 1400}, {'S', 250}, {'u', 1300}, {'B', 250}, {'I', 1400},
-	{'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200},
-	{'U', 200}, {'D', 100}, {'U', 300}, {'D', 100}, {'S', 250}, {'i', 5800}, {'B', 250}, {'A', 300}, {'D', 100}, {'A', 200},
-	{'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 300}, {'A', 100},
-	{'i', 1300}, {'S', 250}, {'u', 1700}, {'d', 1300}, {'B', 250}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'U', 900}, {'D', 100},
-	{'U', 100}, {'D', 100}, {'U', 300}, {'S', 250}, {'d', 1100}, {'B', 250}, {'A', 300}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 900}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'S', 250}, {'a', 3200}, {'B', 250}, {'D', 300}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 200}, {'S', 250},
-	{'a', 800}, {'i', 800}, {'B', 250}, {'I', 300}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 400}, {'A', 800}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 300}, {'S', 250}
+// Definicion de la figura flor en formato empaquetado (generada con CONVERTIR_FIGURA.py)
+const uint8_t FLOR[] PROGMEM = {
+	0x64, 0x5F, 0x28, 0xD6, 0x00, 0xFA, 0x01, 0x61, 0xE3, 0x61, 0xE2, 0x62, 0xE1, 0x61, 0xE1, 0x62,
+	0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x2E, 0x40, 0xFA, 0x01, 0xCD, 0x00, 0xFA, 0x01, 0x6E, 0x40, 0xFA,
+	0x01, 0x01, 0xC2, 0x00, 0xFA, 0x01, 0x23, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2,
+	0x21, 0xE2, 0x40, 0xFA, 0x01, 0x48, 0xC8, 0x00, 0xFA, 0x01, 0x63, 0xA1, 0x61, 0xA1, 0x62, 0xA1,
+	0x61, 0xA1, 0x62, 0xA1, 0x64, 0xE8, 0x61, 0xE1, 0x61, 0xE3, 0x40, 0xFA, 0x01, 0x43, 0xC4, 0x00,
+	0xFA, 0x01, 0xFF, 0x17, 0x65, 0xBF, 0x17, 0x40, 0xFA, 0x01, 0x44, 0x85, 0x00, 0xFA, 0x01, 0xA3,
+	0x61, 0xA1, 0x61, 0xA8, 0x64, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0x40,
+	0xFA, 0x01, 0xB0, 0x00, 0xFA, 0x01, 0x63, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE2,
+	0x61, 0xE2, 0x40, 0xFA, 0x01, 0x09, 0x89, 0x00, 0xFA, 0x01, 0x6E, 0x40, 0xFA, 0x01, 0x02, 0x8D,
+	0x40, 0xFA, 0x01, 0x03, 0x8A, 0x00, 0xFA, 0x01, 0xE3, 0x21, 0xE2, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x21, 0xE1, 0x23, 0xE1, 0x91, 0x00, 0xFA, 0x01, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xA9, 0x21, 0xA1, 0x21, 0xA3, 0x40, 0xFA, 0x01, 0x05, 0x88,
+	0x00, 0xFA, 0x01, 0x22, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2, 0x21, 0xE1, 0x25, 0xA1, 0x21,
+	0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x24, 0xE4, 0x21, 0xE7, 0x22, 0xA1, 0x23, 0xA1, 0x27, 0xE6, 0x62,
+	0xE4, 0x28, 0xE1, 0x23, 0xE1, 0x21, 0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62,
+	0xE1, 0x63, 0xE2, 0x25, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2, 0x61, 0xE1, 0x61,
+	0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x65, 0xE2, 0x22, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x21,
+	0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x69, 0xE2, 0x21, 0xE2, 0x21, 0xE1, 0x21, 0xE5, 0x67,
+	0xA1, 0x63, 0xA1, 0x62, 0xE7, 0x61, 0xE4, 0x65, 0xA1, 0x64, 0xA1, 0x61, 0xA2, 0x65, 0xE1, 0x61,
+	0xE2, 0x61, 0xE2, 0x62, 0xE1, 0x61, 0xA1, 0x62, 0xA2, 0x61, 0xA2, 0x61, 0xA1, 0x65, 0xE2, 0x61,
+	0xE1, 0x64, 0xE1, 0x64, 0xA4, 0x61, 0xA7, 0x62, 0xE1, 0x63, 0xE1, 0x67, 0xA5, 0x21, 0xA1, 0x21,
+	0xA2, 0x21, 0xA1, 0x69, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x21, 0xA1, 0x21, 0xA1, 0x22,
+	0xA1, 0x22, 0xA1, 0x22, 0xA2, 0x65, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x21,
+	0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x23, 0xA1, 0x25, 0xA2, 0x63, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x61,
+	0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x21, 0xA1, 0x23, 0xA1, 0x28, 0xA4, 0x62, 0xA6, 0x27, 0xE1, 0x23,
+	0xE1, 0x22, 0xA7, 0x21, 0xA4, 0x24, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x25, 0xA1, 0x21,
+	0xA2, 0x21, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x40, 0xFA, 0x01, 0x06, 0xC7, 0x00, 0xFA, 0x01, 0xE3,
+	0x21, 0xE1, 0x21, 0xE9, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x22, 0x40, 0xFA, 0x01, 0x54, 0xC3, 0x00, 0xFA, 0x01, 0x25, 0xE1, 0x23, 0xE1, 0x22, 0xE1, 0x22,
+	0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2, 0x21, 0xE2, 0x21,
+	0xE3, 0x21, 0xE8, 0x61, 0xE3, 0x61, 0xE2, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61,
+	0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x63, 0xE1, 0x69, 0xA1, 0x63, 0xA1, 0x62,
+	0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x61,
+	0xA2, 0x61, 0xA3, 0x61, 0xA8, 0x21, 0xA3, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA1, 0x21, 0xA1, 0x21,
+	0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x23, 0xA1, 0x24, 0x40, 0xFA,
+	0x01, 0x5F, 0x08, 0xDF, 0x21, 0x00, 0xFA, 0x01, 0x2F, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x25, 0xE1,
+	0x25, 0xE1, 0x25, 0xE1, 0x23, 0xA3, 0x63, 0xA1, 0x61, 0xA2, 0x62, 0xA2, 0x62, 0xA1, 0x65, 0xA2,
+	0x67, 0xA1, 0x6D, 0xE1, 0x65, 0xE1, 0x61, 0xE1, 0x64, 0xE1, 0x63, 0xE1, 0x61, 0xE1, 0x61, 0xE4,
+	0x24, 0xA1, 0x26, 0xE1, 0x27, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x23, 0xE1, 0x22, 0xE1, 0x24, 0xE1,
+	0x21, 0xE1, 0x26, 0xA1, 0x23, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x40, 0xFA, 0x01, 0x09,
+	0x83, 0x00, 0xFA, 0x01, 0x22, 0xA1, 0x21, 0xA2, 0x22, 0xA2, 0x22, 0xA1, 0x25, 0xA2, 0x27, 0xA1,
+	0x2D, 0xE1, 0x25, 0xE1, 0x21, 0xE1, 0x24, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x21, 0xE4, 0x64, 0xA1,
+	0x66, 0xE1, 0x67, 0xE1, 0x63, 0xE1, 0x61, 0xE1, 0x63, 0xE1, 0x62, 0xE1, 0x64, 0xE1, 0x61, 0xE1,
+	0x66, 0xA1, 0x63, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x63, 0x23, 0xA1, 0x25, 0xA1, 0x25,
+	0xA1, 0x25, 0xA1, 0x21, 0xA1, 0x23, 0xA1, 0x2F, 0x40, 0xFA, 0x01, 0x5F, 0x03, 0x8C, 0xC0
 };
 
 // Función para mostrar el menú de opciones
 void MENU(void){
 	UART_TX_CADENA("\r\nSeleccione: 1 = Triangulo, 2 = Circulo, 3 = Cruz, 4 = Todas las figuras, Z = Zorro, F = Flor\r\n");
+	UART_TX_CADENA("Durante el dibujo: P = Pausa, C = Continuar, X = Cancelar\r\n");
 }
 
 // Función principal
@@ -329,28 +401,31 @@ int main(void){
 	DDRD = 0xFC; // Se configuran PD0 y PD1 como entradas, el resto como salidas
 	PORTD = 0x00; // Se inicializa PORTD en 0
 	UART_INICIAR(); // Se inicializa la comunicación UART
+	TIMER1_INICIAR(); // Se inicializa el Timer1 que ejecuta la cola de pasos
 	char opcion; // Variable para almacenar la opción seleccionada
 
 	// Bucle principal
 	while (1){
 		MENU(); // Se muestra el menú de opciones
 		opcion = UART_RX(); // Se almacena la opción seleccionada por el usuario
+		cancelado = 0; // La figura nueva no está cancelada
 		// Se ejecuta la figura correspondiente según la opción seleccionada
 		switch (opcion){
 			case '1': TRIANGULO(); // Se dibuja un triángulo
 			break; // Se sale del switch
-			case '2': EJECUTAR_FIGURA(CIRCULO, sizeof(CIRCULO) / sizeof(Paso)); // Se dibuja un círculo
+			case '2': EJECUTAR_FIGURA(CIRCULO); // Se dibuja un círculo
 			break; // Se sale del switch
 			case '3': CRUZ(); // Se dibuja una cruz
 			break; // Se sale del switch
 			case '4': FIGURAS(); // Se dibujan todas las figuras
 			break; // Se sale del switch
-			case 'Z': EJECUTAR_FIGURA(ZORRO, sizeof(ZORRO) / sizeof(Paso)); // Se dibuja un zorro
+			case 'Z': EJECUTAR_FIGURA(ZORRO); // Se dibuja un zorro
 			break; // Se sale del switch
-			case 'F': EJECUTAR_FIGURA(FLOR, sizeof(FLOR) / sizeof(Paso)); // Se dibuja una flor
+			case 'F': EJECUTAR_FIGURA(FLOR); // Se dibuja una flor
 			break; // Se sale del switch
 			default: UART_TX_CADENA("\r\n¡Error! Opción inválida\r\n"); // Se notifica al usuario sobre la opción inválida
 			break; // Se sale del switch
 		}
+		ESPERAR_FIN(); // Se espera a que termine de dibujarse atendiendo la pausa y la cancelación
 	}
 }
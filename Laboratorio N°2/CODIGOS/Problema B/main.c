@@ -43,13 +43,54 @@ uint16_t PROMEDIO(uint8_t canal, uint8_t n){ // Función para promediar n lectur
 	return (uint16_t)(acc/n); // Se retorna el promedio entero de las lecturas
 }
 
-void LEDS_INICIAR(void){ // Función para inicializar pines de LEDs discretos (R,G,B) en PORTD
-	DDRD |= (1 << PD2) | (1 << PD3) | (1 << PD4); // Se configuran PD2, PD3 y PD4 como salidas
+#define LED_R (1 << PD2) // Máscara del LED rojo (PD2)
+#define LED_G (1 << PD3) // Máscara del LED verde (PD3)
+#define LED_B (1 << PD4) // Máscara del LED azul (PD4)
+#define LEDS_MASCARA (LED_R | LED_G | LED_B) // Pines de PORTD manejados por el PWM por software
+
+// PWM por software de los LEDs por modulación de código binario (BCM), en el Timer2 (el Timer1 queda para el servo):
+// el período se divide en 8 tramos de 1, 2, 4 ... 128 ticks de 16 µs y en el tramo k cada LED muestra el bit k de su brillo
+volatile uint8_t leds_estados[2][8]; // Doble tabla con el estado de PD2..PD4 en cada tramo
+volatile uint8_t leds_tabla = 0; // Tabla que recorre la interrupción
+volatile uint8_t leds_pendiente = 0; // Indica que la otra tabla tiene brillos nuevos para el próximo período
+volatile uint8_t leds_tramo = 0; // Tramo que comienza en la próxima interrupción (0 a 7)
+
+ISR(TIMER2_COMPA_vect){ // Comienzo de un tramo: se escriben los LEDs y se programa la duración
+	uint8_t k = leds_tramo; // Tramo que comienza
+	if(k == 0 && leds_pendiente){ leds_tabla ^= 1; leds_pendiente = 0; } // Al inicio del período se toma la tabla nueva si la hay
+	PORTD = (PORTD & ~LEDS_MASCARA) | leds_estados[leds_tabla][k]; // Se escriben los tres LEDs sin tocar el resto de PORTD
+	OCR2A = (uint8_t)((1 << k) - 1); // El tramo k dura 2^k ticks (la cuenta ya volvió a 0 en la comparación)
+	leds_tramo = (k + 1) & 7; // Se pasa al tramo siguiente
+}
+
+void LEDS_INICIAR(void){ // Función para inicializar pines de LEDs discretos (R,G,B) en PORTD y el PWM por software
+	PORTD &= ~LEDS_MASCARA; // Se arranca con los LEDs apagados
+	DDRD |= LEDS_MASCARA; // Se configuran PD2, PD3 y PD4 como salidas
+	TCCR2B = 0; // Se detiene el Timer2 mientras se configura
+	TCCR2A = (1 << WGM21); // Modo CTC (TOP = OCR2A), sin salidas en los pines
+	TCNT2 = 0; // Se reinicia la cuenta
+	OCR2A = 0; // La primera interrupción llega en un tick
+	TIFR2 = (1 << OCF2A); // Se limpia una bandera pendiente
+	TIMSK2 = (1 << OCIE2A); // Se habilita la interrupción por coincidencia con OCR2A
+	TCCR2B = (1 << CS22) | (1 << CS21); // Se arranca con prescaler 256 (tick de 16 µs, período de 4,08 ms)
+	sei(); // Se habilitan las interrupciones globales
+}
+uint8_t led_brillo[3]; // Brillo guardado de cada LED (R,G,B), para encender uno sin cambiar los otros
+void LEDS_COLOR(uint8_t r, uint8_t g, uint8_t b){ // Función para fijar el brillo de los tres LEDs (0..255) a la vez
+	led_brillo[0] = r; led_brillo[1] = g; led_brillo[2] = b; // Se guardan los brillos
+	while(leds_pendiente); // Se espera a que la interrupción haya tomado la tabla anterior (la otra queda libre)
+	volatile uint8_t *nueva = leds_estados[leds_tabla ^ 1]; // Tabla que no está en uso
+	for(uint8_t k=0;k<8;k++){ // Se recorren los tramos
+		uint8_t bit = (uint8_t)(1 << k); // Bit del brillo que corresponde al tramo
+		nueva[k] = ((r & bit) ? LED_R : 0) | ((g & bit) ? LED_G : 0) | ((b & bit) ? LED_B : 0); // LEDs encendidos en el tramo
+	}
+	leds_pendiente = 1; // La interrupción tomará la tabla nueva al comenzar el próximo período
+	while(leds_pendiente); // Se espera a que los brillos estén en las salidas (hasta 4 ms)
 }
-static inline void LEDS_OFF(void){ PORTD &= ~((1<<PD2)|(1<<PD3)|(1<<PD4)); } // Se apagan los tres LEDs (R,G,B)
-static inline void LED_R_ON(void){ PORTD |= (1<<PD2); } // Se enciende LED rojo en PD2
-static inline void LED_G_ON(void){ PORTD |= (1<<PD3); } // Se enciende LED verde en PD3
-static inline void LED_B_ON(void){ PORTD |= (1<<PD4); } // Se enciende LED azul en PD4
+static inline void LEDS_OFF(void){ LEDS_COLOR(0, 0, 0); } // Se apagan los tres LEDs (R,G,B)
+static inline void LED_R_ON(void){ LEDS_COLOR(255, led_brillo[1], led_brillo[2]); } // Se enciende LED rojo en PD2 a pleno brillo
+static inline void LED_G_ON(void){ LEDS_COLOR(led_brillo[0], 255, led_brillo[2]); } // Se enciende LED verde en PD3 a pleno brillo
+static inline void LED_B_ON(void){ LEDS_COLOR(led_brillo[0], led_brillo[1], 255); } // Se enciende LED azul en PD4 a pleno brillo
 
 void SERVO_INICIAR(void){ // Función para inicializar PWM en Timer1 para control de servo (OC1A/PB1)
 	DDRB |= (1 << PB1); // Se configura PB1 (OC1A) como salida
@@ -204,10 +245,10 @@ int main(void){ // Función principal del programa
 		_delay_ms(300); // Se espera 300 ms para permitir movimiento/estabilización mecánica
 
 		switch(colorID){ // Se actualiza la indicación visual (WS2812 y LEDs discretos) según el color detectado
-			case 0: setLedRGB(leds, 0, 0,255,0); show(leds); LED_G_ON(); break; // Si VERDE: se enciende verde en tira y LED G
-			case 1: setLedRGB(leds, 0, 255,255,0); show(leds); LED_R_ON(); LED_G_ON(); break; // Si AMARILLO: mezcla R+G y LEDs R,G
-			case 2: setLedRGB(leds, 0, 255,0,0); show(leds); LED_R_ON(); break; // Si ROJO: se enciende rojo en tira y LED R
-			default: setLedRGB(leds, 0, 128,0,128); show(leds); LED_B_ON(); break; // Caso MORADO/u otro: púrpura en tira y LED B
+			case 0: setLedRGB(leds, 0, 0,255,0); show(leds); LEDS_COLOR(0,255,0); break; // Si VERDE: se enciende verde en tira y LED G
+			case 1: setLedRGB(leds, 0, 255,255,0); show(leds); LEDS_COLOR(255,255,0); break; // Si AMARILLO: mezcla R+G en tira y LEDs
+			case 2: setLedRGB(leds, 0, 255,0,0); show(leds); LEDS_COLOR(255,0,0); break; // Si ROJO: se enciende rojo en tira y LED R
+			default: setLedRGB(leds, 0, 128,0,128); show(leds); LEDS_COLOR(128,0,128); break; // Caso MORADO/u otro: púrpura a medio brillo en tira y LEDs R+B
 		}
 
 		_delay_ms(500); // Se agrega retardo de 500 ms antes del siguiente ciclo de detección
@@ -0,0 +1,13 @@
+// Interrupciones para el simulador: las rutinas son funciones comunes que llama el simulador y cli()/sei() solo
+// registran si las interrupciones están habilitadas
+#ifndef SIM_INTERRUPT_H
+#define SIM_INTERRUPT_H
+
+void sim_cli(void); // Deshabilita las interrupciones simuladas
+void sim_sei(void); // Las habilita y, si la cola quedó llena, ejecuta la interrupción hasta liberar un lugar
+
+#define ISR(vector) void vector(void)
+#define cli() sim_cli()
+#define sei() sim_sei()
+
+#endif
@@ -0,0 +1,62 @@
+// Registros del ATmega328P que usa el programa del plotter, como variables del host para el simulador. PORTB, PORTC,
+// PINB, PINC y TIMSK1 pasan por funciones del simulador: así registra cada cambio de los pines (aunque un pulso suba y
+// baje dentro de la misma interrupción) y ejecuta la interrupción del Timer1 mientras el programa espera a que termine
+// la cola. Como en el AVR, escribir un 1 en un bit de PINB o PINC invierte ese bit del puerto. EECR y EEDR también
+// pasan por una función que completa la lectura o escritura de la EEPROM pedida en el acceso anterior
+#ifndef SIM_IO_H
+#define SIM_IO_H
+
+#include <stdint.h>
+
+extern volatile uint8_t sim_portb, sim_portc; // Valores de los puertos B y C
+extern volatile uint8_t sim_pinb, sim_pinc; // Bits escritos en PINB y PINC que todavía no se aplicaron a los puertos
+extern volatile uint8_t sim_timsk1; // Valor de TIMSK1
+volatile uint8_t *sim_puerto(volatile uint8_t *puerto); // Registra los cambios de los puertos antes de cada acceso
+volatile uint8_t *sim_mascara_timer(void); // Avanza la simulación cuando el programa espera con las interrupciones habilitadas
+
+#define PORTB (*sim_puerto(&sim_portb))
+#define PORTC (*sim_puerto(&sim_portc))
+#define PINB (*sim_puerto(&sim_pinb))
+#define PINC (*sim_puerto(&sim_pinc))
+#define TIMSK1 (*sim_mascara_timer())
+
+extern volatile uint8_t sim_eecr, sim_eedr; // Valores de EECR y EEDR
+volatile uint8_t *sim_eeprom(volatile uint8_t *registro); // Completa la operación pendiente de la EEPROM
+#define EECR (*sim_eeprom(&sim_eecr))
+#define EEDR (*sim_eeprom(&sim_eedr))
+extern volatile uint16_t EEAR; // Dirección de la EEPROM
+
+extern volatile uint8_t DDRB, DDRC, DDRD, PORTD, PIND; // Resto de los puertos
+extern volatile uint8_t TCCR1A, TCCR1B, TIFR1; // Control y banderas del Timer1
+extern volatile uint16_t TCNT1, OCR1A, OCR1B; // Contador y comparaciones del Timer1
+extern volatile uint8_t PCICR, PCIFR, PCMSK2; // Interrupción por cambio de pin
+extern volatile uint8_t GPIOR0; // Registro de uso general
+
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PC0 0
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PD2 2
+#define PD3 3
+#define PD5 5
+
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM12 3
+#define OCIE1A 1
+#define OCIE1B 2
+#define OCF1A 1
+#define OCF1B 2
+#define PCIE2 2
+#define PCIF2 2
+#define PCINT18 2
+#define PCINT19 3
+#define EERE 0
+#define EEPE 1
+#define EEMPE 2
+
+#endif
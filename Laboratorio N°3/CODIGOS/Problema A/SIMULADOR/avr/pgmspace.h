@@ -0,0 +1,10 @@
+// Memoria de programa para el simulador: en el host las tablas quedan en la memoria común
+#ifndef SIM_PGMSPACE_H
+#define SIM_PGMSPACE_H
+
+#include <stdint.h>
+
+#define PROGMEM
+#define pgm_read_byte(direccion) (*(const uint8_t *)(direccion))
+
+#endif
@@ -0,0 +1,291 @@
+// Simulador en la PC del movimiento del plotter del Problema A. Compila el main.c del microcontrolador sin cambios, con
+// los registros del AVR reemplazados por variables (carpetas avr/ y util/), y ejecuta la interrupción del Timer1 en un
+// tiempo virtual: cada interrupción ocurre cuando TCNT1 alcanzaría OCR1A, sin esperar en tiempo real. Se registran los
+// flancos de CLK (con su DIR) y los cambios del solenoide leyendo los pines, igual que los vería el driver, y se generan:
+//   <salida>.csv  eventos con su tiempo en µs (X+, X-, Y+, Y-, BAJA, SUBE), para comparar dos versiones con diff
+//   <salida>.svg  recorrido de la pluma (negro con la pluma abajo, gris punteado con la pluma arriba)
+//   un informe por consola con el tiempo total, los recorridos y el histograma de frecuencias de paso
+// La EEPROM se puede cargar y guardar en un archivo para probar los puntos de control: con --corte se simula un corte de
+// energía después de N interrupciones (se guarda la EEPROM y se sale), y al volver a ejecutar con el mismo archivo el
+// programa ofrece retomar la figura (la respuesta se lee de la entrada estándar).
+//
+// El programa encola segmentos mucho más rápido de lo que se ejecutan, así que se simula como si el cálculo no llevara
+// tiempo: la interrupción solo corre cuando la cola está llena o el programa espera (PLOTTER_ESPERAR o la UART).
+//
+// Compilación y uso (desde esta carpeta):
+//   gcc -O2 -std=gnu99 -I. -I"../../../LIBRERIAS/UART" -I"../../../LIBRERIAS/GCODE" -I"../../../LIBRERIAS/EEPROM"
+//       simulador.c -lm -o simulador
+//   ./simulador [salida]                      dibuja FIGURAS()
+//   ./simulador --gcode [salida] < trabajo    ejecuta las líneas de G-code del archivo
+//   ./simulador --eeprom ee.bin --corte 200000 [salida]   corta la energía a mitad de las figuras
+//   echo R | ./simulador --eeprom ee.bin [salida]         retoma la figura interrumpida
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define main main_plotter // El main del microcontrolador no se usa: el simulador llama a sus funciones
+#include "../main.c"
+#undef main
+#include "gcode.c" // Intérprete de G-code de LIBRERIAS
+#include "eeprom.c" // Acceso a la EEPROM de LIBRERIAS
+
+#define RESOLUCION_SVG 8 // Distancia mínima en pasos entre dos puntos consecutivos del recorrido dibujado
+#define HISTOGRAMA_PASO 1000 // Ancho de cada barra del histograma en flancos por segundo
+#define HISTOGRAMA_N 24 // Cantidad de barras (la última acumula las frecuencias mayores)
+
+// Registros simulados
+volatile uint8_t sim_portb, sim_portc, sim_pinb, sim_pinc, sim_timsk1;
+volatile uint8_t DDRB, DDRC, DDRD, PORTD, PIND = 0xFF; // Finales de carrera sueltos
+volatile uint8_t TCCR1A, TCCR1B, TIFR1, PCICR, PCIFR, PCMSK2, GPIOR0;
+volatile uint16_t TCNT1, OCR1A, OCR1B;
+volatile uint8_t sim_eecr, sim_eedr;
+volatile uint16_t EEAR;
+
+static uint8_t eeprom[1024]; // Contenido de la EEPROM (borrada: 0xFF)
+static const char *archivo_eeprom = 0; // Archivo donde se carga y guarda la EEPROM
+static uint32_t corte = 0; // Interrupciones hasta el corte de energía (0 sin corte)
+static void TERMINAR(void); // Termina la simulación
+
+static uint8_t interrupciones = 0; // Estado de cli()/sei()
+static uint8_t en_interrupcion = 0; // 1 mientras corre la rutina de interrupción simulada
+static uint8_t anterior_b, anterior_c; // Últimos valores vistos de los puertos
+static double tiempo = 0; // Tiempo simulado en segundos
+static uint32_t n_interrupciones = 0; // Interrupciones del Timer1 ejecutadas
+
+static int32_t x = 0, y = 0; // Posición de la pluma en flancos según los pines
+static int32_t dx_isr = 0, dy_isr = 0; // Desplazamiento dentro de la interrupción en curso
+static uint8_t pluma_bajada = 1; // El pin del solenoide arranca en bajo (pluma abajo)
+static double recorrido_abajo = 0, recorrido_arriba = 0; // Recorridos en mm
+static uint32_t flancos_x = 0, flancos_y = 0; // Flancos totales de cada eje
+static uint32_t histograma_flancos[HISTOGRAMA_N]; // Flancos del eje mayor en cada rango de frecuencia
+static double histograma_tiempo[HISTOGRAMA_N]; // Tiempo en cada rango de frecuencia
+static double tiempo_anterior = 0; // Tiempo de la interrupción anterior
+static uint8_t anterior_movio = 0; // 1 si la interrupción anterior dio un paso (el intervalo es entre dos pasos)
+
+static FILE *eventos; // Archivo de eventos
+typedef struct { int32_t x, y; uint8_t abajo; uint8_t nuevo; } Punto; // Punto del recorrido dibujado
+static Punto *puntos = 0; // Recorrido simplificado
+static size_t n_puntos = 0, capacidad = 0;
+
+// Función que agrega un punto al recorrido dibujado ('nuevo' empieza otro trazo)
+static void AGREGAR_PUNTO(uint8_t nuevo){
+	if (n_puntos == capacidad){ capacidad = capacidad ? 2 * capacidad : 4096; puntos = realloc(puntos, capacidad * sizeof(Punto)); }
+	puntos[n_puntos++] = (Punto){ x, y, pluma_bajada, nuevo };
+}
+
+// Función que compara los puertos con los últimos valores vistos y registra los flancos y el solenoide
+static void OBSERVAR(void){
+	sim_portb ^= sim_pinb; sim_pinb = 0; // Los unos escritos en PINB y PINC invierten los bits del puerto
+	sim_portc ^= sim_pinc; sim_pinc = 0;
+	uint8_t b = sim_portb, c = sim_portc; // Valores actuales
+	uint32_t t_us = (uint32_t)(tiempo * 1e6 + 0.5); // Tiempo del evento
+	if ((b ^ anterior_b) & (1 << CLK_X)){ // Flanco de CLK_X
+		int8_t s = (b & (1 << DIR_X)) ? 1 : -1; // DIR_X en alto es hacia la derecha
+		x += s; dx_isr += s; flancos_x++;
+		fprintf(eventos, "%u,X%c,%d,%d\n", t_us, s > 0 ? '+' : '-', x, y);
+	}
+	if ((c ^ anterior_c) & (1 << CLK_Y)){ // Flanco de CLK_Y
+		int8_t s = (c & (1 << DIR_Y)) ? -1 : 1; // DIR_Y en bajo es hacia arriba
+		y += s; dy_isr += s; flancos_y++;
+		fprintf(eventos, "%u,Y%c,%d,%d\n", t_us, s > 0 ? '+' : '-', x, y);
+	}
+	if ((c ^ anterior_c) & (1 << SOLENOID)){ // Cambio del solenoide
+		pluma_bajada = !(c & (1 << SOLENOID)); // El pin en bajo baja la pluma
+		fprintf(eventos, "%u,%s,%d,%d\n", t_us, pluma_bajada ? "BAJA" : "SUBE", x, y);
+		AGREGAR_PUNTO(1); // Empieza otro trazo
+	}
+	anterior_b = b; anterior_c = c;
+}
+
+// Función que completa la operación de la EEPROM que pidió el último acceso a EECR (en el simulador no lleva tiempo)
+volatile uint8_t *sim_eeprom(volatile uint8_t *registro){
+	if (sim_eecr & (1 << EEPE)){ // Escritura (EEMPE y EEPE)
+		if (sim_eecr & (1 << EEMPE)) eeprom[EEAR & 1023] = sim_eedr;
+		sim_eecr &= ~((1 << EEPE) | (1 << EEMPE));
+	}
+	if (sim_eecr & (1 << EERE)){ // Lectura
+		sim_eedr = eeprom[EEAR & 1023];
+		sim_eecr &= ~(1 << EERE);
+	}
+	return registro;
+}
+
+// Función que guarda la EEPROM en su archivo
+static void GUARDAR_EEPROM(void){
+	if (!archivo_eeprom) return;
+	sim_eeprom(&sim_eecr); // Última escritura pendiente
+	FILE *f = fopen(archivo_eeprom, "wb");
+	if (!f){ perror(archivo_eeprom); return; }
+	fwrite(eeprom, 1, sizeof eeprom, f);
+	fclose(f);
+}
+
+volatile uint8_t *sim_puerto(volatile uint8_t *puerto){
+	OBSERVAR(); // Se registra lo que dejó la escritura anterior
+	return puerto;
+}
+
+// Función que ejecuta la próxima interrupción de comparación A del Timer1 y acumula sus estadísticas
+static void INTERRUPCION(void){
+	uint32_t ticks = (uint16_t)(OCR1A - TCNT1); // Cuentas hasta la comparación
+	if (ticks == 0) ticks = 65536; // Una vuelta completa
+	static const uint16_t prescaler[8] = { 0, 1, 8, 64, 256, 1024, 1, 1 }; // Según CS12:CS10
+	uint16_t p = prescaler[TCCR1B & 0x07];
+	tiempo += (double)ticks * (p ? p : 1) / F_CPU; // Avanza el tiempo
+	TCNT1 = OCR1A; // El contador llegó a la comparación
+
+	dx_isr = dy_isr = 0;
+	en_interrupcion = 1;
+	TIMER1_COMPA_vect(); // Rutina del programa
+	OBSERVAR(); // Últimas escrituras de la rutina
+	en_interrupcion = 0;
+	n_interrupciones++;
+	if (n_interrupciones == corte){ // Corte de energía: la cola se pierde y queda lo que se escribió en la EEPROM
+		printf("Corte de energía en (%d, %d) flancos\n", x, y);
+		sim_timsk1 = 0;
+		TERMINAR();
+	}
+
+	if (dx_isr || dy_isr){ // Hubo movimiento
+		double mx = (double)dx_isr / PASOS_POR_MM, my = (double)dy_isr * 256 / ((double)PASOS_POR_MM * FACTOR_Y); // En mm
+		if (pluma_bajada) recorrido_abajo += sqrt(mx * mx + my * my);
+		else recorrido_arriba += sqrt(mx * mx + my * my);
+		uint32_t mayor = abs(dx_isr) > abs(dy_isr) ? abs(dx_isr) : abs(dy_isr); // Flancos del eje mayor
+		double dt = tiempo - tiempo_anterior; // Intervalo desde la interrupción anterior
+		if (anterior_movio && dt > 0){ // Después de una espera del solenoide o de la cola detenida el intervalo no es de paso
+			uint32_t i = (uint32_t)((mayor / dt + 0.5) / HISTOGRAMA_PASO); // Barra según la frecuencia redondeada
+			if (i >= HISTOGRAMA_N) i = HISTOGRAMA_N - 1;
+			histograma_flancos[i] += mayor;
+			histograma_tiempo[i] += dt;
+		}
+		Punto *u = &puntos[n_puntos - 1]; // Último punto guardado
+		if (abs(x - u->x) >= RESOLUCION_SVG || abs(y - u->y) >= RESOLUCION_SVG) AGREGAR_PUNTO(0);
+	}
+	anterior_movio = dx_isr || dy_isr;
+	tiempo_anterior = tiempo;
+}
+
+void sim_cli(void){ interrupciones = 0; }
+
+void sim_sei(void){
+	interrupciones = 1;
+	if (en_interrupcion) return;
+	while (((cola_escritura + 1) & (COLA_N - 1)) == cola_lectura && (sim_timsk1 & (1 << OCIE1A))) INTERRUPCION(); // Se libera un lugar
+}
+
+volatile uint8_t *sim_mascara_timer(void){
+	if (interrupciones && !en_interrupcion && (sim_timsk1 & (1 << OCIE1A))) INTERRUPCION(); // El programa espera con la cola en marcha
+	return &sim_timsk1;
+}
+
+// Funciones de la UART del intérprete de G-code: se lee la entrada estándar y las respuestas van a la salida de errores
+void UART_INICIAR(unsigned int ubrr){ (void)ubrr; }
+void UART_HABILITAR_RX_INT(void){}
+uint8_t UART_RX_DESBORDE(void){ return 0; }
+void UART_IMPRIMIR(const char *s){ fputs(s, stderr); }
+uint8_t UART_DISPONIBLE(void){ // Sin entrada no llega respuesta
+	int c = getchar();
+	if (c == EOF) return 0;
+	ungetc(c, stdin);
+	return 1;
+}
+char UART_LEER(void){
+	int c = getchar(); // Próximo carácter del trabajo
+	if (c == EOF) TERMINAR(); // Fin del trabajo: se termina la cola y se informa
+	return (char)c;
+}
+
+static const char *salida = "simulacion"; // Prefijo de los archivos generados
+
+// Función que escribe el recorrido como SVG con el eje Y hacia arriba
+static void ESCRIBIR_SVG(void){
+	char nombre[256];
+	snprintf(nombre, sizeof nombre, "%s.svg", salida);
+	FILE *f = fopen(nombre, "w");
+	if (!f){ perror(nombre); return; }
+	int32_t x0 = 0, x1 = 0, y0 = 0, y1 = 0; // Límites del recorrido
+	for (size_t i = 0; i < n_puntos; i++){
+		if (puntos[i].x < x0) x0 = puntos[i].x;
+		if (puntos[i].x > x1) x1 = puntos[i].x;
+		if (puntos[i].y < y0) y0 = puntos[i].y;
+		if (puntos[i].y > y1) y1 = puntos[i].y;
+	}
+	int32_t margen = (x1 - x0 + y1 - y0) / 40 + 10, ancho = x1 - x0 + 2 * margen, alto = y1 - y0 + 2 * margen;
+	double trazo = (ancho > alto ? ancho : alto) / 600.0; // Grosor de línea proporcional al dibujo
+	fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"%d %d %d %d\" width=\"800\" height=\"%d\">\n",
+		x0 - margen, -y1 - margen, ancho, alto, (int)(800.0 * alto / ancho));
+	fprintf(f, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"white\"/>\n", x0 - margen, -y1 - margen, ancho, alto);
+	for (size_t i = 0; i + 1 < n_puntos; ){ // Un camino por cada tramo con el mismo estado de la pluma
+		size_t j = i + 1;
+		fprintf(f, "<path fill=\"none\" d=\"M%d %d", puntos[i].x, -puntos[i].y);
+		while (j < n_puntos && !puntos[j].nuevo){ fprintf(f, " L%d %d", puntos[j].x, -puntos[j].y); j++; }
+		if (j < n_puntos) fprintf(f, " L%d %d", puntos[j].x, -puntos[j].y); // Hasta el punto donde cambia la pluma
+		if (puntos[i].abajo) fprintf(f, "\" stroke=\"black\" stroke-width=\"%.1f\"/>\n", trazo);
+		else fprintf(f, "\" stroke=\"#999\" stroke-width=\"%.1f\" stroke-dasharray=\"%.1f\"/>\n", trazo / 2, trazo * 4);
+		i = j;
+	}
+	fprintf(f, "</svg>\n");
+	fclose(f);
+}
+
+// Función que imprime el informe de la simulación
+static void INFORMAR(void){
+	printf("Tiempo total:          %.3f s\n", tiempo);
+	printf("Recorrido pluma abajo: %.1f mm\n", recorrido_abajo);
+	printf("Recorrido pluma arriba: %.1f mm\n", recorrido_arriba);
+	printf("Flancos X: %u | Flancos Y: %u | Interrupciones: %u\n", flancos_x, flancos_y, n_interrupciones);
+	printf("Posición final: (%d, %d) flancos\n", x, y);
+	printf("\nFrecuencia del eje mayor (flancos/s)   flancos   tiempo\n");
+	double total = 0;
+	for (int i = 0; i < HISTOGRAMA_N; i++) total += histograma_tiempo[i];
+	for (int i = 0; i < HISTOGRAMA_N; i++){
+		if (!histograma_flancos[i]) continue;
+		int barra = total > 0 ? (int)(40 * histograma_tiempo[i] / total + 0.5) : 0; // Proporcional al tiempo
+		if (i == HISTOGRAMA_N - 1) printf("  >= %5d           ", i * HISTOGRAMA_PASO);
+		else printf("  %5d - %5d      ", i * HISTOGRAMA_PASO, (i + 1) * HISTOGRAMA_PASO);
+		printf("%10u %7.2f s  ", histograma_flancos[i], histograma_tiempo[i]);
+		for (int k = 0; k < barra; k++) putchar('#');
+		putchar('\n');
+	}
+}
+
+// Función que termina de ejecutar la cola, escribe los resultados y sale
+static void TERMINAR(void){
+	interrupciones = 1;
+	while (sim_timsk1 & (1 << OCIE1A)) INTERRUPCION(); // Se ejecuta lo que quede en la cola
+	AGREGAR_PUNTO(0); // Punto final
+	GUARDAR_EEPROM();
+	fclose(eventos);
+	ESCRIBIR_SVG();
+	INFORMAR();
+	exit(0);
+}
+
+int main(int argc, char **argv){
+	uint8_t gcode = 0; // 1 para leer G-code de la entrada estándar
+	for (int i = 1; i < argc; i++){
+		if (!strcmp(argv[i], "--gcode")) gcode = 1;
+		else if (!strcmp(argv[i], "--eeprom") && i + 1 < argc) archivo_eeprom = argv[++i];
+		else if (!strcmp(argv[i], "--corte") && i + 1 < argc) corte = strtoul(argv[++i], 0, 10);
+		else salida = argv[i];
+	}
+	memset(eeprom, 0xFF, sizeof eeprom);
+	if (archivo_eeprom){ // Si el archivo existe se carga (si no la EEPROM arranca borrada)
+		FILE *f = fopen(archivo_eeprom, "rb");
+		if (f){ if (fread(eeprom, 1, sizeof eeprom, f) != sizeof eeprom) fprintf(stderr, "%s incompleto\n", archivo_eeprom); fclose(f); }
+	}
+	char nombre[256];
+	snprintf(nombre, sizeof nombre, "%s.csv", salida);
+	eventos = fopen(nombre, "w");
+	if (!eventos){ perror(nombre); return 1; }
+	fprintf(eventos, "t_us,evento,x,y\n");
+	AGREGAR_PUNTO(1); // Punto inicial
+
+	TIMER1_INICIAR(); // Igual que el main del microcontrolador
+	if (gcode) INTERPRETE_GCODE(); // No retorna: termina al acabarse la entrada
+	else if (!RETOMAR_TRABAJO()) FIGURAS(); // Secuencia de figuras, salvo que se retome una interrumpida
+	TERMINAR();
+	return 0;
+}
@@ -0,0 +1,8 @@
+// Retardos para el simulador: el plotter no los usa en el movimiento, así que no consumen tiempo simulado
+#ifndef SIM_DELAY_H
+#define SIM_DELAY_H
+
+static inline void _delay_ms(double ms){ (void)ms; }
+static inline void _delay_us(double us){ (void)us; }
+
+#endif
@@ -0,0 +1,76 @@
+import serial  # Se importa la librería 'serial' para establecer comunicación por puerto serie con el microcontrolador
+import sys  # Se importa la librería 'sys' para leer el nombre del archivo desde la línea de comandos
+import time  # Se importa la librería 'time' para medir la duración del trabajo
+
+PUERTO = 'COM5'  # Se define el puerto serie donde está conectado el microcontrolador
+BAUDRATE = 38400  # Se define la velocidad de comunicación en baudios (BAUD en el microcontrolador)
+BUFFER_RX = 128  # Se define el tamaño del buffer de recepción del microcontrolador (UART_RX_TAM)
+MARGEN = 8  # Se dejan algunos bytes libres en el buffer por seguridad
+LINEA_MAX = 71  # Se define el largo máximo de una línea sin el fin de línea (GCODE_LINEA_MAX - 1)
+
+
+def limpiar(linea):  # Se quitan los comentarios y espacios que no hace falta enviar
+    linea = linea.split(';')[0]  # Se descarta el comentario hasta el final de la línea
+    while '(' in linea and ')' in linea:  # Se descartan los comentarios entre paréntesis
+        inicio = linea.index('(')
+        linea = linea[:inicio] + linea[linea.index(')', inicio) + 1:]
+    return linea.replace(' ', '').replace('\t', '').upper()  # Se quitan los espacios para ocupar menos buffer
+
+
+def leer_trabajo(nombre):  # Se leen las líneas útiles del archivo de G-code
+    with open(nombre) as archivo:
+        lineas = [limpiar(l) for l in archivo]  # Se limpia cada línea
+    return [l for l in lineas if l]  # Las líneas vacías no se envían porque el microcontrolador no las responde
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:  # Se necesita el archivo a enviar
+        print("Uso: python emisor_gcode.py trabajo.gcode")
+        sys.exit(1)
+    lineas = leer_trabajo(sys.argv[1])  # Se carga el trabajo completo
+
+    ser = serial.Serial(PUERTO, BAUDRATE, timeout=1)  # Se inicializa la comunicación serie con los parámetros definidos
+    print("Esperando al plotter (puede estar dibujando las figuras predefinidas)...")
+    while b"listo" not in ser.readline():  # Se espera el aviso de que el intérprete está activo
+        pass
+
+    # Control de flujo por conteo de caracteres: el microcontrolador responde una línea por cada línea recibida y en el
+    # mismo orden, así que se sabe cuántos bytes siguen en su buffer. Se envían líneas mientras entren, en lugar de
+    # esperar el "ok" de cada una, para que la siguiente ya esté recibida cuando termina de encolar la actual.
+    pendientes = []  # Largo de las líneas enviadas que todavía no se respondieron
+    enviadas = errores = 0  # Contadores del trabajo
+    t0 = time.time()  # Tiempo de inicio
+
+    try:
+        while enviadas < len(lineas) or pendientes:  # Hasta enviar todo y recibir todas las respuestas
+            while enviadas < len(lineas):  # Se envían las líneas que entran en el buffer
+                linea = lineas[enviadas]
+                if len(linea) > LINEA_MAX:  # El microcontrolador la rechazaría
+                    print(f"Línea {enviadas + 1} demasiado larga: {linea}")
+                if sum(pendientes) + len(linea) + 1 > BUFFER_RX - MARGEN:  # Si no entra se esperan respuestas
+                    break
+                ser.write((linea + '\n').encode())  # Se envía la línea
+                pendientes.append(len(linea) + 1)  # Se cuentan sus bytes hasta que se responda
+                enviadas += 1
+
+            respuesta = ser.readline().decode(errors='replace').strip()  # Se espera la respuesta de la línea más antigua
+            if not respuesta:  # Sin respuesta: el plotter está bloqueado con la cola llena, se sigue esperando
+                continue
+            n = enviadas - len(pendientes) + 1  # Número de la línea respondida
+            pendientes.pop(0)  # Sus bytes ya salieron del buffer
+            if respuesta.startswith('error'):  # La línea fue rechazada
+                errores += 1
+                print(f"Línea {n} ({lineas[n - 1]}): {respuesta}")
+            if n % 100 == 0:  # Se informa el avance cada 100 líneas
+                print(f"{n}/{len(lineas)} líneas | {time.time() - t0:.1f} s")
+
+        ser.write(b"M400\n")  # Se pide responder recién cuando la cola termine de ejecutarse
+        while not ser.readline():  # Se espera el final del dibujo
+            pass
+        print(f"\nTrabajo terminado: {len(lineas)} líneas en {time.time() - t0:.1f} s | Errores={errores}")
+
+    except KeyboardInterrupt:  # Si el usuario interrumpe el programa con Ctrl+C
+        print("\nEnvío interrumpido por el usuario.")
+
+    finally:
+        ser.close()  # Se cierra el puerto serie para liberar el recurso
@@ -4,7 +4,11 @@
 #include <util/delay.h> // Se incluye la librería para generar retardos
 #include <stdbool.h> // Se incluye la librería para el manejo del tipo de dato booleano
 #include <avr/pgmspace.h> // Se incluye la librería para almacenar datos en la memoria de programa (flash)
-#include <math.h> // Se incluye la librería matemática para realizar cálculos con funciones trigonométricas
+#include <stddef.h> // Se incluye la librería estándar para offsetof()
+#include <stdio.h> // Se incluye la librería estándar para formateo de cadenas (sprintf)
+#include "uart.h" // Se incluye la librería personalizada para la comunicación UART
+#include "gcode.h" // Se incluye la librería personalizada para interpretar las líneas de G-code recibidas
+#include "eeprom.h" // Se incluye la librería personalizada para leer y escribir la memoria EEPROM
 
 #define CLK_X PB3 // Se define el pin PB3 como señal de reloj (CLK) para el eje X
 #define DIR_X PB4 // Se define el pin PB4 como señal de dirección (DIR) para el eje X
@@ -17,203 +21,670 @@
 #define LIMIT_YD PD3 // Se define el pin PD3 como entrada del final de carrera inferior del eje Y
 #define LED PD5 // Se define el pin PD5 como salida para el LED indicador
 
-#define FRECUENCIA 5000UL // Se define la frecuencia de pasos del motor en 5000 Hz
-#define PI 3.14159265 // Se define el valor de PI para usarlo en la función de CIRCULO();
+#define FRECUENCIA_INICIAL 5000UL // Se define la frecuencia de pulsos con la que arranca y termina cada movimiento (la anterior frecuencia fija de 5000 Hz)
+#define FRECUENCIA_MAXIMA 10000UL // Se define la frecuencia de pulsos de crucero en Hz
+#define ACELERACION 20000UL // Se define la aceleración en pulsos/s² (1875 pulsos de rampa entre 5 y 10 kHz)
+#define RAMPA_N 64 // Se define la cantidad de escalones de velocidad de la rampa
+#define Q8(x) ((uint16_t)((x) * 256 + 0.5)) // Se define una macro para escribir constantes en punto fijo Q8 (se evalúa al compilar)
 
-volatile uint16_t contador_X = 0; // Se declara la variable contador_X como volátil para contar los pasos del eje X
-volatile uint16_t limite_X = 0; // Se declara la variable limite_X como volátil para definir el límite de pasos en X
-volatile uint16_t contador_Y = 0; // Se declara la variable contador_Y como volátil para contar los pasos del eje Y
-volatile uint16_t limite_Y = 0; // Se declara la variable limite_Y como volátil para definir el límite de pasos en Y
+#define BAUD 38400 // Se define la velocidad de comunicación serial del intérprete de G-code
+#define MYUBRR (F_CPU / 16 / BAUD - 1) // Se calcula el valor del registro UBRR para la UART (25, error de 0,2 %)
+#define PASOS_POR_MM 40 // Se definen los pasos (flancos de CLK) por milímetro del eje X; se calibra midiendo un movimiento conocido
+#define FACTOR_Y Q8(0.91) // Se define la escala del eje Y respecto del X en Q8 (el motor del eje Y avanza más por paso)
+#define RECORRIDO_MAXIMO 1000 // Se define la coordenada máxima aceptada en mm (mantiene las cuentas en 32 bits)
+#define DIBUJAR_FIGURAS 1 // Se define en 1 para dibujar las figuras predefinidas antes de pasar al modo G-code
 
-const uint16_t OCR = (uint16_t)((F_CPU / (8UL * 2UL * FRECUENCIA)) - 1); // Se calcula el valor del registro OCR para obtener la frecuencia deseada en el Timer1
+#define RECTA_MAXIMA 32000 // Se define el largo máximo en pasos de cada tramo de una recta absoluta (PLOTTER_LINEA recibe int16_t)
+#define RETROCESO_ORIGEN 200 // Se definen los pasos que se aleja la pluma del final de carrera superior al terminar la búsqueda del origen
+#define BUSQUEDA_MAXIMA 64000L // Se define el recorrido máximo en Y buscando el final de carrera antes de desistir
+#define BUSCAR_ORIGEN 0 // Se define en 1 para buscar el origen con el final de carrera antes de dibujar (G28 lo busca en cualquier momento)
 
-// Función para inicializar el Timer1 en modo CTC
+#define CONTROL_DIRECCION 0x100 // Se define la dirección de la EEPROM donde empiezan los puntos de control de las figuras
+#define CONTROL_RANURAS 32 // Se define la cantidad de ranuras del registro circular de puntos de control (reparte el desgaste)
+#define CONTROL_MS 250 // Se define el tiempo mínimo en ms entre dos puntos de control guardados
+#define OFERTA_RETOMAR_MS 10000 // Se define el tiempo que se espera la respuesta para retomar una figura interrumpida
+
+#define COLA_N 16 // Se define la cantidad de segmentos de la cola de movimientos (potencia de 2)
+#define TIEMPO_BAJAR_MS 30 // Se define el tiempo de espera para que baje el solenoide (máximo 32 ms, un solo intervalo del Timer1)
+
+// Estado del segmento en curso. Solo lo usa la interrupción, salvo al arrancar o cortar la cola, y el programa siempre
+// lo toca con las interrupciones deshabilitadas (cli() y sei() son barreras para el compilador), así que no hace falta
+// declararlo volátil y la interrupción puede dejarlo en registros en lugar de releerlo de la RAM en cada acceso
+uint16_t restante = 0; // Pasos que faltan calcular del segmento en curso
+uint16_t limite = 0; // Pasos del segmento en curso
+uint16_t delta_menor = 0; // Pasos del eje menor de la recta
+int16_t error_linea = 0; // Error de Bresenham entre la recta ideal y los pasos dados por el eje menor
+uint8_t mayor_b, mayor_c; // Máscaras del CLK del eje mayor en los puertos B y C (una de las dos vale 0)
+uint8_t menor_b, menor_c; // Máscaras del CLK del eje menor en los puertos B y C
+int8_t signo_x, signo_y; // Sentido de la recta en curso en cada eje (+1 o -1)
+uint8_t paso_b, paso_c; // Máscaras de los CLK que conmuta la próxima interrupción (el paso ya calculado)
+
+// Posición absoluta de la máquina en pasos (flancos de CLK), con Y positivo hacia arriba. La interrupción no la cuenta
+// flanco a flanco sino que le suma el desplazamiento completo de cada segmento al terminarlo (dos sumas de 32 bits por
+// segmento en lugar de una por flanco); si el movimiento se corta a mitad de un segmento se le suma la parte que ya salió
+// por los pines, reconstruida a partir del estado de Bresenham o del arco. El programa lleva aparte la posición al final
+// de la cola, que es desde donde parten los movimientos que encola
+volatile int32_t maquina_x = 0, maquina_y = 0; // Posición de los motores al comenzar el segmento en curso (la actualiza la interrupción)
+int32_t plan_x = 0, plan_y = 0; // Posición al final de la cola (la actualiza el programa al encolar)
+int16_t pendiente_x = 0, pendiente_y = 0; // Desplazamiento del segmento en curso, que se suma a maquina_x/y al terminarlo
+volatile uint8_t final_carrera = 0; // Vale 1 desde que se acciona un final de carrera hasta que se llama a PLOTTER_RECUPERAR
+uint8_t referenciada = 0; // Vale 1 desde que PLOTTER_REFERENCIAR encuentra el final de carrera (la posición en Y es absoluta)
+
+// Generador de arcos por punto medio: el arco se recorre paso a paso sobre una circunferencia virtual de radio r
+// siguiendo el signo de F = x² + y² - r² (solo sumas enteras), y cada paso virtual en Y se escala por factor_y / 256
+// con un resto acumulado, de modo que sale una elipse sin trigonometría ni punto flotante. Como el arco cambia de
+// dirección a mitad del movimiento, cada paso del arco es un pulso completo de CLK (dos pasos de una recta).
+typedef struct {
+	int16_t x, y; // Posición virtual respecto del centro en pulsos
+	int32_t f; // x² + y² - r² en la posición actual
+	int16_t resto; // y·factor - Y·256, donde Y es la posición real redondeada
+	uint16_t factor; // Escala de Y en Q8 (256 = sin escala, máximo 256)
+	uint8_t antihorario; // 1 para recorrer el arco en sentido antihorario
+} Arco;
+
+#define ARCO_X 0x01 // Bandera de ARCO_AVANZAR: el eje X da un pulso
+#define ARCO_X_POSITIVO 0x02 // Bandera de ARCO_AVANZAR: el pulso en X es hacia la derecha
+#define ARCO_Y 0x04 // Bandera de ARCO_AVANZAR: el eje Y da un pulso
+#define ARCO_Y_POSITIVO 0x08 // Bandera de ARCO_AVANZAR: el pulso en Y es hacia arriba
+
+Arco arco; // Arco en curso (lo avanza la interrupción)
+int16_t arco_x0, arco_y0; // Inicio del arco en curso: X virtual e Y real en pulsos (para reconstruir la posición si se corta)
+
+// Cola de movimientos: las funciones PLOTTER_* no mueven los motores sino que agregan segmentos a un buffer circular
+// que la interrupción consume uno detrás de otro, sin detenerse entre ellos. El programa solo se bloquea si la cola
+// está llena (o al esperar explícitamente con PLOTTER_ESPERAR), así puede preparar el próximo segmento mientras se
+// ejecuta el actual. Subir o bajar el solenoide también es un segmento, para que ocurra en orden y con los motores quietos.
+// El tipo del segmento en curso se guarda en GPIOR0, un registro de uso general en el espacio de E/S bajo: cada tipo es
+// un bit, así la interrupción lo prueba con una sola instrucción (sbis/sbic) sin leer la RAM
+#define SEGMENTO_LINEA 0 // Recta por Bresenham
+#define SEGMENTO_ARCO 1 // Arco por punto medio (bit 0 de GPIOR0)
+#define SEGMENTO_SOLENOIDE 2 // Cambio del solenoide con espera (bit 1 de GPIOR0)
+
+typedef struct {
+	uint8_t tipo; // Tipo de segmento (SEGMENTO_*)
+	uint16_t n; // Pasos (recta) o pulsos (arco) del segmento
+	uint16_t maximo; // Velocidad admisible en la unión con el segmento anterior
+	uint16_t entrada; // Velocidad planificada al comenzar el segmento (la lee la interrupción como salida del anterior)
+	uint16_t tope; // Velocidad máxima del segmento según el avance pedido
+	int16_t fin_x, fin_y; // Desplazamiento total en flancos (la interrupción lo suma a la posición de los motores al terminar)
+	uint16_t movimiento; // Movimientos de la figura en curso hechos antes de este segmento (para los puntos de control)
+	union {
+		struct { int16_t dx, dy; } linea; // Desplazamiento de la recta en pasos
+		Arco arco; // Estado inicial del generador de arco
+		struct { uint8_t bajar; uint16_t espera; } solenoide; // Estado del solenoide y espera en ticks del Timer1
+	};
+} Segmento;
+
+Segmento cola[COLA_N]; // Buffer circular de segmentos
+volatile uint8_t cola_lectura = 0; // Próximo segmento a ejecutar (lo avanza la interrupción)
+volatile uint8_t cola_escritura = 0; // Próximo lugar libre (lo avanza el programa)
+uint16_t movimiento_figura = 0; // Movimiento de la figura con el que se marcan los segmentos que se encolan
+volatile uint16_t movimiento_actual = 0; // Marca del segmento en ejecución (la copia la interrupción al cargarlo)
+uint16_t espera_actual = 0; // Espera del segmento de solenoide en curso
+int16_t salida_x = 0, salida_y = 0; // Dirección de salida del último segmento encolado ((0, 0) si termina detenido)
+uint8_t pluma_abajo = 1; // Estado del solenoide al final de la cola (el pin arranca en bajo, con la pluma abajo)
+uint16_t tope_avance = 0xFFFF; // Velocidad máxima de los segmentos que se encolan (0xFFFF = sin límite de avance)
+
+// Perfil de velocidad: la velocidad se expresa como la distancia d, en flancos, que hace falta para alcanzarla
+// acelerando desde FRECUENCIA_INICIAL (v² = v0² + 2·a·d), y el intervalo entre flancos sale de una tabla indexada
+// por d calculada una sola vez en TIMER1_INICIAR. En cada paso d sube a lo sumo un flanco (aceleración) y nunca supera
+// la velocidad de entrada del segmento siguiente más los flancos que faltan (frenado a tiempo), así la interrupción
+// solo suma, compara, desplaza e indexa, sin divisiones. Cada "paso" es un flanco de CLK (dos por pulso del driver).
+// El desplazamiento del índice se calcula al compilar, así el compilador lo resuelve con instrucciones fijas en lugar
+// de un lazo de desplazamientos de un bit por paso
+#define RAMPA_FLANCOS ((FRECUENCIA_MAXIMA * FRECUENCIA_MAXIMA - FRECUENCIA_INICIAL * FRECUENCIA_INICIAL) / ACELERACION) // Flancos para llegar a la velocidad máxima ((v² - v0²) / (2·a) en flancos)
+#define RAMPA_CUBRE(k) (((uint32_t)RAMPA_N << (k)) >= RAMPA_FLANCOS) // La tabla cubre la rampa con escalones de 2^k flancos
+#define RAMPA_DESPLAZAMIENTO (RAMPA_CUBRE(0) ? 0 : RAMPA_CUBRE(1) ? 1 : RAMPA_CUBRE(2) ? 2 : RAMPA_CUBRE(3) ? 3 : RAMPA_CUBRE(4) ? 4 : \
+	RAMPA_CUBRE(5) ? 5 : RAMPA_CUBRE(6) ? 6 : RAMPA_CUBRE(7) ? 7 : RAMPA_CUBRE(8) ? 8 : RAMPA_CUBRE(9) ? 9 : 10) // Escalón mínimo (escalón = d >> RAMPA_DESPLAZAMIENTO)
+uint16_t rampa[RAMPA_N]; // Intervalo entre flancos en ticks de 0,5 µs para cada escalón de distancia
+uint16_t rampa_pasos = 0; // Distancia a partir de la cual se está en crucero
+uint16_t velocidad = 0; // Velocidad actual como distancia sobre la rampa
+uint32_t junta_k = 0; // v0² / (2·a) en flancos, para convertir la velocidad admisible en una esquina a distancia sobre la rampa
+uint16_t tope_actual = 0; // Velocidad máxima del segmento en curso (crucero o avance pedido)
+
+// Función que devuelve el intervalo hasta el próximo paso y actualiza la velocidad (se llama desde la interrupción).
+// 'flancos' vale 1 en las rectas y 2 en los arcos, donde cada interrupción es un pulso completo
+static inline uint16_t INTERVALO(uint8_t flancos){
+	uint16_t d = velocidad + flancos; // Se acelera como máximo un paso
+	if (restante < rampa_pasos){ // Solo cerca del final puede hacer falta frenar
+		uint16_t salida = (cola_lectura != cola_escritura) ? cola[cola_lectura].entrada : 0; // Velocidad con la que debe empezar el segmento siguiente
+		uint16_t tope = salida + restante * flancos; // Máxima velocidad desde la que todavía se llega a la de salida
+		if (d > tope) d = tope; // Se frena
+	}
+	if (d > tope_actual) d = tope_actual; // En crucero se mantiene la velocidad máxima del segmento
+	velocidad = d; // Se guarda la velocidad del paso
+	return rampa[d >> RAMPA_DESPLAZAMIENTO] * flancos; // Intervalo del escalón
+}
+
+// Función que devuelve la raíz cuadrada entera de x (método bit a bit, sin punto flotante)
+uint16_t RAIZ(uint32_t x){
+	uint32_t r = 0; // Resultado parcial
+	uint32_t bit = 1UL << 30; // Mayor potencia de 4 representable
+	while (bit > x) bit >>= 2; // Se busca la mayor potencia de 4 que no supere a x
+	while (bit){ // Se determina un bit del resultado por iteración
+		if (x >= r + bit){ x -= r + bit; r = (r >> 1) + bit; } // El bit pertenece a la raíz
+		else r >>= 1; // El bit no pertenece a la raíz
+		bit >>= 2; // Se pasa al siguiente par de bits
+	}
+	return (uint16_t)r; // Se devuelve la raíz
+}
+
+// Función para inicializar el Timer1 en modo normal (cada paso programa la próxima comparación A) y calcular la rampa
 void TIMER1_INICIAR(void){
+	uint32_t f0 = 2UL * FRECUENCIA_INICIAL; // Flancos por segundo al arrancar
+	uint32_t a = 2UL * ACELERACION; // Aceleración en flancos/s²
+	uint32_t d_rampa = RAMPA_FLANCOS; // Flancos necesarios para llegar a la velocidad máxima
+	for (uint8_t i = 0; i < RAMPA_N; i++){ // Se calcula la velocidad al comienzo de cada escalón: v² = v0² + 2·a·d
+		uint32_t v = RAIZ(f0 * f0 + 2UL * a * ((uint32_t)i << RAMPA_DESPLAZAMIENTO)); // Flancos por segundo (raíz entera, sin punto flotante)
+		if (v > 2UL * FRECUENCIA_MAXIMA) v = 2UL * FRECUENCIA_MAXIMA; // Se limita a la velocidad de crucero
+		rampa[i] = (uint16_t)(((F_CPU / 8UL) + v / 2) / v); // Intervalo redondeado en ticks del Timer1 (prescaler 8)
+	}
+	uint32_t crucero = (uint32_t)(RAMPA_N - 1) << RAMPA_DESPLAZAMIENTO; // Último escalón de la tabla
+	rampa_pasos = (crucero > d_rampa) ? (uint16_t)d_rampa : (uint16_t)crucero; // Distancia de crucero
+	junta_k = (f0 * f0) / (2UL * a); // Distancia sobre la rampa por unidad de (1 / m² - 1) en las esquinas
+
 	cli(); // Se deshabilitan las interrupciones globales
 	TCCR1A = 0; // Se limpia el registro TCCR1A
 	TCCR1B = 0; // Se limpia el registro TCCR1B
 	TCNT1 = 0; // Se inicializa el contador del Timer1 en 0
-	OCR1A = OCR; // Se carga el valor de comparación en OCR1A
-	OCR1B = OCR; // Se carga el mismo valor de comparación en OCR1B
 	TIFR1 |= (1<<OCF1A)|(1<<OCF1B); // Se limpian las banderas de interrupción de comparación A y B
-	TCCR1B = (1<<WGM12) | (1<<CS11); // Se configura el Timer1 en modo CTC con prescaler 8
+	TCCR1B = (1<<CS11); // Se configura el Timer1 en modo normal (cuenta libre) con prescaler 8
 	sei(); // Se habilitan las interrupciones globales
 }
 
-// Función para generar una cantidad determinada de pasos en el eje X
-void PASOS_X(uint16_t pasos){
-	contador_X = 0; // Se reinicia el contador de pasos en X
-	limite_X = pasos; // Se establece el número de pasos a realizar en X
-	DDRB |= (1 << CLK_X); // Se configura el pin CLK_X como salida
-	PORTB &= ~(1 << CLK_X); // Se inicia el pin CLK_X en bajo
-	TIMSK1 |= (1 << OCIE1B); // Se habilita la interrupción de comparación B del Timer1
+// Función para detener el movimiento cuando se vacía la cola (se llama desde las interrupciones). Se expande en el
+// lugar porque una llamada obligaría al compilador a guardar todos los registros en cada interrupción del Timer1
+static inline __attribute__((always_inline)) void DETENER(void){
+	TIMSK1 &= ~(1 << OCIE1A); // Se deshabilita la interrupción de comparación A
+	PORTB &= ~(1 << CLK_X); // Se pone en bajo el pin CLK_X para detener los pulsos
+	PORTC &= ~(1 << CLK_Y); // Se pone en bajo el pin CLK_Y para detener los pulsos
+	velocidad = 0; // El próximo movimiento arranca desde la velocidad inicial
+	maquina_x += pendiente_x; // El segmento en curso quedó hecho
+	maquina_y += pendiente_y; // Ídem en Y
+	pendiente_x = pendiente_y = 0; // Ya no queda desplazamiento pendiente
 }
 
-// Función para generar una cantidad determinada de pasos en el eje Y
-void PASOS_Y(uint16_t pasos){
-	contador_Y = 0; // Se reinicia el contador de pasos en Y
-	limite_Y = pasos; // Se establece el número de pasos a realizar en Y
-	DDRC |= (1 << CLK_Y); // Se configura el pin CLK_Y como salida
-	PORTC &= ~(1 << CLK_Y); // Se inicia el pin CLK_Y en bajo
-	TIMSK1 |= (1 << OCIE1A); // Se habilita la interrupción de comparación A del Timer1
+// Función que avanza un paso sobre el arco: el eje en el que la tangente es mayor avanza siempre y el otro solo si
+// así F queda más cerca de 0. Devuelve las banderas ARCO_* de los pulsos reales a generar
+static inline __attribute__((always_inline)) uint8_t ARCO_AVANZAR(Arco *a){
+	int8_t sx = (a->y > 0) ? -1 : (a->y < 0) ? 1 : 0; // Dirección de la tangente en X (antihoraria: -y)
+	int8_t sy = (a->x > 0) ? 1 : (a->x < 0) ? -1 : 0; // Dirección de la tangente en Y (antihoraria: x)
+	if (!a->antihorario){ sx = -sx; sy = -sy; } // En sentido horario la tangente se invierte
+	int16_t ax = (a->x < 0) ? -a->x : a->x; // |x|
+	int16_t ay = (a->y < 0) ? -a->y : a->y; // |y|
+	uint8_t p = 0; // Pulsos a generar
+	int8_t my = 0; // Paso virtual en Y
+
+	if (ay > ax){ // Cerca de los polos la tangente es casi horizontal: X es el eje mayor
+		int32_t f1 = a->f + 2 * (int32_t)sx * a->x + 1; // F si solo avanza X
+		int32_t f2 = f1 + 2 * (int32_t)sy * a->y + 1; // F si avanzan ambos
+		a->x += sx; // X avanza siempre
+		p = ARCO_X | ((sx > 0) ? ARCO_X_POSITIVO : 0); // Pulso en X
+		if (sy && (f2 < 0 ? -f2 : f2) < (f1 < 0 ? -f1 : f1)){ a->y += sy; a->f = f2; my = sy; } // Diagonal si queda más cerca del arco
+		else a->f = f1; // Solo X
+	} else { // Cerca del ecuador la tangente es casi vertical: Y es el eje mayor
+		int32_t f1 = a->f + 2 * (int32_t)sy * a->y + 1; // F si solo avanza Y
+		int32_t f2 = f1 + 2 * (int32_t)sx * a->x + 1; // F si avanzan ambos
+		a->y += sy; // Y avanza siempre
+		my = sy; // Paso virtual en Y
+		if (sx && (f2 < 0 ? -f2 : f2) < (f1 < 0 ? -f1 : f1)){ // Diagonal si queda más cerca del arco
+			a->x += sx; a->f = f2; // Avanza también X
+			p = ARCO_X | ((sx > 0) ? ARCO_X_POSITIVO : 0); // Pulso en X
+		} else a->f = f1; // Solo Y
+	}
+	if (my){ // El paso virtual en Y se escala por factor / 256
+		a->resto += my * (int16_t)a->factor; // Se acumula la posición virtual escalada
+		if (a->resto >= 128){ a->resto -= 256; p |= ARCO_Y | ARCO_Y_POSITIVO; } // La posición real redondeada sube un pulso
+		else if (a->resto < -128){ a->resto += 256; p |= ARCO_Y; } // La posición real redondeada baja un pulso
+	}
+	return p; // Banderas de los pulsos a generar
 }
 
-// Función para detener el movimiento del eje X
-void DETENER_X(void){
-	TIMSK1 &= ~(1 << OCIE1B); // Se deshabilita la interrupción de comparación B
-	PORTB &= ~(1 << CLK_X); // Se pone en bajo el pin CLK_X para detener los pulsos
+// Función que calcula el próximo pulso del arco y deja los pines DIR listos un intervalo antes de su flanco
+static inline __attribute__((always_inline)) void ARCO_PREPARAR(void){
+	uint8_t p = ARCO_AVANZAR(&arco); // Se avanza un paso sobre el arco
+	uint8_t b = 0, c = 0; // Se parte de un pulso sin ejes
+	if (p & ARCO_X){ // Si avanza X
+		if (p & ARCO_X_POSITIVO) PORTB |= (1 << DIR_X); else PORTB &= ~(1 << DIR_X); // Dirección en X
+		b = (1 << CLK_X); // Pulso en CLK_X
+	}
+	if (p & ARCO_Y){ // Si avanza Y
+		if (p & ARCO_Y_POSITIVO) PORTC &= ~(1 << DIR_Y); else PORTC |= (1 << DIR_Y); // Dirección en Y (en bajo hacia arriba)
+		c = (1 << CLK_Y); // Pulso en CLK_Y
+	}
+	paso_b = b; paso_c = c; // Lo genera la próxima interrupción
 }
 
-// Función para detener el movimiento del eje Y
-void DETENER_Y(void){
-	TIMSK1 &= ~(1 << OCIE1A); // Se deshabilita la interrupción de comparación A
-	PORTC &= ~(1 << CLK_Y); // Se pone en bajo el pin CLK_Y para detener los pulsos
+// Función que toma el próximo segmento de la cola y prepara su ejecución (se llama desde la interrupción)
+static inline __attribute__((always_inline)) void CARGAR_SEGMENTO(void){
+	Segmento *s = &cola[cola_lectura]; // Segmento a ejecutar
+	GPIOR0 = s->tipo; // Se guarda el tipo
+	movimiento_actual = s->movimiento; // Avance de la figura al comenzar el segmento
+	limite = restante = s->n; // Pasos del segmento
+	maquina_x += pendiente_x; // El segmento anterior quedó hecho
+	maquina_y += pendiente_y; // Ídem en Y
+	pendiente_x = s->fin_x; pendiente_y = s->fin_y; // Desplazamiento del nuevo
+	tope_actual = (s->tope < rampa_pasos) ? s->tope : rampa_pasos; // Velocidad de crucero del segmento
+	if (s->tipo == SEGMENTO_LINEA){ // Recta
+		int16_t dx = s->linea.dx, dy = s->linea.dy; // Desplazamiento
+		if (dx >= 0) PORTB |= (1 << DIR_X); // Se establece la dirección del eje X hacia la derecha
+		else PORTB &= ~(1 << DIR_X); // o hacia la izquierda
+		if (dy >= 0) PORTC &= ~(1 << DIR_Y); // Se establece la dirección del eje Y hacia arriba
+		else PORTC |= (1 << DIR_Y); // o hacia abajo
+		uint16_t ax = (dx < 0) ? -dx : dx; // Pasos del eje X
+		uint16_t ay = (dy < 0) ? -dy : dy; // Pasos del eje Y
+		if (ax) PORTB |= (1 << EN_X); // Se habilita el motor del eje X si se mueve
+		if (ay) PORTC |= (1 << EN_Y); // Se habilita el motor del eje Y si se mueve
+		signo_x = (dx >= 0) ? 1 : -1; signo_y = (dy >= 0) ? 1 : -1; // Sentido de cada eje
+		if (ax >= ay){ // El eje X es el mayor
+			delta_menor = ay; // Pasos del eje menor
+			mayor_b = (1 << CLK_X); mayor_c = 0; // El eje mayor está en el puerto B
+			menor_b = 0; menor_c = (1 << CLK_Y); // El eje menor está en el puerto C
+		} else { // El eje Y es el mayor
+			delta_menor = ax; // Pasos del eje menor
+			mayor_b = 0; mayor_c = (1 << CLK_Y); // El eje mayor está en el puerto C
+			menor_b = (1 << CLK_X); menor_c = 0; // El eje menor está en el puerto B
+		}
+		error_linea = limite / 2; // El error arranca en medio paso para repartir los pasos del eje menor simétricamente
+	} else if (s->tipo == SEGMENTO_ARCO){ // Arco
+		arco = s->arco; // Se copia el estado inicial del generador
+		arco_x0 = arco.x; // Inicio del arco
+		arco_y0 = (int16_t)(((int32_t)arco.y * arco.factor - arco.resto) >> 8); // Y real al inicio (el resto es exacto)
+		PORTB |= (1 << EN_X); // Se habilita el motor del eje X
+		PORTC |= (1 << EN_Y); // Se habilita el motor del eje Y
+		PORTB &= ~(1 << CLK_X); // Los pulsos del arco parten con CLK en bajo
+		PORTC &= ~(1 << CLK_Y); // (una recta anterior pudo terminar con un flanco de subida)
+	} else { // Solenoide
+		if (s->solenoide.bajar) PORTC &= ~(1 << SOLENOID); // Se desactiva el pin del solenoide para bajarlo
+		else PORTC |= (1 << SOLENOID); // Se activa el pin del solenoide para subirlo
+		espera_actual = s->solenoide.espera; // Tiempo que se espera antes del próximo segmento
+		velocidad = 0; // Los motores están detenidos
+	}
+	cola_lectura = (cola_lectura + 1) & (COLA_N - 1); // Se libera el lugar en la cola
 }
 
-// Interrupción del Timer1 para generar los pasos en el eje Y
+// Interrupción del Timer1 que ejecuta la cola de segmentos. Lo primero que hace es conmutar los CLK del paso que dejó
+// calculado la interrupción anterior, escribiendo un 1 en PINB y PINC (el AVR invierte así el bit de PORTx en una sola
+// instrucción, sin leer el puerto), de modo que el flanco sale siempre a la misma distancia de la comparación sin
+// importar el camino que siga después el código. Luego calcula el paso siguiente: en una recta el eje mayor avanza
+// siempre y el menor cuando el error de Bresenham se hace negativo; en un arco cada paso es un pulso completo, cuya
+// dirección queda fijada un intervalo antes y que baja al final de la interrupción en la que sube. Al terminar un
+// segmento se carga el siguiente sin detener los motores. La rutina no llama a ninguna función, así el compilador solo
+// guarda los registros que usa. No se declara ISR_NAKED porque el cuerpo en C necesita esos registros y SREG guardados.
+// Un flanco de recta lleva unos 190 ciclos con la entrada y la salida (estimado contando instrucciones, no medido), lo
+// que da un techo de unos 84.000 flancos/s (42 kHz de pulsos en el eje mayor) con la CPU dedicada a la interrupción
 ISR(TIMER1_COMPA_vect){
-	PORTC ^= (1 << CLK_Y); // Se conmuta el pin CLK_Y para generar el pulso del motor Y
-	if(++contador_Y >= limite_Y){ // Se incrementa el contador y se compara con el límite establecido
-		DETENER_Y(); // Si se alcanza el límite, se detiene el eje Y
+	PINB = paso_b; // Se conmutan los CLK del paso calculado (la máscara del otro puerto vale 0)
+	PINC = paso_c; // Ídem para el puerto C
+	uint8_t pulso = GPIOR0 & SEGMENTO_ARCO; // El paso que salió es un pulso completo de arco y hay que bajarlo
+	if (restante == 0){ // El paso que salió era el último del segmento
+		if (cola_lectura == cola_escritura){ // Si la cola está vacía
+			DETENER(); // Se detiene el movimiento (baja los CLK y la velocidad ya llegó a la inicial)
+			return; // No queda nada por ejecutar
+		}
+		CARGAR_SEGMENTO(); // Se pasa al segmento siguiente
 	}
+	restante--; // Se cuenta el paso que se calcula ahora
+
+	if (GPIOR0 & SEGMENTO_ARCO){ // Arco
+		ARCO_PREPARAR(); // Se calcula el pulso y se fijan las direcciones
+		OCR1A += INTERVALO(2); // Se programa el próximo pulso
+	} else if (GPIOR0 & SEGMENTO_SOLENOIDE){ // Solenoide
+		paso_b = paso_c = 0; // Sin pasos mientras se espera
+		OCR1A += espera_actual ? espera_actual : rampa[0]; // Se espera a que el solenoide termine de moverse
+	} else { // Recta
+		uint8_t b = mayor_b, c = mayor_c; // El eje mayor avanza siempre
+		error_linea -= delta_menor; // Se acumula el avance del eje menor
+		if (error_linea < 0){ // Si el eje menor se atrasó más de medio paso respecto de la recta ideal
+			error_linea += limite; // Se corrige el error
+			b |= menor_b; // Avanza también el eje menor
+			c |= menor_c; // Ídem si el eje menor está en el puerto C
+		}
+		paso_b = b; paso_c = c; // Lo genera la próxima interrupción
+		OCR1A += INTERVALO(1); // Se programa el próximo paso según el perfil de velocidad
+	}
+	if (pulso){ // Flanco de bajada del pulso del arco
+		PORTB &= ~(1 << CLK_X); // Se baja CLK_X
+		PORTC &= ~(1 << CLK_Y); // Se baja CLK_Y
+	}
+}
+
+// Función que devuelve la dirección (x, y) normalizada en Q12 por su componente mayor, de modo que el eje más rápido
+// vale ±4096 y las componentes son las velocidades de cada eje relativas a la del paso
+static void DIRECCION(int32_t x, int32_t y, int16_t *ux, int16_t *uy){
+	int32_t ax = (x < 0) ? -x : x; // |x|
+	int32_t ay = (y < 0) ? -y : y; // |y|
+	int32_t m = (ax > ay) ? ax : ay; // Componente mayor
+	if (m == 0){ *ux = 0; *uy = 0; return; } // Sin dirección
+	while (m > 0x3FFFFL){ x >>= 1; y >>= 1; m >>= 1; } // Se reduce la escala para que x·4096 entre en 32 bits
+	*ux = (int16_t)((x << 12) / m); // Componente en X
+	*uy = (int16_t)((y << 12) / m); // Componente en Y
 }
 
-// Interrupción del Timer1 para generar los pasos en el eje X
-ISR(TIMER1_COMPB_vect){
-	PORTB ^= (1 << CLK_X); // Se conmuta el pin CLK_X para generar el pulso del motor X
-	if(++contador_X >= limite_X){ // Se incrementa el contador y se compara con el límite establecido
-		DETENER_X(); // Si se alcanza el límite, se detiene el eje X
+// Función que devuelve la velocidad admisible (como distancia sobre la rampa) en la unión entre un segmento que sale
+// en la dirección u y otro que entra en la dirección w. En la esquina la velocidad de cada eje salta v·|u - w|, y ese
+// salto no debe superar FRECUENCIA_INICIAL, que es la velocidad a la que los motores arrancan y frenan sin rampa:
+// v = v0 / m con m = max|u - w|, y la distancia es d = v0² / (2·a) · (1 / m² - 1). Las rectas alineadas no frenan
+// y las esquinas de 90° o más se toman a la velocidad inicial
+static uint16_t JUNTA(int16_t ux, int16_t uy, int16_t wx, int16_t wy){
+	if (!(ux | uy) || !(wx | wy)) return 0; // Si alguno de los segmentos termina o empieza detenido
+	int16_t mx = ux - wx, my = uy - wy; // Salto de velocidad de cada eje (Q12)
+	if (mx < 0) mx = -mx; // Valor absoluto en X
+	if (my < 0) my = -my; // Valor absoluto en Y
+	uint16_t m = (mx > my) ? mx : my; // Salto del eje más exigido
+	if (m < 64) return rampa_pasos; // Prácticamente alineados: no hace falta frenar
+	uint32_t q = (1UL << 28) / ((uint32_t)m * m); // 16 / m² con m en Q12
+	if (q <= 16) return 0; // m >= 1: la esquina se toma a la velocidad inicial
+	uint32_t d = (junta_k * (q - 16)) >> 4; // d = k · (1 / m² - 1)
+	return (d > rampa_pasos) ? rampa_pasos : (uint16_t)d; // Como máximo la velocidad de crucero
+}
+
+// Función que convierte un avance en milésimas de mm por minuto en la velocidad máxima como distancia sobre la rampa
+// (d = (v² - v0²) / (2·a)). El avance se aplica al eje mayor, así que en una diagonal la pluma va hasta √2 veces más
+// rápido, y por debajo de FRECUENCIA_INICIAL se toma la velocidad inicial, que es la mínima a la que se mueven los motores
+static uint16_t AVANCE_A_TOPE(int32_t avance){
+	uint32_t f0 = 2UL * FRECUENCIA_INICIAL; // Flancos por segundo al arrancar
+	uint32_t v = 2UL * FRECUENCIA_MAXIMA; // Flancos por segundo pedidos, como máximo la velocidad de crucero
+	if (avance < (int32_t)(60000UL * 2UL * FRECUENCIA_MAXIMA / PASOS_POR_MM)) v = (uint32_t)avance * PASOS_POR_MM / 60000UL; // mm/min a flancos/s
+	if (v <= f0) return 0; // No se puede ir más lento que la velocidad inicial
+	uint32_t d = (v * v - f0 * f0) / (4UL * ACELERACION); // Distancia sobre la rampa (2·a en flancos/s²)
+	return (d > rampa_pasos) ? rampa_pasos : (uint16_t)d; // Como máximo la velocidad de crucero
+}
+
+// Función que recalcula las velocidades de entrada de los segmentos encolados, del último al primero, para que cada uno
+// pueda frenar hasta la entrada del siguiente y el último hasta detenerse. Agregar un segmento solo puede subir esas
+// velocidades, por lo que el recorrido termina en cuanto una no cambia. Se llama con las interrupciones deshabilitadas
+static void PLANIFICAR(void){
+	uint8_t i = cola_escritura; // Se empieza por el último segmento
+	uint32_t salida = 0; // El último segmento debe terminar detenido
+	while (i != cola_lectura){ // Se recorren los segmentos que todavía no empezaron
+		i = (i - 1) & (COLA_N - 1); // Segmento anterior
+		Segmento *s = &cola[i]; // Segmento a revisar
+		uint32_t e = 0; // Velocidad de entrada posible
+		if (s->tipo != SEGMENTO_SOLENOIDE) e = salida + (uint32_t)s->n * ((s->tipo == SEGMENTO_ARCO) ? 2 : 1); // Lo que permite frenar dentro del segmento
+		if (e > s->maximo) e = s->maximo; // Y lo que permite la unión con el anterior
+		if (e > s->tope) e = s->tope; // Y el avance pedido para el segmento
+		if (e == s->entrada) break; // Los anteriores no cambian
+		s->entrada = (uint16_t)e; // Se guarda la nueva entrada
+		salida = e; // Es la salida del segmento anterior
+	}
+}
+
+void CONTROL_REVISAR(void); // Escribe en la EEPROM el punto de control de la figura en curso cuando corresponde
+
+// Función que agrega un segmento a la cola. (ex, ey) y (sx, sy) son sus direcciones de entrada y salida en Q12.
+// Solo se bloquea si la cola está llena. Después de un final de carrera se descarta hasta llamar a PLOTTER_RECUPERAR
+static void ENCOLAR(const Segmento *s, int16_t ex, int16_t ey, int16_t sx, int16_t sy){
+	while (((cola_escritura + 1) & (COLA_N - 1)) == cola_lectura) CONTROL_REVISAR(); // Se espera un lugar libre (el final de carrera vacía la cola)
+	cli(); // El final de carrera no debe cortar la cola entre la verificación y la publicación
+	if (final_carrera){ sei(); return; } // Los motores quedan detenidos
+	Segmento *nuevo = &cola[cola_escritura]; // Lugar libre
+	*nuevo = *s; // Se copia el segmento
+	nuevo->maximo = JUNTA(salida_x, salida_y, ex, ey); // Velocidad admisible en la unión con el segmento anterior
+	nuevo->entrada = 0; // La planificación la sube
+	nuevo->tope = tope_avance; // Velocidad máxima según el avance vigente
+	nuevo->movimiento = movimiento_figura; // Avance de la figura al comenzar el segmento
+	salida_x = sx; salida_y = sy; // El próximo segmento se une a la salida de este
+
+	cola_escritura = (cola_escritura + 1) & (COLA_N - 1); // Se publica el segmento
+	PLANIFICAR(); // Se recalculan las velocidades de entrada
+	if (!(TIMSK1 & (1 << OCIE1A))){ // Si los motores estaban detenidos se arranca la cola
+		restante = 0; // La primera interrupción carga el segmento
+		paso_b = paso_c = 0; // y no genera ningún paso
+		velocidad = 0; // Se parte de la velocidad inicial
+		OCR1A = TCNT1 + rampa[0]; // Se programa la primera interrupción
+		TIFR1 = (1 << OCF1A); // Se limpia una bandera pendiente
+		TIMSK1 |= (1 << OCIE1A); // Se habilita la interrupción de comparación A del Timer1
+	}
+	sei(); // Se vuelven a habilitar las interrupciones
+}
+
+// Función que espera a que se ejecuten todos los segmentos de la cola
+void PLOTTER_ESPERAR(void){
+	while (TIMSK1 & (1 << OCIE1A)) CONTROL_REVISAR(); // La interrupción se deshabilita sola al vaciarse la cola
+}
+
+// Función para mover el plotter en línea recta dx pasos en X (positivo a la derecha) y dy pasos en Y (positivo hacia arriba)
+void PLOTTER_LINEA(int16_t dx, int16_t dy){
+	uint16_t ax = (dx < 0) ? -dx : dx; // Pasos del eje X
+	uint16_t ay = (dy < 0) ? -dy : dy; // Pasos del eje Y
+	if (ax == 0 && ay == 0) return; // Sin desplazamiento no hay movimiento
+
+	Segmento s; // Segmento a encolar
+	s.tipo = SEGMENTO_LINEA; // Recta
+	s.n = (ax >= ay) ? ax : ay; // Una interrupción por paso del eje mayor
+	s.linea.dx = dx; s.linea.dy = dy; // Desplazamiento
+	s.fin_x = dx; s.fin_y = dy; // Desplazamiento al terminar la recta
+	int16_t ux, uy; // Dirección de la recta
+	DIRECCION(dx, dy, &ux, &uy); // Dirección unitaria en Q12
+	ENCOLAR(&s, ux, uy, ux, uy); // Una recta entra y sale en la misma dirección
+	plan_x += dx; plan_y += dy; // Posición al final de la cola
+}
+
+// Función que redondea v·factor / 256 al entero más cercano (posición real de una coordenada virtual en Y)
+static int16_t ESCALAR_Y(int16_t v, uint16_t factor){
+	return (int16_t)(((int32_t)v * factor + 128) >> 8); // Suma de medio y desplazamiento
+}
+
+// Función para trazar un arco de elipse. (cx, cy) es el centro y (dx, dy) el punto final, ambos en pasos respecto de la
+// posición actual y antes de aplicar factor_y (Q8, 256 = circunferencia, máximo 256). El arco se genera pulso a pulso
+// dentro de la interrupción como un único segmento; si el punto final no cae exactamente sobre el arco rasterizado se
+// completa con una recta de pocos pasos. Un punto final igual al inicial traza la elipse completa
+void PLOTTER_ARCO(int16_t cx, int16_t cy, int16_t dx, int16_t dy, uint8_t antihorario, uint16_t factor_y){
+	int16_t x0 = -cx / 2, y0 = -cy / 2; // Inicio respecto del centro en pulsos
+	int16_t xe = (dx - cx) / 2, ye = (dy - cy) / 2; // Final respecto del centro en pulsos
+	int16_t xf = x0, yf = y0; // Punto del arco rasterizado más cercano al final
+
+	Segmento s; // Segmento a encolar
+	s.tipo = SEGMENTO_ARCO; // Arco
+	s.arco.x = x0; s.arco.y = y0; // Se parte del inicio
+	s.arco.f = 0; // El radio se toma del inicio, por lo que F arranca en 0
+	s.arco.factor = factor_y; // Escala de Y
+	s.arco.antihorario = antihorario; // Sentido de giro
+	s.arco.resto = (int16_t)((int32_t)y0 * factor_y - ((int32_t)ESCALAR_Y(y0, factor_y) << 8)); // Diferencia entre la posición escalada y la redondeada
+
+	uint16_t n = 0; // Cantidad de pulsos del arco
+	if (x0 || y0){ // Se recorre el arco sin mover los motores para conocer su largo exacto (hace falta para frenar a tiempo)
+		Arco prueba = s.arco; // Copia del generador
+		uint32_t maximo = 6UL * ((x0 < 0 ? -x0 : x0) + (y0 < 0 ? -y0 : y0)) + 8; // Una vuelta completa tiene menos de 4·√2·r pulsos
+		if (maximo > 65534) maximo = 65534; // Se limita al rango del contador
+		uint16_t mejor = 0xFFFF; // Menor distancia al final encontrada
+		for (uint16_t i = 1; i <= (uint16_t)maximo; i++){ // Se avanza pulso a pulso
+			ARCO_AVANZAR(&prueba); // Paso sobre el arco
+			int16_t ex = prueba.x - xe, ey = prueba.y - ye; // Distancia al final en cada eje
+			if (ex < 0) ex = -ex; // Valor absoluto en X
+			if (ey < 0) ey = -ey; // Valor absoluto en Y
+			uint16_t d = (ex > ey) ? ex : ey; // Distancia de Chebyshev
+			if (d < mejor){ mejor = d; n = i; xf = prueba.x; yf = prueba.y; } // Punto más cercano hasta ahora
+			if (d == 0) break; // Se alcanzó exactamente el final
+		}
+	}
+
+	if (n){ // Si el arco tiene pulsos se encola
+		s.n = n; // Cantidad de pulsos
+		s.fin_x = 2 * (xf - x0); // Desplazamiento del arco rasterizado (dos flancos por pulso)
+		s.fin_y = 2 * (ESCALAR_Y(yf, factor_y) - ESCALAR_Y(y0, factor_y)); // Ídem en Y ya escalado
+		int8_t sentido = antihorario ? 1 : -1; // La tangente antihoraria en (x, y) es (-y, x)
+		int16_t ex, ey, sx, sy; // Direcciones de entrada y salida
+		DIRECCION(-(int32_t)y0 * sentido * 256, (int32_t)x0 * sentido * factor_y, &ex, &ey); // Tangente al inicio con Y escalado
+		DIRECCION(-(int32_t)yf * sentido * 256, (int32_t)xf * sentido * factor_y, &sx, &sy); // Tangente al final
+		ENCOLAR(&s, ex, ey, sx, sy); // Se agrega el arco a la cola
+		plan_x += s.fin_x; // Posición al final del arco
+		plan_y += s.fin_y; // Ídem en Y
 	}
+
+	int16_t ux = dx - 2 * (xf - x0); // Diferencia en X entre el final pedido y el alcanzado, en pasos
+	int16_t uy = (ESCALAR_Y(dy - cy, factor_y) - ESCALAR_Y(-cy, factor_y)) - 2 * (ESCALAR_Y(yf, factor_y) - ESCALAR_Y(y0, factor_y)); // Ídem en Y ya escalado
+	PLOTTER_LINEA(ux, uy); // Se corrige el final (no hace nada si el arco terminó exactamente)
+}
+
+// Función que encola un cambio del solenoide (los motores se detienen antes y el cambio ocurre en orden)
+static void SOLENOIDE(uint8_t bajar, uint16_t espera_ms){
+	if (pluma_abajo == bajar) return; // Si ya está en ese estado no hace falta detenerse
+	pluma_abajo = bajar; // Estado al final de la cola
+	Segmento s; // Segmento a encolar
+	s.tipo = SEGMENTO_SOLENOIDE; // Solenoide
+	s.n = 1; // Una sola interrupción
+	s.fin_x = s.fin_y = 0; // Sin desplazamiento
+	s.solenoide.bajar = bajar; // Estado pedido
+	s.solenoide.espera = espera_ms * (F_CPU / 8000UL); // Espera en ticks de 0,5 µs
+	ENCOLAR(&s, 0, 0, 0, 0); // Sin dirección: los segmentos vecinos terminan y empiezan detenidos
 }
 
 // Función para bajar el solenoide
 void PLOTTER_BAJAR(){
-	PORTC &= ~(1 << SOLENOID); // Se desactiva el pin del solenoide para bajarlo
-	_delay_ms(30); // Se espera 30 ms para asegurar el movimiento
+	SOLENOIDE(1, TIEMPO_BAJAR_MS); // Se baja el solenoide y se espera para asegurar el movimiento
 }
 
 // Función para subir el solenoide
 void PLOTTER_SUBIR(){
-	PORTC |= (1 << SOLENOID); // Se activa el pin del solenoide para subirlo
+	SOLENOIDE(0, 0); // Se sube el solenoide
 }
 
-// Función para mover el plotter hacia la derecha
-void PLOTTER_DERECHA(uint16_t pasos){
-	PORTB |= (1 << DIR_X); // Se establece la dirección del eje X hacia la derecha
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PASOS_X(pasos); // Se generan los pasos en el eje X
-	while(TIMSK1 & (1<<OCIE1B)); // Se espera a que termine el movimiento
+// Funciones para mover el plotter en una dirección (con o sin bajar el solenoide) construidas sobre PLOTTER_LINEA
+void PLOTTER_DERECHA(uint16_t pasos){ PLOTTER_LINEA(pasos, 0); } // Se mueve el plotter hacia la derecha
+void PLOTTER_IZQUIERDA(uint16_t pasos){ PLOTTER_LINEA(-(int16_t)pasos, 0); } // Se mueve el plotter hacia la izquierda
+void PLOTTER_ABAJO(uint16_t pasos){ PLOTTER_LINEA(0, -(int16_t)pasos); } // Se mueve el plotter hacia abajo
+void PLOTTER_ARRIBA(uint16_t pasos){ PLOTTER_LINEA(0, pasos); } // Se mueve el plotter hacia arriba
+void PLOTTER_DERECHA_NO_BAJAR(uint16_t pasos){ PLOTTER_SUBIR(); PLOTTER_DERECHA(pasos); } // Se mueve hacia la derecha con el solenoide levantado
+void PLOTTER_IZQUIERDA_NO_BAJAR(uint16_t pasos){ PLOTTER_SUBIR(); PLOTTER_IZQUIERDA(pasos); } // Se mueve hacia la izquierda con el solenoide levantado
+void PLOTTER_ABAJO_NO_BAJAR(uint16_t pasos){ PLOTTER_SUBIR(); PLOTTER_ABAJO(pasos); } // Se mueve hacia abajo con el solenoide levantado
+void PLOTTER_ARRIBA_NO_BAJAR(uint16_t pasos){ PLOTTER_SUBIR(); PLOTTER_ARRIBA(pasos); } // Se mueve hacia arriba con el solenoide levantado
+void PLOTTER_ARRIBA_DERECHA(uint16_t pasos){ PLOTTER_LINEA(pasos, pasos); } // Se mueve en diagonal hacia arriba y a la derecha
+void PLOTTER_ARRIBA_IZQUIERDA(uint16_t pasos){ PLOTTER_LINEA(-(int16_t)pasos, pasos); } // Se mueve en diagonal hacia arriba y a la izquierda
+void PLOTTER_ABAJO_DERECHA(uint16_t pasos){ PLOTTER_LINEA(pasos, -(int16_t)pasos); } // Se mueve en diagonal hacia abajo y a la derecha
+void PLOTTER_ABAJO_IZQUIERDA(uint16_t pasos){ PLOTTER_LINEA(-(int16_t)pasos, -(int16_t)pasos); } // Se mueve en diagonal hacia abajo y a la izquierda
+
+// Función que traza una recta hasta el punto absoluto (x, y) en pasos desde el final de la cola, partida en tramos
+// alineados si no entra en int16_t (las uniones alineadas no frenan)
+void PLOTTER_LINEA_A(int32_t x, int32_t y){
+	int32_t dx = x - plan_x, dy = y - plan_y; // Desplazamiento total
+	int32_t ax = (dx < 0) ? -dx : dx, ay = (dy < 0) ? -dy : dy; // Largo de cada eje
+	int32_t x0 = plan_x, y0 = plan_y; // Inicio de la recta
+	uint8_t partes = ((ax > ay) ? ax : ay) / RECTA_MAXIMA + 1; // Tramos necesarios
+	for (uint8_t i = 1; i <= partes; i++) PLOTTER_LINEA(x0 + dx * i / partes - plan_x, y0 + dy * i / partes - plan_y); // Final de cada tramo
 }
 
-// Función para mover el plotter hacia la izquierda
-void PLOTTER_IZQUIERDA(uint16_t pasos){
-	PORTB &= ~(1 << DIR_X); // Se establece la dirección del eje X hacia la izquierda
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PASOS_X(pasos); // Se generan los pasos en el eje X
-	while(TIMSK1 & (1<<OCIE1B)); // Se espera a que termine el movimiento
+// Función que lleva la pluma al punto absoluto (x, y) en pasos con el solenoide levantado y a la velocidad máxima
+void MOVER_A(int32_t x, int32_t y){
+	if (x == plan_x && y == plan_y) return; // Si ya está en el punto no hace falta levantar el solenoide
+	uint16_t tope = tope_avance; // Se guarda el avance vigente
+	PLOTTER_SUBIR(); // Traslado sin dibujar
+	tope_avance = 0xFFFF; // Sin límite de avance
+	PLOTTER_LINEA_A(x, y); // Recta hasta el punto
+	tope_avance = tope; // Se restituye el avance
 }
 
-// Función para mover el plotter hacia abajo
-void PLOTTER_ABAJO(uint16_t pasos){
-	PORTC |=  (1 << DIR_Y); // Se establece la dirección del eje Y hacia abajo
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_Y(pasos); // Se generan los pasos en el eje Y
-	while(TIMSK1 & (1<<OCIE1A)); // Se espera a que termine el movimiento
+// Función que calcula en (x, y) la parte del segmento en curso que ya salió por los pines. En una recta los pasos del
+// eje mayor son los calculados y los del menor salen del error de Bresenham, que vale limite / 2 - k·delta_menor +
+// m·limite después de k pasos con m del eje menor; en un arco la X virtual y la Y real se leen del generador. En ambos
+// casos se descuenta el paso ya calculado que la interrupción todavía no generó. Solo se llama al cortar el movimiento
+// y al guardar un punto de control, así este cálculo no pesa en cada paso. Se llama con las interrupciones
+// deshabilitadas
+static void SEGMENTO_PARCIAL(int16_t *x, int16_t *y){
+	int16_t px = 0, py = 0; // Desplazamiento hecho
+	if (GPIOR0 & SEGMENTO_ARCO){ // Arco
+		px = 2 * (arco.x - arco_x0); // Dos flancos por pulso
+		py = 2 * ((int16_t)(((int32_t)arco.y * arco.factor - arco.resto) >> 8) - arco_y0); // Y real redondeada respecto del inicio
+		if (paso_b) px -= (PORTB & (1 << DIR_X)) ? 2 : -2; // El pulso calculado no salió (DIR_X en alto es hacia la derecha)
+		if (paso_c) py -= (PORTC & (1 << DIR_Y)) ? -2 : 2; // Ídem en Y (DIR_Y en bajo es hacia arriba)
+	} else if (!(GPIOR0 & SEGMENTO_SOLENOIDE) && limite){ // Recta
+		int32_t k = limite - restante; // Pasos calculados del eje mayor
+		int32_t m = ((int32_t)error_linea - limite / 2 + k * delta_menor) / limite; // Pasos calculados del eje menor (división exacta)
+		if (paso_b | paso_c){ // El paso calculado no salió
+			k--; // No cuenta en el eje mayor
+			if ((paso_b & menor_b) | (paso_c & menor_c)) m--; // Ni en el menor si también avanzaba
+		}
+		if (mayor_b){ px = k; py = m; } else { px = m; py = k; } // Según el eje mayor
+		if (signo_x < 0) px = -px; // Se aplica el signo de X
+		if (signo_y < 0) py = -py; // Se aplica el signo de Y
+	}
+	*x = px; *y = py; // Desplazamiento hecho
 }
 
-// Función para mover el plotter hacia arriba
-void PLOTTER_ARRIBA(uint16_t pasos){
-	PORTC &= ~(1 << DIR_Y); // Se establece la dirección del eje Y hacia arriba
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_Y(pasos); // Se generan los pasos en el eje Y
-	while(TIMSK1 & (1<<OCIE1A)); // Se espera a que termine el movimiento
+// Interrupción por cambio en los pines de los finales de carrera. Si alguno queda accionado (en bajo) se cortan los
+// pulsos y se descarta la cola en el acto. La posición de los motores sigue valiendo porque se le suma la parte del
+// segmento en curso que llegó a salir (salvo pasos perdidos si el corte fue a alta velocidad), así que con
+// PLOTTER_RECUPERAR se puede seguir con movimientos absolutos sin volver a buscar el origen
+ISR(PCINT2_vect){
+	if ((PIND & ((1 << LIMIT_YA) | (1 << LIMIT_YD))) == ((1 << LIMIT_YA) | (1 << LIMIT_YD))) return; // Se soltó un final de carrera
+	if (TIMSK1 & (1 << OCIE1A)) SEGMENTO_PARCIAL(&pendiente_x, &pendiente_y); // Si la cola estaba en marcha el segmento en curso queda a medias (DETENER suma lo hecho)
+	DETENER(); // Se cortan los pulsos y se actualiza la posición
+	cola_lectura = cola_escritura; // Se descartan los segmentos pendientes
+	restante = 0; // El segmento en curso queda terminado
+	final_carrera = 1; // Se avisa al programa
 }
 
-// Función para mover el plotter hacia la derecha sin bajar el solenoide
-void PLOTTER_DERECHA_NO_BAJAR(uint16_t pasos){
-	PLOTTER_SUBIR(); // Se asegura que el solenoide esté levantado
-	PORTB |= (1 << DIR_X); // Se establece la dirección hacia la derecha
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PASOS_X(pasos); // Se generan los pasos correspondientes
-	while(TIMSK1 & (1<<OCIE1B)); // Se espera hasta finalizar el movimiento
+// Función que deja la cola lista para seguir después de un final de carrera: la posición al final de la cola pasa a
+// ser la de los motores y el estado del solenoide el del pin
+void PLOTTER_RECUPERAR(void){
+	cli(); // La posición de los motores es de 32 bits y la modifica la interrupción
+	plan_x = maquina_x; plan_y = maquina_y; // Los segmentos descartados no se ejecutaron
+	salida_x = salida_y = 0; // La cola arranca detenida
+	pluma_abajo = !(PORTC & (1 << SOLENOID)); // El pin en alto levanta el solenoide
+	final_carrera = 0; // Se vuelve a aceptar segmentos
+	sei(); // Se habilitan las interrupciones
 }
 
-// Función para mover el plotter hacia la izquierda sin bajar el solenoide
-void PLOTTER_IZQUIERDA_NO_BAJAR(uint16_t pasos){
-	PLOTTER_SUBIR(); // Se asegura que el solenoide esté levantado
-	PORTB &= ~(1 << DIR_X); // Se establece la dirección hacia la izquierda
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PASOS_X(pasos); // Se generan los pasos correspondientes
-	while(TIMSK1 & (1<<OCIE1B)); // Se espera hasta finalizar el movimiento
+// Función que toma la posición actual de los motores como (x, y), con la cola detenida
+void PLOTTER_FIJAR(int32_t x, int32_t y){
+	PLOTTER_ESPERAR(); // Los motores deben estar quietos
+	cli(); // La posición de los motores es de 32 bits
+	maquina_x = x; maquina_y = y; // Nueva posición
+	sei(); // Se habilitan las interrupciones
+	PLOTTER_RECUPERAR(); // La cola sigue desde ahí
 }
 
-// Función para mover el plotter hacia abajo sin bajar el solenoide
-void PLOTTER_ABAJO_NO_BAJAR(uint16_t pasos){
-	PLOTTER_SUBIR(); // Se asegura que el solenoide esté levantado
-	PORTC |=  (1 << DIR_Y); // Se establece la dirección hacia abajo
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_Y(pasos); // Se generan los pasos correspondientes
-	while(TIMSK1 & (1<<OCIE1A)); // Se espera hasta finalizar el movimiento
+// Función para habilitar o deshabilitar la interrupción de los finales de carrera, descartando un cambio pendiente
+static void FINALES_HABILITAR(uint8_t habilitar){
+	PCIFR = (1 << PCIF2); // Se limpia la bandera de cambio
+	if (habilitar) PCICR |= (1 << PCIE2); // Se habilita la interrupción del puerto D
+	else PCICR &= ~(1 << PCIE2); // o se deshabilita
 }
 
-// Función para mover el plotter hacia arriba sin bajar el solenoide
-void PLOTTER_ARRIBA_NO_BAJAR(uint16_t pasos){
-	PLOTTER_SUBIR(); // Se asegura que el solenoide esté levantado
-	PORTC &= ~(1 << DIR_Y); // Se establece la dirección hacia arriba
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_Y(pasos); // Se generan los pasos correspondientes
-	while(TIMSK1 & (1<<OCIE1A)); // Se espera hasta finalizar el movimiento
-}
-
-// Función para mover el plotter en diagonal hacia arriba y a la derecha
-void PLOTTER_ARRIBA_DERECHA(uint16_t pasos){
-	PORTB |= (1 << DIR_X); // Se establece la dirección X hacia la derecha
-	PORTC &= ~(1 << DIR_Y); // Se establece la dirección Y hacia arriba
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_X(pasos); // Se generan pasos simultáneos en el eje X
-	PASOS_Y(pasos); // Se generan pasos simultáneos en el eje Y
-	while((TIMSK1 & ((1<<OCIE1A)|(1<<OCIE1B)))); // Se espera a que ambos movimientos finalicen
-}
-
-// Función para mover el plotter en diagonal hacia arriba y a la izquierda
-void PLOTTER_ARRIBA_IZQUIERDA(uint16_t pasos){
-	PORTB &= ~(1 << DIR_X); // Se establece la dirección X hacia la izquierda
-	PORTC &= ~(1 << DIR_Y); // Se establece la dirección Y hacia arriba
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_X(pasos); // Se generan pasos simultáneos en el eje X
-	PASOS_Y(pasos); // Se generan pasos simultáneos en el eje Y
-	while((TIMSK1 & ((1<<OCIE1A)|(1<<OCIE1B)))); // Se espera a que ambos movimientos finalicen
-}
-
-// Función para mover el plotter en diagonal hacia abajo y a la derecha
-void PLOTTER_ABAJO_DERECHA(uint16_t pasos){
-	PORTB |= (1 << DIR_X); // Se establece la dirección X hacia la derecha
-	PORTC |=  (1 << DIR_Y); // Se establece la dirección Y hacia abajo
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_X(pasos); // Se generan pasos simultáneos en el eje X
-	PASOS_Y(pasos); // Se generan pasos simultáneos en el eje Y
-	while((TIMSK1 & ((1<<OCIE1A)|(1<<OCIE1B)))); // Se espera a que ambos movimientos finalicen
-}
-
-// Función para mover el plotter en diagonal hacia abajo y a la izquierda
-void PLOTTER_ABAJO_IZQUIERDA(uint16_t pasos){
-	PORTB &= ~(1 << DIR_X); // Se establece la dirección X hacia la izquierda
-	PORTC |=  (1 << DIR_Y); // Se establece la dirección Y hacia abajo
-	PORTB |=  (1 << EN_X); // Se habilita el motor del eje X
-	PORTC |=  (1 << EN_Y); // Se habilita el motor del eje Y
-	PASOS_X(pasos); // Se generan pasos simultáneos en el eje X
-	PASOS_Y(pasos); // Se generan pasos simultáneos en el eje Y
-	while((TIMSK1 & ((1<<OCIE1A)|(1<<OCIE1B)))); // Se espera a que ambos movimientos finalicen
+// Función que busca el origen de la máquina. El eje Y sube a la velocidad inicial (desde la que los motores se detienen
+// sin rampa ni pasos perdidos) hasta accionar el final de carrera superior, ese punto pasa a ser Y = 0 y la pluma baja
+// RETROCESO_ORIGEN pasos con la interrupción deshabilitada para que el rebote al soltarlo no corte el movimiento. El eje
+// X no tiene final de carrera, así que su origen es la posición en la que está. Devuelve 0 si no se encontró el final
+// de carrera
+uint8_t PLOTTER_REFERENCIAR(void){
+	uint16_t tope = tope_avance; // Se guarda el avance vigente
+	PLOTTER_SUBIR(); // Se levanta el solenoide
+	PLOTTER_ESPERAR(); // Se termina lo que haya en la cola
+	PLOTTER_RECUPERAR(); // Por si se venía de un final de carrera
+	tope_avance = 0; // Se busca a la velocidad inicial
+	if (!(PIND & (1 << LIMIT_YA))){ // Si ya está accionado primero se aleja
+		FINALES_HABILITAR(0); // Se deshabilita para que no corte el alejamiento
+		PLOTTER_LINEA(0, -RETROCESO_ORIGEN); // Se baja la pluma para soltarlo
+		PLOTTER_ESPERAR(); // Se espera a que termine
+	}
+	uint8_t encontrado = 0; // Resultado de la búsqueda
+	if (PIND & (1 << LIMIT_YA)){ // Solo se busca si el final de carrera está suelto (si no nunca habría un cambio)
+		FINALES_HABILITAR(1); // El final de carrera corta la búsqueda
+		for (int32_t recorrido = 0; !final_carrera && recorrido < BUSQUEDA_MAXIMA; recorrido += RECTA_MAXIMA) PLOTTER_LINEA(0, RECTA_MAXIMA); // Se sube hasta el final de carrera
+		PLOTTER_ESPERAR(); // Se espera el corte o el fin de la búsqueda
+		encontrado = final_carrera && !(PIND & (1 << LIMIT_YA)); // Debe haber cortado el final de carrera superior
+	}
+	if (encontrado){ // Se llegó al final de carrera superior
+		cli(); // La posición la modifica la interrupción
+		maquina_x = 0; maquina_y = 0; // Se toma el punto como origen
+		sei(); // Se habilitan las interrupciones
+		referenciada = 1; // El eje Y queda referido al final de carrera
+		PLOTTER_RECUPERAR(); // Se sigue desde el origen
+		FINALES_HABILITAR(0); // Se ignora el rebote al soltarlo
+		PLOTTER_LINEA(0, -RETROCESO_ORIGEN); // Se aleja la pluma del final de carrera
+		PLOTTER_ESPERAR(); // Se espera a que termine
+	} else PLOTTER_RECUPERAR(); // Si no se encontró se sigue desde donde quedó
+	FINALES_HABILITAR(1); // Los finales de carrera vuelven a proteger el recorrido
+	tope_avance = tope; // Se restituye el avance
+	return encontrado; // 1 si se encontró el origen
 }
 
 void TRIANGULO(void){ // Función para dibujar un triángulo
 	PLOTTER_BAJAR(); // Se baja la solenoide para comenzar a dibujar
-	PLOTTER_DERECHA(3000); // Se mueve el plotter hacia la derecha una distancia de 3000 pasos
-	PLOTTER_ABAJO_IZQUIERDA(1500); // Se mueve el plotter en diagonal hacia abajo e izquierda una distancia de 1500 pasos
-	PLOTTER_ARRIBA_IZQUIERDA(1500); // Se mueve el plotter en diagonal hacia arriba e izquierda una distancia de 1500 pasos
+	PLOTTER_LINEA(3000, 0); // Se traza la base hacia la derecha una distancia de 3000 pasos
+	PLOTTER_LINEA(-1500, -1500); // Se traza el lado hacia abajo e izquierda hasta el vértice inferior
+	PLOTTER_LINEA(-1500, 1500); // Se traza el lado hacia arriba e izquierda de vuelta al inicio
 }
 
 void CRUZ(void){ // Función para dibujar una cruz
@@ -224,243 +695,677 @@ void CRUZ(void){ // Función para dibujar una cruz
 	PLOTTER_ARRIBA_DERECHA(2000); // Se mueve el plotter en diagonal hacia arriba y a la derecha una distancia de 2000 pasos
 }
 
-void CIRCULO(uint16_t radio, float factor_y){ // Función para dibujar un círculo elíptico según el radio y un factor y, ya que el motor PaP del eje Y va mas rapido que el del eje X
-	float x_anterior = radio * cos(0); // Se calcula la coordenada X inicial usando coseno
-	float y_anterior = radio * sin(0) * factor_y; // Se calcula la coordenada Y inicial aplicando el factor de escala
-
-	PLOTTER_DERECHA_NO_BAJAR((uint16_t)x_anterior); // Se mueve el plotter a la posición inicial en X sin bajar la solenoide
-	PLOTTER_ABAJO_NO_BAJAR((uint16_t)(-y_anterior)); // Se mueve el plotter a la posición inicial en Y sin bajar la solenoide
+void CIRCULO(uint16_t radio, uint16_t factor_y){ // Función para dibujar un círculo elíptico según el radio y un factor y en Q8, ya que el motor PaP del eje Y va mas rapido que el del eje X
+	PLOTTER_SUBIR(); // Se asegura que el solenoide esté levantado
+	PLOTTER_LINEA(radio, 0); // Se mueve el plotter al punto de 0° sin bajar la solenoide
 
 	PLOTTER_BAJAR(); // Se baja la solenoide para comenzar a dibujar el círculo
 
-	for (float angulo = 1.0; angulo <= 360.0; angulo += 1.0){ // Se recorre el círculo completo en incrementos de 1 grado
-		float rad = angulo * (PI / 180.0); // Se convierte el ángulo a radianes
-		float x = radio * cos(rad); // Se calcula la nueva coordenada X
-		float y = radio * sin(rad) * factor_y; // Se calcula la nueva coordenada Y aplicando el factor de escala
+	PLOTTER_ARCO(-(int16_t)radio, 0, 0, 0, 1, factor_y); // Se traza la elipse completa en sentido antihorario como un único movimiento
 
-		int16_t dx = (int16_t)roundf(x - x_anterior); // Se calcula el desplazamiento en X respecto al punto anterior
-		int16_t dy = (int16_t)roundf(y - y_anterior); // Se calcula el desplazamiento en Y respecto al punto anterior
+	PLOTTER_SUBIR(); // Se levanta la solenoide al finalizar el dibujo del círculo
+}
+
+// Formato empaquetado de las figuras (lo genera CONVERTIR_FIGURA.py): un número variable con la unidad de los movimientos
+// y luego un byte por movimiento con la dirección en los bits 7-6 (D, I, U, A), la pluma en el bit 5 (1 = mayúscula) y
+// la cuenta de unidades en los bits 4-0. La cuenta 31 continúa como número variable y la cuenta 0 indica un comando:
+// 'B' (0x00) o 'S' (0x40) seguidos de su tiempo, o el fin de la figura (0xC0). Los números variables van de a 7 bits
+// con el bit 7 en 1 si sigue otro byte. Así cada movimiento ocupa casi siempre un byte en lugar de tres
+#define FIGURA_SUBIR 0x40 // Se define el byte del comando 'S' (el de 'B' es 0x00)
+#define FIGURA_FIN 0xC0 // Se define el byte que termina una figura
 
-		if (dx > 0) PLOTTER_DERECHA(dx); // Si el desplazamiento es positivo, se mueve hacia la derecha
-		else if (dx < 0) PLOTTER_IZQUIERDA(-dx); // Si es negativo, se mueve hacia la izquierda
+#define Q12(x) ((int16_t)((x) * 4096 + ((x) < 0 ? -0.5 : 0.5))) // Se define una macro para escribir coeficientes con signo en punto fijo Q4.12 (se evalúa al compilar)
+#define ESCALA_FIGURAS Q12(0.3) // Se define un factor de escala de 0.3 para ajustar la magnitud de los movimientos adaptados del problema del plotter anterior
+#define TOLERANCIA_TRAZO 30 // Distancia máxima (en pasos) entre una cuerda y los vértices que reemplaza; 0 deshabilita la unión de movimientos
+#define TRAZO_VERTICES 16 // Cantidad máxima de vértices intermedios que puede reemplazar una cuerda
+#define TRAZO_MAXIMO 16000 // Largo máximo de una cuerda en cada eje para que entre en int16_t
 
-		if (dy > 0) PLOTTER_ARRIBA(dy); // Si el desplazamiento en Y es positivo, se mueve hacia arriba
-		else if (dy < 0) PLOTTER_ABAJO(-dy); // Si es negativo, se mueve hacia abajo
+int16_t trazo_x, trazo_y; // Extremo de la cuerda acumulada respecto de su punto de inicio
+int16_t vertice_x[TRAZO_VERTICES], vertice_y[TRAZO_VERTICES]; // Vértices intermedios que la cuerda reemplaza
+uint8_t n_vertices; // Cantidad de vértices intermedios guardados
+uint8_t trazo_activo; // Indica que hay una cuerda pendiente de trazar
+uint8_t trazo_libre; // Indica que la cuerda pendiente es un traslado con el solenoide levantado
+uint16_t trazo_movimiento; // Movimiento de la figura donde empieza la cuerda pendiente
 
-		x_anterior = x; // Se actualiza la coordenada anterior en X
-		y_anterior = y; // Se actualiza la coordenada anterior en Y
+// Función que verifica si la cuerda hasta (x, y) pasa a menos de TOLERANCIA_TRAZO de todos los vértices guardados y los recorre en orden
+uint8_t TRAZO_ADMITE(int32_t x, int32_t y){
+	int32_t largo2 = x * x + y * y; // Cuadrado del largo de la cuerda
+	if (largo2 == 0) return 0; // Una cuerda que vuelve al inicio no puede reemplazar a ningún recorrido
+	int32_t tolerancia = (int32_t)TOLERANCIA_TRAZO * RAIZ(largo2); // La distancia a la recta es |cruz| / largo, así se evita dividir
+	for (uint8_t i = 0; i <= n_vertices; i++){ // Se recorren los vértices guardados más el nuevo
+		int32_t punto = (int32_t)vertice_x[i] * x + (int32_t)vertice_y[i] * y; // Proyección del vértice sobre la cuerda
+		if (punto < 0 || punto > largo2) return 0; // El vértice debe caer entre los extremos de la cuerda
+		int32_t cruz = (int32_t)vertice_x[i] * y - (int32_t)vertice_y[i] * x; // Distancia del vértice a la recta por el largo
+		if (cruz < 0) cruz = -cruz; // Se toma el valor absoluto
+		if (cruz > tolerancia) return 0; // El vértice queda demasiado lejos de la cuerda
 	}
+	return 1; // Todos los vértices quedan cerca de la cuerda
+}
 
-	PLOTTER_SUBIR(); // Se levanta la solenoide al finalizar el dibujo del círculo
+// Función que traza la cuerda pendiente como una sola recta
+void TRAZO_VACIAR(void){
+	if (!trazo_activo) return; // Si no hay cuerda pendiente no se hace nada
+	uint16_t movimiento = movimiento_figura; // Los segmentos de la cuerda se marcan con el movimiento donde empezó
+	movimiento_figura = trazo_movimiento; // Los segmentos de la cuerda llevan la marca de su comienzo
+	if (trazo_libre) PLOTTER_SUBIR(); // Un traslado se hace con el solenoide levantado
+	PLOTTER_LINEA(trazo_x, trazo_y); // Se traza la cuerda
+	movimiento_figura = movimiento; // Se restituye la marca
+	trazo_x = trazo_y = 0; // La próxima cuerda arranca en la posición actual
+	n_vertices = 0; // Sin vértices intermedios
+	trazo_activo = 0; // No queda cuerda pendiente
 }
 
-typedef struct { // Se define una estructura para representar un paso de dibujo
-	char dir; // Se almacena la dirección del movimiento ('D', 'I', 'A', 'U', etc.)
-	uint16_t t; // Se almacena la cantidad de pasos o tiempo asociado al movimiento
-} Paso;
-
-#define ESCALA 0.3 // Se define un factor de escala para ajustar la magnitud de los movimientos adaptados del problema del plotter anterior
-
-void EJECUTAR_FIGURA(const Paso *figura, uint16_t n_pasos){ // Función para ejecutar una figura compuesta por varios pasos
-	for (uint16_t i = 0; i < n_pasos; i++){ // Se recorre la cantidad total de pasos definidos
-		char dir = pgm_read_byte(&figura[i].dir); // Se lee la dirección del paso desde la memoria de programa
-		uint16_t pasos_original = pgm_read_word(&figura[i].t); // Se lee la cantidad original de pasos desde la memoria de programa
-		uint16_t pasos = (uint16_t)(pasos_original * ESCALA); // Se aplica la escala definida a la cantidad de pasos
-
-		switch(dir){ // Se evalúa la dirección del paso para ejecutar el movimiento correspondiente
-			case 'D': PLOTTER_DERECHA(pasos); break; // Se mueve el plotter hacia la derecha
-			case 'I': PLOTTER_IZQUIERDA(pasos); break; // Se mueve el plotter hacia la izquierda
-			case 'A': PLOTTER_ABAJO(pasos); break; // Se mueve el plotter hacia abajo
-			case 'U': PLOTTER_ARRIBA(pasos); break; // Se mueve el plotter hacia arriba
-			case 'B': PLOTTER_BAJAR(); break; // Se baja la solenoide
-			case 'S': PLOTTER_SUBIR(); break; // Se levanta la solenoide
-			case 'd': PLOTTER_DERECHA_NO_BAJAR(pasos); break; // Se mueve hacia la derecha sin bajar la solenoide
-			case 'i': PLOTTER_IZQUIERDA_NO_BAJAR(pasos); break; // Se mueve hacia la izquierda sin bajar la solenoide
-			case 'a': PLOTTER_ABAJO_NO_BAJAR(pasos); break; // Se mueve hacia abajo sin bajar la solenoide
-			case 'u': PLOTTER_ARRIBA_NO_BAJAR(pasos); break; // Se mueve hacia arriba sin bajar la solenoide
-			default: break; // Si la dirección no coincide con ninguna opción válida, no se realiza acción
+// Función que agrega un movimiento a la cuerda pendiente o, si se aparta demasiado de ella, traza la cuerda y empieza otra
+void TRAZO_AGREGAR(int16_t dx, int16_t dy, uint8_t libre){
+	if (trazo_activo){ // Si ya hay una cuerda pendiente
+		int32_t x = (int32_t)trazo_x + dx; // Extremo de la cuerda extendida en X
+		int32_t y = (int32_t)trazo_y + dy; // Extremo de la cuerda extendida en Y
+		uint8_t unir = (libre == trazo_libre) && x <= TRAZO_MAXIMO && x >= -TRAZO_MAXIMO && y <= TRAZO_MAXIMO && y >= -TRAZO_MAXIMO; // Mismo tipo de movimiento y dentro del rango
+		if (unir && !libre){ // Un traslado se une siempre; un trazo solo si la cuerda sigue al dibujo
+			unir = (TOLERANCIA_TRAZO > 0) && (n_vertices < TRAZO_VERTICES); // Debe quedar lugar para el vértice actual
+			if (unir){ // Hay lugar para el vértice
+				vertice_x[n_vertices] = trazo_x; // El extremo actual pasa a ser un vértice intermedio
+				vertice_y[n_vertices] = trazo_y; // Ídem en Y
+				unir = TRAZO_ADMITE(x, y); // Se verifica la desviación de todos los vértices
+				if (unir) n_vertices++; // Se conserva el vértice
+			}
 		}
+		if (!unir) TRAZO_VACIAR(); // Si no se puede unir se traza la cuerda pendiente
 	}
+	if (!trazo_activo) trazo_movimiento = movimiento_figura; // Una cuerda nueva empieza en el movimiento actual
+	trazo_x += dx; // Se extiende la cuerda (o se empieza una nueva) con el movimiento
+	trazo_y += dy; // Ídem en Y
+	trazo_libre = libre; // Se guarda el tipo de movimiento
+	trazo_activo = 1; // Hay una cuerda pendiente
+}
+
+// Función que lee un número de longitud variable desde la memoria de programa y avanza el puntero
+uint16_t LEER_VARIABLE(const uint8_t **p){
+	uint16_t valor = 0; // Valor leído
+	uint8_t desplazamiento = 0; // Posición de los próximos 7 bits
+	uint8_t byte; // Byte actual
+	do { // Se leen bytes de 7 bits
+		byte = pgm_read_byte((*p)++); // Se lee el byte y se avanza
+		valor |= (uint16_t)(byte & 0x7F) << desplazamiento; // Se agregan sus 7 bits
+		desplazamiento += 7; // Los siguientes van más arriba
+	} while (byte & 0x80); // Mientras el bit 7 indique que sigue otro byte
+	return valor; // Valor completo
+}
+
+// Transformación afín que se aplica a las figuras entre su lectura y el trazado. Un punto (x, y) de la figura, en sus
+// unidades, pasa a pasos como (a·x + b·y + tx, c·x + d·y + ty). Los coeficientes están en Q4.12 (de -8 a 8 con
+// resolución 1/4096) para que cada producto sea int16_t × int32_t y entre en 32 bits sin punto flotante: con
+// coordenadas de la figura de hasta ±32767 y coeficientes de hasta ±4 la suma de dos productos no desborda
+typedef struct {
+	int16_t a, b; // Primera fila de la matriz en Q4.12
+	int16_t c, d; // Segunda fila de la matriz en Q4.12
+	int16_t tx, ty; // Traslación en pasos
+} Transformacion;
+
+Transformacion transformacion = {ESCALA_FIGURAS, 0, 0, ESCALA_FIGURAS, 0, 0}; // Transformación de las figuras, por defecto la escala de 0.3
+
+// Función para dejar la transformación de las figuras en la identidad (un paso por unidad de la figura)
+void TRANSFORMACION_IDENTIDAD(void){
+	transformacion.a = transformacion.d = Q12(1); // Escala unitaria
+	transformacion.b = transformacion.c = 0; // Sin rotación
+	transformacion.tx = transformacion.ty = 0; // Sin traslación
+}
+
+// Función para componer una transformación a continuación de la actual: primero se aplica la actual y después la
+// matriz [a b tx; c d ty]. Se usa fuera del trazado, así que el costo de los productos no importa
+void TRANSFORMACION_COMPONER(int16_t a, int16_t b, int16_t c, int16_t d, int16_t tx, int16_t ty){
+	Transformacion t = transformacion; // Copia de la transformación actual
+	transformacion.a = (int16_t)(((int32_t)a * t.a + (int32_t)b * t.c + 2048) >> 12); // Producto de las matrices redondeado
+	transformacion.b = (int16_t)(((int32_t)a * t.b + (int32_t)b * t.d + 2048) >> 12); // Ídem para b
+	transformacion.c = (int16_t)(((int32_t)c * t.a + (int32_t)d * t.c + 2048) >> 12); // Ídem para c
+	transformacion.d = (int16_t)(((int32_t)c * t.b + (int32_t)d * t.d + 2048) >> 12); // Ídem para d
+	transformacion.tx = (int16_t)((((int32_t)a * t.tx + (int32_t)b * t.ty + 2048) >> 12) + tx); // Se transforma la traslación anterior y se suma la nueva
+	transformacion.ty = (int16_t)((((int32_t)c * t.tx + (int32_t)d * t.ty + 2048) >> 12) + ty); // Ídem para ty
+}
+
+#define TRANSFORMACION_ESCALAR(sx, sy) TRANSFORMACION_COMPONER((sx), 0, 0, (sy), 0, 0) // Escala cada eje (en Q4.12)
+#define TRANSFORMACION_ROTAR(coseno, seno) TRANSFORMACION_COMPONER((coseno), -(seno), (seno), (coseno), 0, 0) // Rota en sentido antihorario (coseno y seno en Q4.12, por ejemplo Q12(0.866) y Q12(0.5) para 30°)
+#define TRANSFORMACION_ESPEJAR_X() TRANSFORMACION_COMPONER(-Q12(1), 0, 0, Q12(1), 0, 0) // Refleja la figura de izquierda a derecha
+#define TRANSFORMACION_ESPEJAR_Y() TRANSFORMACION_COMPONER(Q12(1), 0, 0, -Q12(1), 0, 0) // Refleja la figura de arriba a abajo
+#define TRANSFORMACION_TRASLADAR(dx, dy) TRANSFORMACION_COMPONER(Q12(1), 0, 0, Q12(1), (dx), (dy)) // Desplaza la figura (en pasos)
+
+// Función que aplica la transformación a un punto de la figura y devuelve la coordenada en pasos. Se transforma siempre
+// la posición absoluta dentro de la figura y no cada movimiento, así el redondeo no se acumula: el error queda en menos
+// de medio paso en cualquier punto del recorrido, por largo que sea
+static int16_t TRANSFORMAR(int16_t m1, int16_t m2, int16_t t, int32_t x, int32_t y){
+	return (int16_t)(((m1 * x + m2 * y + 2048) >> 12) + t); // Dos productos de 16 × 32 bits y un redondeo por desplazamiento
 }
 
-// Definición de la figura zorro a través de una estructura de pasos
-const Paso ZORRO[] PROGMEM = {
-	{'i', 3000}, {'a', 3000}, {'B'}, {'D', 3900}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'A', 300}, {'I', 100}, {'A', 600}, {'I', 100}, {'A', 500}, {'I', 100}, {'A', 600},
-	{'I', 100}, {'A', 500}, {'I', 100}, {'A', 600}, {'I', 100}, {'A', 500}, {'I', 100}, {'A', 600}, {'I', 100}, {'A', 300},
-	{'D', 100}, {'A', 100}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300},
-	{'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 300},
-	{'D', 100}, {'A', 300}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 100}, {'U', 100}, {'I', 300},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 200}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100},
-	{'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 300}, {'D', 100},
-	{'U', 300}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 300}, {'I', 100}, {'U', 600}, {'I', 100},
-	{'U', 500}, {'I', 100}, {'U', 600}, {'I', 100}, {'U', 500}, {'I', 100}, {'U', 600}, {'I', 100}, {'U', 500}, {'I', 100},
-	{'U', 600}, {'I', 100}, {'U', 300}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 200}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 300}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200}, {'I', 200},
-	{'A', 100}, {'I', 400}, {'A', 100}, {'I', 300}, {'A', 100}, {'I', 500}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 400},
-	{'A', 100}, {'I', 400}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 500}, {'S', 250}, {'d', 500},
-	{'u', 100}, {'d', 400}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 400},
-	{'u', 100}, {'d', 500}, {'u', 100}, {'d', 300}, {'u', 100}, {'d', 400}, {'u', 100}, {'d', 200}, {'B', 250}, {'D', 200},
-	{'A', 300}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100},
-	{'A', 300}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 400}, {'D', 100}, {'A', 300}, {'D', 100},
-	{'A', 200}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'U', 200}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 400}, {'D', 100},
-	{'U', 400}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 300}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 400}, {'D', 100},
-	{'U', 400}, {'D', 100}, {'U', 400}, {'D', 100}, {'U', 300}, {'D', 300}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400},
-	{'A', 100}, {'D', 400}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 400},
-	{'A', 100}, {'D', 400}, {'A', 100}, {'D', 600}, {'S', 250}, {'i', 600}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400},
-	{'u', 100}, {'i', 400}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400}, {'u', 100}, {'i', 400},
-	{'u', 100}, {'i', 400}, {'u', 100}, {'i', 100}, {'B', 250}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 300}, {'I', 300}, {'U', 100},
-	{'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 200}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200}, {'U', 100},
-	{'I', 200}, {'A', 300}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200},
-	{'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 200}, {'U', 200}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200},
-	{'I', 100}, {'U', 400}, {'S', 250}, {'d', 1800}, {'a', 3400}, {'B'}, {'A', 4300}, {'S', 250}, {'u', 4300}, {'B', 250}, {'D', 200},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'S', 250}, {'a', 300}, {'i', 100}, {'a', 400}, {'i', 100}, {'a', 300}, {'B', 250}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'S', 250}, {'i', 6300}, {'B', 250}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100},
-	{'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'S', 250},
-	{'u', 1000}, {'i', 200}, {'B', 250}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'S', 250}
+// Puntos de control de las figuras en la EEPROM. Al empezar una figura se guarda una cabecera con la figura, su origen
+// absoluto y la transformación, y mientras se dibuja, cada CONTROL_MS como mínimo, un registro con los movimientos que
+// ya ejecutaron los motores (la marca del segmento en curso), la posición absoluta de los motores en ese momento y el
+// estado del solenoide. Los registros rotan por CONTROL_RANURAS ranuras con un número de secuencia creciente, así cada
+// celda se escribe una vez cada CONTROL_RANURAS registros (con 100.000 escrituras por celda alcanza para unas 220 horas
+// de dibujo a cuatro registros por segundo). La suma de verificación es el último byte: si el corte llega a mitad de un
+// registro este queda inválido y vale el anterior. Se escribe de a un byte mientras el programa espera a la cola, para
+// no frenar los motores con los 3,4 ms que tarda cada byte en la EEPROM
+#define CONTROL_ACTIVO 0xA5 // Estado de la cabecera mientras se dibuja la figura
+#define CONTROL_SEMILLA 0x5A // Valor inicial de la suma de verificación (una EEPROM borrada no da una suma válida)
+
+typedef struct {
+	int32_t base_x, base_y; // Posición absoluta donde empieza la figura
+	Transformacion transformacion; // Transformación con la que se dibuja
+	uint16_t secuencia; // Secuencia del último registro al empezar (los de esta figura son posteriores)
+	uint8_t estado; // CONTROL_ACTIVO hasta que la figura termina
+	uint8_t numero; // Número de trabajo, distinto en cada figura, para no confundir registros de figuras anteriores
+	uint8_t figura; // Índice en FIGURAS_EMPAQUETADAS
+	uint8_t referenciada; // 1 si el eje Y estaba referido al final de carrera
+	uint8_t suma; // Suma de verificación
+} Trabajo;
+
+typedef struct {
+	int32_t x, y; // Posición absoluta de los motores al guardar el registro (con la parte hecha del segmento en curso)
+	uint16_t secuencia; // Número de registro (el mayor es el último)
+	uint16_t movimiento; // Movimientos de la figura ya ejecutados
+	uint8_t numero; // Número de trabajo al que pertenece
+	uint8_t pluma; // 1 con el solenoide abajo
+	uint8_t suma; // Suma de verificación
+} PuntoControl;
+
+#define CONTROL_REGISTROS (CONTROL_DIRECCION + sizeof(Trabajo)) // Dirección de la primera ranura
+
+Trabajo trabajo; // Figura en curso (copia de la cabecera)
+uint8_t control_activo = 0; // 1 mientras se guardan puntos de control
+uint8_t control_ranura = CONTROL_RANURAS - 1; // Última ranura escrita
+uint16_t control_secuencia = 0; // Secuencia del último registro escrito
+uint16_t control_movimiento; // Movimiento del último registro (no se repite un registro igual)
+int32_t control_x, control_y; // Posición del último registro
+uint32_t control_ticks = 0; // Ticks del Timer1 desde el último registro
+uint16_t control_tcnt = 0; // Última lectura de TCNT1
+uint8_t control_buffer[sizeof(Trabajo)]; // Datos que se están escribiendo en la EEPROM
+uint8_t control_indice = 0, control_pendientes = 0; // Próximo byte del buffer y bytes que faltan
+uint16_t control_destino; // Dirección de la EEPROM del próximo byte
+
+// Función que devuelve la suma de verificación de los primeros n bytes de un registro
+static uint8_t CONTROL_SUMA(const void *datos, uint8_t n){
+	const uint8_t *p = datos; // Bytes a sumar
+	uint8_t suma = CONTROL_SEMILLA; // Se parte de la semilla
+	while (n--) suma += *p++; // Se suma cada byte (módulo 256)
+	return suma; // Suma de verificación
+}
+
+// Función que escribe el próximo byte pendiente si la EEPROM terminó el anterior. EEMPE y EEPE deben escribirse con
+// menos de 4 ciclos de diferencia, así que la escritura va con las interrupciones deshabilitadas (unos pocos ciclos)
+static void CONTROL_SERVIR(void){
+	if (!control_pendientes || (EECR & (1 << EEPE))) return; // Nada que escribir o la EEPROM sigue ocupada
+	cli(); // EEMPE y EEPE sin interrupciones en el medio
+	EEPROM_ESCRIBIR(control_destino++, control_buffer[control_indice++]); // No espera: la EEPROM está libre
+	sei(); // Se habilitan las interrupciones
+	control_pendientes--; // Queda un byte menos
+}
+
+// Función que deja n bytes para escribir en la EEPROM, después de terminar los anteriores
+static void CONTROL_ESCRIBIR(uint16_t direccion, const void *datos, uint8_t n){
+	while (control_pendientes) CONTROL_SERVIR(); // Se terminan los datos anteriores
+	const uint8_t *p = datos; // Bytes a copiar
+	for (uint8_t i = 0; i < n; i++) control_buffer[i] = p[i]; // Se copian los datos
+	control_destino = direccion; // Dirección del primer byte
+	control_indice = 0; // Se empieza por el primer byte
+	control_pendientes = n; // Bytes a escribir
+}
+
+// Función que lee n bytes de la EEPROM, después de terminar las escrituras pendientes
+static void CONTROL_LEER(uint16_t direccion, void *datos, uint8_t n){
+	while (control_pendientes) CONTROL_SERVIR(); // Se terminan las escrituras pendientes
+	uint8_t *p = datos; // Destino de los bytes
+	while (n--) *p++ = EEPROM_LEER(direccion++); // Se leen los bytes en orden
+}
+
+// Función que recorre las ranuras: deja control_ranura y control_secuencia en el último registro válido (el siguiente
+// va en la ranura de al lado) y copia en r el último de la figura en curso. Devuelve 1 si la figura tiene registros
+static uint8_t CONTROL_BUSCAR(PuntoControl *r){
+	uint8_t hay = 0, encontrado = 0; // Registros válidos encontrados en general y de la figura en curso
+	for (uint8_t i = 0; i < CONTROL_RANURAS; i++){ // Se recorren las ranuras
+		PuntoControl p; // Registro de la ranura
+		CONTROL_LEER(CONTROL_REGISTROS + i * sizeof(PuntoControl), &p, sizeof p); // Se lee la ranura
+		if (p.suma != CONTROL_SUMA(&p, offsetof(PuntoControl, suma))) continue; // Ranura borrada o escrita a medias
+		if (!hay || (int16_t)(p.secuencia - control_secuencia) > 0){ hay = 1; control_ranura = i; control_secuencia = p.secuencia; } // El más nuevo
+		if (p.numero != trabajo.numero || (int16_t)(p.secuencia - trabajo.secuencia) <= 0) continue; // Es de otra figura
+		if (!encontrado || (int16_t)(p.secuencia - r->secuencia) > 0){ encontrado = 1; *r = p; } // El más nuevo de la figura en curso
+	}
+	return encontrado; // 1 si la figura tiene registros
+}
+
+// Función que empieza a guardar puntos de control de la figura en curso
+static void CONTROL_ACTIVAR(void){
+	control_movimiento = 0xFFFF; // El primer registro se guarda aunque no haya avance
+	control_ticks = 0; // Se empieza a contar el tiempo
+	cli(); // TCNT1 es de 16 bits y también lo usa la interrupción
+	control_tcnt = TCNT1; // Se empieza a medir el tiempo
+	sei(); // Se habilitan las interrupciones
+	control_activo = 1; // Se guardan registros desde ahora
+}
+
+// Función que guarda la cabecera de una figura nueva con el número de trabajo siguiente al anterior. 'trabajo' ya tiene
+// el origen y la transformación
+static void CONTROL_INICIAR(uint8_t figura){
+	PuntoControl r; // Último registro (solo interesa la ranura)
+	CONTROL_LEER(CONTROL_DIRECCION + offsetof(Trabajo, numero), &trabajo.numero, 1); // Número de la figura anterior
+	trabajo.numero = (trabajo.numero + 1) % 0xFF; // 0xFF es el valor de la EEPROM borrada
+	CONTROL_BUSCAR(&r); // Se ubica la última ranura escrita
+	trabajo.secuencia = control_secuencia; // Los registros de esta figura son los posteriores
+	trabajo.estado = CONTROL_ACTIVO; // Figura en curso
+	trabajo.figura = figura; // Índice de la figura
+	trabajo.referenciada = referenciada; // Si el eje Y estaba referido
+	trabajo.suma = CONTROL_SUMA(&trabajo, offsetof(Trabajo, suma)); // Suma de la cabecera
+	CONTROL_ESCRIBIR(CONTROL_DIRECCION, &trabajo, sizeof trabajo); // Se guarda la cabecera
+	CONTROL_ACTIVAR(); // Se empiezan a guardar registros
+}
+
+// Función que da por terminada la figura en curso: su cabecera deja de estar activa
+static void CONTROL_TERMINAR(void){
+	static const uint8_t terminado = 0; // Estado de la cabecera terminada
+	control_activo = 0; // No se guardan más registros
+	CONTROL_ESCRIBIR(CONTROL_DIRECCION + offsetof(Trabajo, estado), &terminado, 1); // Se marca la cabecera como terminada
+	while (control_pendientes) CONTROL_SERVIR(); // Se asegura antes de seguir
+}
+
+// Función que avanza la escritura pendiente y, si pasaron CONTROL_MS desde el último registro y la figura avanzó, guarda
+// uno nuevo con el segmento que están ejecutando los motores. Se llama mientras el programa espera a la cola
+void CONTROL_REVISAR(void){
+	CONTROL_SERVIR(); // Se avanza con la escritura pendiente
+	if (!control_activo) return; // Sin figura en curso no se guarda nada
+	cli(); // Se lee TCNT1 sin interrupciones
+	uint16_t t = TCNT1; // TCNT1 comparte con OCR1A el registro temporal de 16 bits que usa la interrupción
+	sei(); // Se habilitan las interrupciones
+	control_ticks += (uint16_t)(t - control_tcnt); // Si pasan más de 32 ms entre llamadas se cuenta de menos: los registros solo se espacian más
+	control_tcnt = t; // Se guarda la lectura
+	if (control_ticks < CONTROL_MS * (F_CPU / 8000UL) || control_pendientes) return; // Todavía no corresponde
+	PuntoControl p; // Registro nuevo
+	int16_t hecho_x = 0, hecho_y = 0; // Parte hecha del segmento en curso
+	cli(); // Marca y posición del mismo segmento
+	uint8_t en_marcha = TIMSK1 & (1 << OCIE1A); // Con la cola detenida la marca es la del último segmento, ya terminado
+	if (en_marcha) SEGMENTO_PARCIAL(&hecho_x, &hecho_y); // Un traslado largo es un solo segmento: se guarda hasta dónde llegó
+	p.movimiento = movimiento_actual; // Marca del segmento en curso
+	p.x = maquina_x + hecho_x; p.y = maquina_y + hecho_y; // Posición real de los motores
+	p.pluma = !(PORTC & (1 << SOLENOID)); // El pin en bajo baja el solenoide
+	sei(); // Se habilitan las interrupciones
+	if (!en_marcha || (p.movimiento == control_movimiento && p.x == control_x && p.y == control_y)) return; // Nada nuevo que guardar
+	control_ticks = 0; // Se vuelve a contar el tiempo
+	control_movimiento = p.movimiento; // Se recuerda lo guardado
+	control_x = p.x; control_y = p.y; // y su posición
+	control_ranura = (control_ranura + 1) & (CONTROL_RANURAS - 1); // Ranura siguiente
+	p.secuencia = ++control_secuencia; // Número de registro siguiente
+	p.numero = trabajo.numero; // Número de trabajo
+	p.suma = CONTROL_SUMA(&p, offsetof(PuntoControl, suma)); // Suma del registro
+	CONTROL_ESCRIBIR(CONTROL_REGISTROS + control_ranura * sizeof(PuntoControl), &p, sizeof p); // Se empieza a escribir en su ranura
+}
+
+// Función para recorrer una figura empaquetada, leída en orden desde la memoria de programa hasta su fin. Cada
+// movimiento se lleva a pasos con la transformación de las figuras y los consecutivos que forman una escalera sobre una
+// misma recta se unen en una sola cuerda trazada con PLOTTER_LINEA, así las diagonales salen lisas y sin frenadas. Si
+// la transformación tiene traslación, la figura empieza con un traslado con la solenoide levantada hasta su origen.
+// Los movimientos y comandos se numeran en orden y cada segmento encolado lleva el número con el que empieza, para los
+// puntos de control. Con 'desde' se retoma una figura: los movimientos que ya se ejecutaron se leen sin trazarlos, solo
+// para conocer la posición y el estado del solenoide, y se va con la pluma levantada hasta donde había quedado
+static void FIGURA_RECORRER(const uint8_t *figura, const PuntoControl *desde){
+	uint16_t unidad = LEER_VARIABLE(&figura); // Se lee la unidad de los movimientos
+	int32_t fx = 0, fy = 0; // Posición dentro de la figura, en sus unidades
+	int16_t px = transformacion.tx, py = transformacion.ty; // Posición ya trazada, en pasos desde el origen de la figura
+	uint16_t saltar = desde ? desde->movimiento : 0; // Movimientos que ya se ejecutaron
+	uint8_t abajo = desde ? desde->pluma : 0; // Estado del solenoide al llegar a cada movimiento
+	movimiento_figura = 0; // Marca del traslado inicial
+	if (!saltar){ // Desde el comienzo
+		MOVER_A(trabajo.base_x, trabajo.base_y); // Solo se mueve al retomar (si no la pluma ya está en el origen)
+		if (px || py) TRAZO_AGREGAR(px, py, 1); // Traslado hasta el origen de la figura transformada
+	}
+	for (uint16_t i = 0; ; i++){ // Se recorre la figura hasta el byte de fin
+		movimiento_figura = i; // Marca de los segmentos de este movimiento
+		if (saltar && i == saltar){ // Se llegó a donde quedó la figura interrumpida
+			MOVER_A(trabajo.base_x + px, trabajo.base_y + py); // Traslado con la pluma levantada
+			if (abajo) PLOTTER_BAJAR(); // Se vuelve al estado del solenoide en ese punto
+		}
+		uint8_t trazar = (i >= saltar); // Los movimientos anteriores ya se ejecutaron
+		if (trazar) CONTROL_REVISAR(); // Se guarda el avance cuando corresponde
+		uint8_t byte = pgm_read_byte(figura++); // Se lee el próximo byte de la figura
+		uint16_t cuenta = byte & 0x1F; // Cuenta de unidades del movimiento (0 en los comandos)
+		if (cuenta == 0){ // Comando
+			if (byte == FIGURA_FIN) break; // Se terminó la figura
+			LEER_VARIABLE(&figura); // Su tiempo no se usa: la cola espera al solenoide
+			abajo = (byte != FIGURA_SUBIR); // Estado del solenoide desde aquí
+			if (!trazar) continue; // Un comando ya ejecutado solo cambia el estado
+			TRAZO_VACIAR(); // Se termina la cuerda pendiente
+			if (byte == FIGURA_SUBIR) PLOTTER_SUBIR(); // Se levanta la solenoide
+			else PLOTTER_BAJAR(); // Se baja la solenoide
+			continue; // Se pasa al movimiento siguiente
+		}
+		if (cuenta == 31) cuenta += LEER_VARIABLE(&figura); // Cuenta larga
+		int32_t largo = (int32_t)cuenta * unidad; // Largo del movimiento en unidades de la figura
+		switch (byte >> 6){ // Se acumula el movimiento según su dirección
+			case 0: fx += largo; break; // Derecha
+			case 1: fx -= largo; break; // Izquierda
+			case 2: fy += largo; break; // Arriba
+			default: fy -= largo; break; // Abajo
+		}
+		int16_t nx = TRANSFORMAR(transformacion.a, transformacion.b, transformacion.tx, fx, fy); // Nuevo punto en pasos
+		int16_t ny = TRANSFORMAR(transformacion.c, transformacion.d, transformacion.ty, fx, fy); // Ídem en Y
+		if (nx != px || ny != py){ // Si el movimiento cambia el punto trazado
+			if (!(byte & 0x20)) abajo = 0; // Un movimiento sin bajar levanta el solenoide
+			if (trazar) TRAZO_AGREGAR(nx - px, ny - py, !(byte & 0x20)); // Se agrega la diferencia con lo ya trazado (la minúscula es sin bajar)
+		}
+		px = nx; // Se actualiza la posición trazada
+		py = ny; // Ídem en Y
+	}
+	TRAZO_VACIAR(); // Se traza la última cuerda pendiente
+	movimiento_figura = 0; // Un traslado encolado después lleva la marca del comienzo de la figura siguiente
+}
+
+// Definición de la figura zorro en formato empaquetado (generada con CONVERTIR_FIGURA.py del Laboratorio N°2)
+const uint8_t ZORRO[] PROGMEM = {
+	0x64, 0x5C, 0xDE, 0x00, 0xFA, 0x01, 0xE4, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21,
+	0xE1, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE1, 0x21,
+	0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x21, 0xE2, 0x22, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21,
+	0xA2, 0x21, 0xA2, 0x21, 0xA1, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21,
+	0xA2, 0x21, 0xA1, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA3, 0x22, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x23, 0xE3, 0x61,
+	0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61,
+	0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61,
+	0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61,
+	0xE1, 0x61, 0xE2, 0x40, 0xFA, 0x01, 0x42, 0x82, 0x00, 0xFA, 0x01, 0xA1, 0x62, 0xA1, 0x62, 0xA1,
+	0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x62, 0xA1,
+	0x62, 0x40, 0xFA, 0x01, 0x00, 0x00, 0xFF, 0x0C, 0x40, 0xFA, 0x01, 0x12, 0x96, 0x00, 0xFA, 0x01,
+	0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x40, 0xFA,
+	0x01, 0x1E, 0xC8, 0x00, 0xFA, 0x01, 0x66, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1,
+	0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x64, 0xA1, 0x63, 0xE3, 0x61, 0xE4, 0x61, 0xE4, 0x61, 0xE4,
+	0x61, 0xE4, 0x61, 0xE3, 0x61, 0xE4, 0x61, 0xE4, 0x61, 0xE4, 0x61, 0xE3, 0x61, 0xE2, 0x62, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x61, 0xA1, 0x61, 0xA1, 0x62, 0xE1,
+	0x61, 0xE1, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xA2,
+	0x61, 0xA3, 0x61, 0xA4, 0x61, 0xA4, 0x61, 0xA4, 0x61, 0xA3, 0x61, 0xA4, 0x61, 0xA4, 0x61, 0xA4,
+	0x61, 0xA4, 0x61, 0xA3, 0x62, 0x40, 0xFA, 0x01, 0x01, 0x82, 0x00, 0xFA, 0x01, 0xA1, 0x22, 0xA1,
+	0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1,
+	0x22, 0xA1, 0x22, 0x40, 0xFA, 0x01, 0x52, 0xD5, 0x00, 0xFA, 0x01, 0x62, 0xA1, 0x62, 0xA1, 0x62,
+	0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x62, 0xA1, 0x40, 0xFA, 0x01, 0x5D, 0xC8, 0x00, 0x00,
+	0x25, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x24, 0xA1, 0x25, 0xA1, 0x23, 0xA1,
+	0x24, 0xA1, 0x22, 0xA2, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA3, 0x23, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA2, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1,
+	0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x62, 0xE3, 0x21, 0xE6, 0x21, 0xE5,
+	0x21, 0xE6, 0x21, 0xE5, 0x21, 0xE6, 0x21, 0xE5, 0x21, 0xE6, 0x21, 0xE3, 0x61, 0xE1, 0x61, 0xE4,
+	0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE3,
+	0x61, 0xE3, 0x61, 0xE3, 0x61, 0xE2, 0x21, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1,
+	0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1,
+	0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1,
+	0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x22, 0xE1,
+	0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x23, 0xE1, 0xA1, 0x23,
+	0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x22,
+	0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22,
+	0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21,
+	0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22,
+	0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x21, 0xA2, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61,
+	0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA3, 0x61, 0xA4, 0x61, 0xA1, 0x61,
+	0xA3, 0x21, 0xA6, 0x21, 0xA5, 0x21, 0xA6, 0x21, 0xA5, 0x21, 0xA6, 0x21, 0xA5, 0x21, 0xA6, 0x21,
+	0xA3, 0x62, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61,
+	0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62,
+	0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61,
+	0xE1, 0x62, 0xE1, 0x7F, 0x08, 0x40, 0xFA, 0x01, 0x13, 0xDF, 0x03, 0xC0
 };
 
-// Definición de la figura flor a través de una estructura de pasos
-const Paso FLOR[] PROGMEM = {
-	{'i', 10000}, {'B', 250}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200},
-	{'D', 100}, {'A', 100}, {'D', 500}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 400}, {'A', 400}, {'D', 100}, {'A', 700}, {'D', 200}, {'U', 100}, {'D', 300}, {'U', 100}, {'D', 700}, {'A', 600},
-	{'I', 200}, {'A', 400}, {'D', 800}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 200}, {'I', 100}, {'A', 100},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 200},
-	{'D', 500}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 500}, {'A', 200},
-	{'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200},
-	{'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 900}, {'A', 200}, {'D', 100}, {'A', 200},
-	{'D', 100}, {'A', 100}, {'D', 100}, {'A', 500}, {'I', 700}, {'U', 100}, {'I', 300}, {'U', 100}, {'I', 200}, {'A', 700},
-	{'I', 100}, {'A', 400}, {'I', 500}, {'U', 100}, {'I', 400}, {'U', 100}, {'I', 100}, {'U', 200}, {'I', 500}, {'A', 100},
-	{'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 200}, {'A', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 200},
-	{'I', 100}, {'U', 200}, {'I', 100}, {'U', 100}, {'I', 500}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 400}, {'A', 100},
-	{'I', 400}, {'U', 400}, {'I', 100}, {'U', 700}, {'I', 200}, {'A', 100}, {'I', 300}, {'A', 100}, {'I', 700}, {'U', 500},
-	{'D', 100}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'I', 900}, {'U', 100}, {'I', 200}, {'U', 100},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100},
-	{'D', 200}, {'U', 100}, {'D', 200}, {'U', 200}, {'I', 500}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'D', 300}, {'U', 100}, {'D', 500}, {'U', 200}, {'I', 300}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100}, {'U', 100},
-	{'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 300}, {'U', 100},
-	{'D', 800}, {'U', 400}, {'I', 200}, {'U', 600}, {'D', 700}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 200}, {'U', 700},
-	{'D', 100}, {'U', 400}, {'D', 400}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100},
-	{'D', 500}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100},
-	{'S', 250}, {'a', 1700}, {'B', 250}, {'D', 500}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 300}, {'D', 100}, {'A', 800}, {'I', 100},
-	{'A', 300}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 200},
-	{'A', 100}, {'I', 300}, {'A', 100}, {'I', 900}, {'U', 100}, {'I', 300}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 200},
-	{'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 200}, {'I', 100}, {'U', 300}, {'I', 100}, {'U', 800}, {'D', 100},
-	{'U', 300}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 200}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200},
-	{'U', 100}, {'D', 300}, {'U', 100}, {'D', 400}, {'S', 250}, {'a', 5400}, {'i', 200}, {'B', 250}, {'A', 5400}, {'D', 500},
-	{'U', 5400}, {'S', 250}, {'a', 1100}, {'B', 250}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 200}, {'D', 200}, {'U', 200},
-	{'D', 200}, {'U', 100}, {'D', 500}, {'U', 200}, {'D', 700}, {'U', 100}, {'D', 1300}, {'A', 100}, {'D', 500}, {'A', 100},
-	{'D', 100}, {'A', 100}, {'D', 400}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 400},
-	{'I', 400}, {'U', 100}, {'I', 600}, {'A', 100}, {'I', 700}, {'A', 100}, {'I', 300}, {'A', 100}, {'I', 100}, {'A', 100},
-	{'I', 300}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 600}, {'U', 100},
-	{'I', 300}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 300}, {'D', 300},
-	{'U', 100}, {'D', 500}, {'U', 100}, {'D', 500}, {'U', 100}, {'D', 500}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 300},
-	{'U', 100}, {'D', 1500}, {'S', 250}, {'i', 7900}, {'B', 250}, {'D', 1500}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 500}, {'A', 100}, {'D', 500}, {'A', 100}, {'D', 500}, {'A', 100}, {'D', 300}, {'U', 300}, {'I', 300},
-	{'U', 100}, {'I', 100}, {'U', 200}, {'I', 200}, {'U', 200}, {'I', 200}, {'U', 100}, {'I', 500}, {'U', 200}, {'I', 700},
-	{'U', 100}, {'I', 1300}, {'A', 100}, {'I', 500}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 400}, {'A', 100}, {'I', 300},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 400}, {'D', 400}, {'U', 100}, {'D', 600}, {'A', 100}, {'D', 700},
-	{'A', 100}, {'D', 300}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 300}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 400},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 600}, {'U', 100}, {'D', 300}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 200}, {'U', 100}, {'S', 250}, {'u', 1900}, {'B', 250}, {'U', 300}, {'I', 100}, {'U', 100}, {'I', 100},
-	{'U', 800}, {'I', 400}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 200}, {'S', 250}, {'U', 1600}, {'B', 250}, {'I', 300}, {'A', 100}, {'I', 200}, {'A', 100}, {'I', 100},
-	{'A', 100}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 200}, {'I', 100}, {'A', 200}, {'S', 250}, {'i', 500}, {'u', 900},
-	{'B', 250}, {'D', 1400}, {'S', 250}, {'d', 3900}, {'B', 250}, {'D', 1400}, {'S', 250}, {'u', 1300}, {'B', 250}, {'I', 1400},
-	{'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200},
-	{'U', 200}, {'D', 100}, {'U', 300}, {'D', 100}, {'S', 250}, {'i', 5800}, {'B', 250}, {'A', 300}, {'D', 100}, {'A', 200},
-	{'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 300}, {'A', 100},
-	{'i', 1300}, {'S', 250}, {'u', 1700}, {'d', 1300}, {'B', 250}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100},
-	{'A', 100}, {'D', 200}, {'A', 100}, {'D', 200}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 200}, {'U', 900}, {'D', 100},
-	{'U', 100}, {'D', 100}, {'U', 300}, {'S', 250}, {'d', 1100}, {'B', 250}, {'A', 300}, {'D', 100}, {'A', 100}, {'D', 100},
-	{'A', 900}, {'D', 200}, {'U', 100}, {'D', 100}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'U', 100}, {'D', 100},
-	{'U', 100}, {'D', 200}, {'U', 100}, {'D', 200}, {'S', 250}, {'a', 3200}, {'B', 250}, {'D', 300}, {'A', 100}, {'D', 200},
-	{'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 100}, {'D', 100}, {'A', 200}, {'D', 100}, {'A', 200}, {'S', 250},
-	{'a', 800}, {'i', 800}, {'B', 250}, {'I', 300}, {'U', 100}, {'I', 100}, {'U', 100}, {'I', 200}, {'U', 100}, {'I', 100},
-	{'U', 100}, {'I', 200}, {'U', 100}, {'I', 400}, {'A', 800}, {'I', 100}, {'A', 100}, {'I', 100}, {'A', 300}, {'S', 250}
+// Definición de la figura flor en formato empaquetado (generada con CONVERTIR_FIGURA.py del Laboratorio N°2)
+const uint8_t FLOR[] PROGMEM = {
+	0x64, 0x5F, 0x28, 0xD4, 0x00, 0xFA, 0x01, 0x61, 0xE3, 0x61, 0xE2, 0x62, 0xE1, 0x61, 0xE1, 0x62,
+	0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x2E, 0x40, 0xFA, 0x01, 0xCD, 0x00, 0xFA, 0x01, 0x6E, 0x40, 0xFA,
+	0x01, 0x01, 0xC2, 0x00, 0xFA, 0x01, 0x23, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2,
+	0x21, 0xE2, 0x40, 0xFA, 0x01, 0x48, 0xC8, 0x00, 0xFA, 0x01, 0x63, 0xA1, 0x61, 0xA1, 0x62, 0xA1,
+	0x61, 0xA1, 0x62, 0xA1, 0x64, 0xE8, 0x61, 0xE1, 0x61, 0xE3, 0x40, 0xFA, 0x01, 0x43, 0xC4, 0x00,
+	0xFA, 0x01, 0xFF, 0x17, 0x65, 0xBF, 0x17, 0x40, 0xFA, 0x01, 0x44, 0x85, 0x00, 0xFA, 0x01, 0xA3,
+	0x61, 0xA1, 0x61, 0xA8, 0x64, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x62, 0x40,
+	0xFA, 0x01, 0xB0, 0x00, 0xFA, 0x01, 0x63, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE2,
+	0x61, 0xE2, 0x40, 0xFA, 0x01, 0x09, 0x89, 0x00, 0xFA, 0x01, 0x6E, 0x40, 0xFA, 0x01, 0x02, 0x8D,
+	0x40, 0xFA, 0x01, 0x03, 0x8A, 0x00, 0xFA, 0x01, 0xE3, 0x21, 0xE2, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x21, 0xE1, 0x23, 0xE1, 0x91, 0x00, 0xFA, 0x01, 0x22, 0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22,
+	0xE1, 0x22, 0xE1, 0x21, 0xE1, 0x22, 0xA9, 0x21, 0xA1, 0x21, 0xA3, 0x40, 0xFA, 0x01, 0x05, 0x85,
+	0x00, 0xFA, 0x01, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE2, 0x61, 0xE1, 0x65, 0xA1, 0x61, 0xA1,
+	0x62, 0xA1, 0x62, 0xA1, 0x64, 0xE4, 0x61, 0xE7, 0x62, 0xA1, 0x63, 0xA1, 0x67, 0xE6, 0x22, 0xE4,
+	0x68, 0xE1, 0x63, 0xE1, 0x61, 0xE2, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x22, 0xE1,
+	0x23, 0xE2, 0x65, 0xE1, 0x63, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE2, 0x21, 0xE1, 0x21, 0xE1,
+	0x21, 0xE1, 0x22, 0xE1, 0x25, 0xE2, 0x62, 0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x61, 0xE2,
+	0x21, 0xE1, 0x21, 0xE1, 0x22, 0xE1, 0x29, 0xE1, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE5, 0x27, 0xA1,
+	0x23, 0xA1, 0x22, 0xE7, 0x21, 0xE4, 0x24, 0xA1, 0x24, 0xA1, 0x21, 0xA2, 0x25, 0xE1, 0x21, 0xE2,
+	0x21, 0xE2, 0x22, 0xE1, 0x21, 0xA1, 0x22, 0xA2, 0x21, 0xA2, 0x21, 0xA1, 0x25, 0xE2, 0x21, 0xE1,
+	0x24, 0xE1, 0x25, 0xA4, 0x21, 0xA7, 0x22, 0xE1, 0x23, 0xE1, 0x27, 0xA5, 0x61, 0xA1, 0x61, 0xA2,
+	0x61, 0xA2, 0x29, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x21, 0xA2, 0x61, 0xA1, 0x61, 0xA1, 0x62, 0xA1,
+	0x62, 0xA1, 0x62, 0xA2, 0x25, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x21, 0xA2, 0x61, 0xA1,
+	0x61, 0xA1, 0x61, 0xA1, 0x63, 0xA1, 0x65, 0xA2, 0x23, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x21, 0xA1,
+	0x21, 0xA1, 0x21, 0xA2, 0x61, 0xA1, 0x63, 0xA1, 0x68, 0xA4, 0x22, 0xA6, 0x67, 0xE1, 0x63, 0xE1,
+	0x62, 0xA7, 0x61, 0xA4, 0x64, 0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x61, 0xE1, 0x65, 0xA1, 0x61, 0xA2,
+	0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x62, 0x40, 0xFA, 0x01, 0x06, 0xC6, 0x00, 0xFA, 0x01, 0xE3,
+	0x21, 0xE1, 0x21, 0xE9, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x21, 0xA1, 0x22, 0xA1,
+	0x22, 0x40, 0xFA, 0x01, 0x54, 0xC5, 0x00, 0xFA, 0x01, 0x25, 0xE1, 0x23, 0xE1, 0x22, 0xE1, 0x22,
+	0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE1, 0x21, 0xE2, 0x21, 0xE2, 0x21,
+	0xE3, 0x21, 0xE8, 0x61, 0xE3, 0x61, 0xE2, 0x61, 0xE2, 0x61, 0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x61,
+	0xE1, 0x61, 0xE1, 0x61, 0xE1, 0x62, 0xE1, 0x62, 0xE1, 0x63, 0xE1, 0x69, 0xA1, 0x63, 0xA1, 0x62,
+	0xA1, 0x62, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x61, 0xA2, 0x61,
+	0xA2, 0x61, 0xA3, 0x61, 0xA8, 0x21, 0xA3, 0x21, 0xA2, 0x21, 0xA2, 0x21, 0xA1, 0x21, 0xA1, 0x21,
+	0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x22, 0xA1, 0x23, 0xA1, 0x24, 0x40, 0xFA,
+	0x01, 0x5F, 0x08, 0xDF, 0x1F, 0x00, 0xFA, 0x01, 0x2F, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x25, 0xE1,
+	0x25, 0xE1, 0x25, 0xE1, 0x23, 0xA3, 0x63, 0xA1, 0x61, 0xA2, 0x62, 0xA2, 0x62, 0xA1, 0x65, 0xA2,
+	0x67, 0xA1, 0x6D, 0xE1, 0x65, 0xE1, 0x61, 0xE1, 0x64, 0xE1, 0x63, 0xE1, 0x61, 0xE1, 0x61, 0xE4,
+	0x24, 0xA1, 0x26, 0xE1, 0x27, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x23, 0xE1, 0x22, 0xE1, 0x24, 0xE1,
+	0x21, 0xE1, 0x26, 0xA1, 0x23, 0xA1, 0x21, 0xA1, 0x21, 0xA1, 0x22, 0xA1, 0x40, 0xFA, 0x01, 0x09,
+	0x83, 0x00, 0xFA, 0x01, 0x22, 0xA1, 0x21, 0xA2, 0x22, 0xA2, 0x22, 0xA1, 0x25, 0xA2, 0x27, 0xA1,
+	0x2D, 0xE1, 0x25, 0xE1, 0x21, 0xE1, 0x24, 0xE1, 0x23, 0xE1, 0x21, 0xE1, 0x21, 0xE4, 0x64, 0xA1,
+	0x66, 0xE1, 0x67, 0xE1, 0x63, 0xE1, 0x61, 0xE1, 0x63, 0xE1, 0x62, 0xE1, 0x64, 0xE1, 0x61, 0xE1,
+	0x66, 0xA1, 0x63, 0xA1, 0x61, 0xA1, 0x61, 0xA1, 0x62, 0xA1, 0x63, 0x23, 0xA1, 0x25, 0xA1, 0x25,
+	0xA1, 0x25, 0xA1, 0x21, 0xA1, 0x23, 0xA1, 0x2F, 0x40, 0xFA, 0x01, 0x5F, 0x03, 0x8C, 0xC0
 };
 
+const uint8_t *const FIGURAS_EMPAQUETADAS[] = { ZORRO, FLOR }; // Figuras que se pueden retomar (su índice se guarda en la EEPROM)
+#define FIGURAS_N (sizeof(FIGURAS_EMPAQUETADAS) / sizeof(FIGURAS_EMPAQUETADAS[0])) // Cantidad de figuras que se pueden retomar
+
+// Función para ejecutar una figura empaquetada desde la posición actual. Si está en FIGURAS_EMPAQUETADAS se guardan
+// puntos de control mientras se dibuja y se la da por terminada recién cuando los motores ejecutaron todos sus segmentos
+void EJECUTAR_FIGURA(const uint8_t *figura){
+	uint8_t numero = 0; // Índice de la figura
+	while (numero < FIGURAS_N && FIGURAS_EMPAQUETADAS[numero] != figura) numero++; // Se busca en la tabla
+	trabajo.base_x = plan_x; trabajo.base_y = plan_y; // La figura empieza en la posición actual
+	trabajo.transformacion = transformacion; // Con la transformación vigente
+	if (numero < FIGURAS_N) CONTROL_INICIAR(numero); // Se guarda la cabecera
+	FIGURA_RECORRER(figura, 0); // Se encola la figura completa
+	if (control_activo){ // Si se guardan puntos de control
+		PLOTTER_ESPERAR(); // Se termina de dibujar
+		CONTROL_TERMINAR(); // La figura ya no se puede retomar
+	}
+}
+
+// Posiciones de comienzo de cada figura en pasos respecto del punto donde empieza la secuencia (Y positivo hacia arriba).
+// Con posiciones absolutas cada traslado es una sola recta directa y no depende de dónde terminó la figura anterior
+#define TRIANGULO_X 0 // El triángulo empieza en el punto de partida
+#define TRIANGULO_Y 0 // Ídem en Y
+#define CRUZ_X 4000 // La cruz empieza 4000 pasos a la derecha
+#define CRUZ_Y 0 // A la misma altura
+#define CIRCULO_X 8000 // El círculo empieza un radio a la izquierda de su punto de 0°
+#define CIRCULO_Y (-1000) // Un radio por debajo del punto de partida
+#define ZORRO_X 9000 // Comienzo del zorro en X
+#define ZORRO_Y (-2000) // Comienzo del zorro en Y
+#define FLOR_X 5670 // Comienzo de la flor en X
+#define FLOR_Y (-2420) // Comienzo de la flor en Y
+
 void FIGURAS(void){ // Función para ejecutar una secuencia completa de figuras
+	int32_t x0 = plan_x, y0 = plan_y; // Posición absoluta donde empieza la secuencia
+	MOVER_A(x0 + TRIANGULO_X, y0 + TRIANGULO_Y); // Se lleva la pluma al comienzo del triángulo
 	TRIANGULO(); // Se dibuja un triángulo
-	PLOTTER_DERECHA_NO_BAJAR(4000); // Se mueve el plotter hacia la derecha sin bajar la solenoide una distancia de 4000 pasos
+	MOVER_A(x0 + CRUZ_X, y0 + CRUZ_Y); // Se lleva la pluma al comienzo de la cruz
 	CRUZ(); // Se dibuja una cruz
-	PLOTTER_DERECHA_NO_BAJAR(2000); // Se mueve el plotter hacia la derecha sin bajar la solenoide una distancia de 2000 pasos
-	PLOTTER_ABAJO_NO_BAJAR(1000); // Se mueve el plotter hacia abajo sin bajar la solenoide una distancia de 1000 pasos
-	CIRCULO(1000, 0.91); // Se dibuja un círculo con radio de 1000 pasos y un factor vertical de 0.91
-	PLOTTER_ABAJO_NO_BAJAR(1000); // Se mueve el plotter hacia abajo sin bajar la solenoide una distancia de 1000 pasos
-	EJECUTAR_FIGURA(ZORRO, sizeof(ZORRO) / sizeof(ZORRO[0])); // Se ejecuta la figura “Zorro” definida en memoria de programa
-	PLOTTER_IZQUIERDA_NO_BAJAR(3000); // Se mueve el plotter hacia la izquierda sin bajar la solenoide una distancia de 3000 pasos
-	PLOTTER_ARRIBA_NO_BAJAR(1500); // Se mueve el plotter hacia arriba sin bajar la solenoide una distancia de 1500 pasos
-	EJECUTAR_FIGURA(FLOR, sizeof(FLOR) / sizeof(FLOR[0])); // Se ejecuta la figura “Flor” definida en memoria de programa
+	MOVER_A(x0 + CIRCULO_X, y0 + CIRCULO_Y); // Se lleva la pluma al comienzo del círculo
+	CIRCULO(1000, Q8(0.91)); // Se dibuja un círculo con radio de 1000 pasos y un factor vertical de 0.91
+	MOVER_A(x0 + ZORRO_X, y0 + ZORRO_Y); // Se lleva la pluma al comienzo del zorro
+	EJECUTAR_FIGURA(ZORRO); // Se ejecuta la figura “Zorro” definida en memoria de programa
+	MOVER_A(x0 + FLOR_X, y0 + FLOR_Y); // Se lleva la pluma al comienzo de la flor
+	EJECUTAR_FIGURA(FLOR); // Se ejecuta la figura “Flor” definida en memoria de programa
+	PLOTTER_ESPERAR(); // Se espera a que la cola termine de ejecutarse
+}
+
+// Función que ofrece retomar una figura interrumpida por un corte de energía o un reinicio. Si la cabecera de la EEPROM
+// quedó activa se avisa por UART y se espera OFERTA_RETOMAR_MS la letra R (otra letra descarta la figura y sin
+// respuesta se conserva para el próximo arranque). Si la figura se había empezado con el eje Y referido al final de
+// carrera se vuelve a buscar el origen (si no se buscó ya al arrancar). El eje X no tiene final de carrera, así que se
+// toma como posición actual la del último registro, que incluye la parte hecha del segmento en curso: si los motores
+// llegaron a avanzar después de él (hasta CONTROL_MS), X queda corrido en ese tramo, por eso se pide llevar la pluma a
+// mano a esa X antes de retomar. Después se sigue la figura desde el segmento que estaba en curso en el último
+// registro. Devuelve 1 si se retomó una figura
+uint8_t RETOMAR_TRABAJO(void){
+	PuntoControl r; // Último registro de la figura
+	char buffer[128]; // Mensaje por UART
+	CONTROL_LEER(CONTROL_DIRECCION, &trabajo, sizeof trabajo); // Cabecera de la última figura
+	if (trabajo.estado != CONTROL_ACTIVO || trabajo.suma != CONTROL_SUMA(&trabajo, offsetof(Trabajo, suma)) || trabajo.figura >= FIGURAS_N) return 0; // No quedó ninguna a medias
+	if (!CONTROL_BUSCAR(&r)){ // Se cortó antes del primer registro: se empieza de nuevo desde su origen
+		r.movimiento = 0; // Desde el primer movimiento
+		r.x = trabajo.base_x; r.y = trabajo.base_y; // En el origen de la figura
+		r.pluma = 0; // Con la pluma levantada
+	}
+	UART_INICIAR(MYUBRR); // Se inicializa la comunicación UART con el baudrate definido
+	sprintf(buffer, "Figura %u interrumpida en el movimiento %u (%ld, %ld). Enviar R para retomarla\r\n", trabajo.figura, r.movimiento, (long)r.x, (long)r.y); // Aviso de la figura interrumpida
+	UART_IMPRIMIR(buffer); // Se envía el aviso
+	sprintf(buffer, "Antes llevar la pluma a mano a %ld mm en X del inicio de la figura (X no tiene final de carrera)\r\n", (long)((r.x - trabajo.base_x) / PASOS_POR_MM)); // Se pide llevar la pluma a la X del registro
+	UART_IMPRIMIR(buffer); // Los motores pudieron seguir hasta CONTROL_MS después del registro
+	for (uint16_t t = 0; t < OFERTA_RETOMAR_MS && !UART_DISPONIBLE(); t++) _delay_ms(1); // Se espera la respuesta
+	if (!UART_DISPONIBLE()) return 0; // Sin respuesta se sigue como siempre
+	char c = UART_LEER(); // Respuesta
+	if (c != 'R' && c != 'r'){ // Se descarta la figura
+		CONTROL_TERMINAR(); // La cabecera deja de estar activa
+		UART_IMPRIMIR("Figura descartada\r\n"); // Se informa
+		return 0; // Se sigue como siempre
+	}
+	if (trabajo.referenciada && !referenciada && !PLOTTER_REFERENCIAR()){ // El eje Y vuelve a su origen si no se buscó al arrancar
+		UART_IMPRIMIR("Origen no encontrado\r\n"); // Se informa
+		return 0; // No se puede retomar
+	}
+	PLOTTER_FIJAR(r.x, trabajo.referenciada ? plan_y : r.y); // Posición de los motores
+	transformacion = trabajo.transformacion; // La figura sigue con la misma transformación
+	UART_IMPRIMIR("Retomando\r\n"); // Se informa
+	CONTROL_ACTIVAR(); // Se siguen guardando registros con el mismo número de trabajo
+	FIGURA_RECORRER(FIGURAS_EMPAQUETADAS[trabajo.figura], &r); // Se sigue desde el segmento en curso
+	PLOTTER_ESPERAR(); // Se termina de dibujar
+	CONTROL_TERMINAR(); // La figura ya no se puede retomar
+	return 1; // Se retomó la figura
+}
+
+// Intérprete de G-code: las líneas llegan por UART y cada una se responde con "ok" (o "error: motivo") apenas sus
+// segmentos entran en la cola, mientras los motores siguen ejecutando los anteriores. Así el host puede enviar la línea
+// siguiente sin esperar a que termine el movimiento, y solo se lo frena cuando la cola está llena. Las coordenadas
+// están en mm con el origen en la posición de la pluma al entrar en este modo o en la que deja G28.
+int32_t pedido_x = 0, pedido_y = 0; // Posición pedida por las líneas anteriores en milésimas de mm
+int32_t origen_x = 0, origen_y = 0; // Posición absoluta en pasos del cero de las coordenadas
+int8_t movimiento_modal = 0; // Último G0 a G3 recibido (vale para las líneas que solo traen coordenadas)
+uint8_t coordenadas_relativas = 0; // 1 después de G91, 0 después de G90
+uint16_t tope_modal = 0xFFFF; // Velocidad máxima según el último F (sin límite hasta recibir uno)
+
+// Función que convierte milésimas de mm en pasos con la escala del eje en Q8 (256 en X, FACTOR_Y en Y), redondeando al
+// más cercano. Se pasa por octavos de paso para que los productos entren en 32 bits en todo el recorrido
+static int32_t A_PASOS(int32_t milesimas, uint16_t factor){
+	int32_t octavos = (milesimas * (8L * PASOS_POR_MM) + (milesimas < 0 ? -500 : 500)) / 1000; // Octavos de paso redondeados
+	return (octavos * factor + 1024) >> 11; // Se aplica la escala y se redondea a pasos
+}
+
+// Función que traza un arco hasta (x, y) en milésimas de mm con centro en el inicio más (i, j). Devuelve un motivo de error
+static const char *ARCO_A(int32_t x, int32_t y, int32_t i, int32_t j, uint8_t antihorario){
+	int32_t cx = A_PASOS(i, 256), cy = A_PASOS(j, 256); // Centro respecto del inicio en pasos sin escalar
+	int32_t dx = origen_x + A_PASOS(x, 256) - plan_x; // Final en X respecto de la posición real
+	int32_t dy = A_PASOS(y - pedido_y, 256); // Final en Y antes de escalar (PLOTTER_ARCO aplica FACTOR_Y)
+	if (cx == 0 && cy == 0) return "arco sin centro"; // Sin radio no hay arco
+	int32_t v[6] = { cx, cy, dx, dy, dx - cx, dy - cy }; // Valores que PLOTTER_ARCO maneja en int16_t
+	for (uint8_t k = 0; k < 6; k++) if (v[k] > 32000 || v[k] < -32000) return "arco muy grande"; // Fuera del rango de PLOTTER_ARCO
+	uint32_t radio = RAIZ((uint32_t)((cx / 2) * (cx / 2) + (cy / 2) * (cy / 2))); // Radio en pulsos (un pulso son dos flancos)
+	if (((radio * 5793UL) >> 10) + 8 > 65534) return "arco muy grande"; // Una vuelta (4·√2·r pulsos) no entra en el contador de PLOTTER_ARCO
+	PLOTTER_ARCO(cx, cy, dx, dy, antihorario, FACTOR_Y); // Arco más la recta de corrección del final
+	return 0; // Arco encolado
+}
+
+// Función que ejecuta un bloque analizado. Devuelve 0 o el motivo por el que se rechazó
+static const char *EJECUTAR_BLOQUE(const GCODE_BLOQUE *b){
+	if (b->referencia == 28){ // G28: se busca el origen de la máquina y se lo toma como cero de las coordenadas
+		if (!PLOTTER_REFERENCIAR()) return "origen no encontrado"; // No se encontró el final de carrera
+		origen_x = plan_x; origen_y = plan_y; // Cero de las coordenadas
+		pedido_x = pedido_y = 0; // La pluma está en el cero
+	}
+	if (final_carrera) return "final de carrera (enviar G28)"; // La cola quedó cortada y la posición pedida no se alcanzó
+	if (b->distancia == 90) coordenadas_relativas = 0; // G90: coordenadas absolutas
+	if (b->distancia == 91) coordenadas_relativas = 1; // G91: coordenadas relativas
+	if (b->presentes & GCODE_F){ // Nuevo avance
+		if (b->f <= 0) return "avance invalido"; // El avance debe ser positivo
+		tope_modal = AVANCE_A_TOPE(b->f); // Velocidad máxima de los próximos G1 a G3
+	}
+	if (b->m != GCODE_NINGUNO){ // Orden M (se ejecuta antes del movimiento de la misma línea)
+		switch (b->m){ // Según el número de la orden
+			case 3: PLOTTER_BAJAR(); break; // M3: se baja el solenoide
+			case 2: case 5: case 30: PLOTTER_SUBIR(); break; // M5, o fin de programa: se levanta el solenoide
+			case 400: PLOTTER_ESPERAR(); break; // M400: se espera a que termine la cola antes de responder
+			default: return "M no soportada"; // Otras órdenes M se rechazan
+		}
+	}
+	if (b->movimiento != GCODE_NINGUNO) movimiento_modal = b->movimiento; // El movimiento es modal
+	if (!(b->presentes & (GCODE_X | GCODE_Y | GCODE_I | GCODE_J))) return 0; // Sin coordenadas no hay movimiento
+
+	int32_t x = pedido_x, y = pedido_y; // Final del movimiento en milésimas de mm
+	if (b->presentes & GCODE_X) x = coordenadas_relativas ? pedido_x + b->x : b->x; // Nuevo X (relativo o absoluto)
+	if (b->presentes & GCODE_Y) y = coordenadas_relativas ? pedido_y + b->y : b->y; // Nuevo Y (relativo o absoluto)
+	if (x > RECORRIDO_MAXIMO * 1000L || x < -RECORRIDO_MAXIMO * 1000L || y > RECORRIDO_MAXIMO * 1000L || y < -RECORRIDO_MAXIMO * 1000L) return "fuera de recorrido"; // El punto queda fuera del recorrido de la máquina
+
+	tope_avance = (movimiento_modal == 0) ? 0xFFFF : tope_modal; // G0 va a la velocidad máxima
+	if (movimiento_modal <= 1) PLOTTER_LINEA_A(origen_x + A_PASOS(x, 256), origen_y + A_PASOS(y, FACTOR_Y)); // G0 y G1: recta al punto exacto
+	else { // G2 (horario) y G3 (antihorario)
+		int32_t i = (b->presentes & GCODE_I) ? b->i : 0, j = (b->presentes & GCODE_J) ? b->j : 0; // Centro relativo
+		const char *error = ARCO_A(x, y, i, j, movimiento_modal == 3); // Se encola el arco
+		if (error) return error; // El arco no se pudo trazar
+	}
+	pedido_x = x; pedido_y = y; // Se guarda la posición pedida
+	return 0; // Bloque ejecutado
+}
+
+// Función que recibe líneas de G-code por UART y las ejecuta indefinidamente
+void INTERPRETE_GCODE(void){
+	char linea[GCODE_LINEA_MAX]; // Línea recibida
+	GCODE_BLOQUE bloque; // Línea analizada
+	UART_INICIAR(MYUBRR); // Se inicializa la comunicación UART con el baudrate definido
+	UART_HABILITAR_RX_INT(); // Se recibe por interrupción para no perder caracteres mientras se encolan segmentos
+	PLOTTER_SUBIR(); // Se arranca con el solenoide levantado
+	origen_x = plan_x; origen_y = plan_y; // El cero de las coordenadas es la posición actual
+	UART_IMPRIMIR("Plotter listo\r\n"); // Se avisa al host que puede enviar líneas
+	while (1){ // Se atienden líneas indefinidamente
+		uint8_t completa = GCODE_RECIBIR_LINEA(linea); // Se espera una línea completa
+		if (UART_RX_DESBORDE()){ GCODE_ERROR_ENVIAR("desborde"); continue; } // Se perdieron caracteres
+		if (!completa){ GCODE_ERROR_ENVIAR("linea larga"); continue; } // La línea no entró en el buffer
+		uint8_t r = GCODE_ANALIZAR(linea, &bloque); // Se analiza la línea
+		if (r == GCODE_ERROR){ GCODE_ERROR_ENVIAR("sintaxis"); continue; } // Palabra o número inválido
+		const char *error = (r == GCODE_OK) ? EJECUTAR_BLOQUE(&bloque) : 0; // Se encolan sus movimientos
+		if (error) GCODE_ERROR_ENVIAR(error); // Se informa el motivo del rechazo
+		else GCODE_OK_ENVIAR(); // Se pide la línea siguiente
+	}
 }
 
 int main(void){ // Función principal del programa
-	DDRB |= (1<<DIR_X) | (1<<EN_X); // Se configuran los pines DIR_X y EN_X del puerto B como salidas
-	DDRC |= (1<<DIR_Y) | (1<<EN_Y) | (1<<SOLENOID); // Se configuran los pines DIR_Y, EN_Y y SOLENOID del puerto C como salidas
+	DDRB |= (1<<CLK_X) | (1<<DIR_X) | (1<<EN_X); // Se configuran los pines CLK_X, DIR_X y EN_X del puerto B como salidas
+	DDRC |= (1<<CLK_Y) | (1<<DIR_Y) | (1<<EN_Y) | (1<<SOLENOID); // Se configuran los pines CLK_Y, DIR_Y, EN_Y y SOLENOID del puerto C como salidas
+	DDRD &= ~((1<<LIMIT_YA) | (1<<LIMIT_YD)); // Se configuran los pines de los finales de carrera como entradas
+	PORTD |= (1<<LIMIT_YA) | (1<<LIMIT_YD); // Con resistencia de pull-up: el final de carrera accionado pone el pin en bajo
+	PCMSK2 |= (1<<PCINT18) | (1<<PCINT19); // Se habilita la interrupción por cambio en PD2 y PD3
 
 	TIMER1_INICIAR(); // Se inicializa el Timer1 para el control de los motores paso a paso
+	FINALES_HABILITAR(1); // Se habilita la interrupción de los finales de carrera
+
+#if BUSCAR_ORIGEN
+	PLOTTER_REFERENCIAR(); // Se busca el origen de la máquina
+#endif
+
+	uint8_t retomada = RETOMAR_TRABAJO(); // Si una figura quedó interrumpida se ofrece terminarla
 
-	FIGURAS(); // Se ejecuta la secuencia completa de figuras predefinidas
+#if DIBUJAR_FIGURAS
+	if (!retomada) FIGURAS(); // Se ejecuta la secuencia completa de figuras predefinidas
+#endif
 
-	while(1); // Bucle infinito para mantener el programa en ejecución
+	INTERPRETE_GCODE(); // Se reciben y ejecutan trabajos en G-code (no retorna)
+	return 0; // No se llega: INTERPRETE_GCODE no retorna
 }
 
-// No se realizó implementacion del LED ni de los limites, ya que se mantuvo el trazado acorde a la hoja, que es de menor proporción que el área de trazo de plotter.
+// No se realizó implementacion del LED. Los finales de carrera solo existen en el eje Y: cortan cualquier movimiento que los accione y se usan para buscar el origen.
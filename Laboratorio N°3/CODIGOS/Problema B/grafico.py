@@ -8,14 +8,13 @@ PUERTO = 'COM5'  # Se define el puerto serie donde está conectado el microcontr
 BAUDRATE = 9600  # Se define la velocidad de transmisión en baudios
 TIEMPO_MUESTREO = 0.5  # Se define el intervalo de muestreo entre lecturas sucesivas (en segundos)
 
-temps, pms, pwms, acciones, tiempos = [], [], [], [], []  # Se crean listas vacías para almacenar temperatura, punto medio, PWM, acción y tiempo
+temps, pms, calefs, vents, tiempos = [], [], [], [], []  # Se crean listas vacías para almacenar temperatura, punto medio, duty del calefactor, duty del ventilador y tiempo
 punto_medio = 26  # Se establece el punto medio inicial de referencia
 running = True  # Se define una bandera de control que mantiene la ejecución del programa activa
 
-def enviar_punto_medio(ser, nuevo_pm):
-    global punto_medio
+def enviar_valor(ser, comando, valor):
     ser.reset_input_buffer()  # Se limpia el buffer de entrada del puerto serie
-    ser.write(b'x')  # Se envía el carácter 'x' indicando solicitud de cambio de punto medio
+    ser.write(comando.encode())  # Se envía la letra del ajuste ('x' para el punto medio, 'p', 'i' o 'd' para las ganancias)
     time.sleep(0.3)  # Se agrega un pequeño retardo para sincronizar la respuesta del microcontrolador
     limite_espera = time.time() + 2.0  # Se establece un tiempo máximo de espera de respuesta
     recibido = b""  # Se inicializa un buffer para almacenar la respuesta recibida
@@ -27,8 +26,12 @@ def enviar_punto_medio(ser, nuevo_pm):
                 break  # Se interrumpe el bucle
         time.sleep(0.05)  # Se agrega una breve pausa antes de volver a leer
 
-    ser.write(f"{nuevo_pm}\r".encode())  # Se envía el nuevo valor del punto medio con retorno de carro
+    ser.write(f"{valor}\r".encode())  # Se envía el nuevo valor con retorno de carro
     time.sleep(0.5)  # Se espera para garantizar la correcta recepción
+
+def enviar_punto_medio(ser, nuevo_pm):
+    global punto_medio
+    enviar_valor(ser, 'x', nuevo_pm)  # Se envía el punto medio
     punto_medio = nuevo_pm  # Se actualiza el valor global del punto medio
     print(f"\nPunto medio {nuevo_pm} enviado correctamente.\n")  # Se notifica en consola el envío exitoso
 
@@ -47,24 +50,29 @@ def hilo_consola(ser):
             except ValueError:
                 print("Valor inválido.")  # Se muestra un mensaje si la entrada no es numérica
 
+        elif cmd in ['p', 'i', 'd']:  # Si el comando es una ganancia del PID (se guarda en la EEPROM del microcontrolador)
+            try:
+                valor = float(input(f"Ingrese nuevo K{cmd} (0–127.99): ").replace(',', '.'))  # Se solicita un valor con decimales
+                if 0 <= valor < 128:  # Se valida que entre en Q8.8
+                    enviar_valor(ser, cmd, f"{valor:.2f}")  # Se envía con dos decimales
+                    print(f"\nK{cmd} = {valor:.2f} enviado correctamente.\n")
+                else:
+                    print("Valor fuera de rango (0–127.99).")
+            except ValueError:
+                print("Valor inválido.")
+
         elif cmd in ['q', 'exit', 'salir']:  # Si el usuario desea salir del programa
             running = False  # Se cambia la bandera principal para detener la ejecución
             print("Finalizando por solicitud del usuario...")  # Se notifica en consola
             break  # Se interrumpe el bucle de la consola
 
-def pwm_por_accion(accion):
-    accion = accion.lower()  # Se convierte la cadena a minúsculas para uniformar las comparaciones
-    if "bajo" in accion: return 85  # Devuelve 85 si la acción corresponde a un nivel bajo
-    if "medio" in accion: return 170  # Devuelve 170 si la acción corresponde a un nivel medio
-    if "alto" in accion: return 255  # Devuelve 255 si la acción corresponde a un nivel alto
-    return 0  # Devuelve 0 si no se identifica ninguna acción conocida
-
 ser = serial.Serial(PUERTO, BAUDRATE, timeout=1)  # Se inicializa la comunicación serial con los parámetros definidos
 time.sleep(2)  # Se espera 2 segundos para permitir el reinicio del microcontrolador
 
 print("Control de Temperatura - ATmega328P")  # Se muestra un encabezado informativo en consola
 print("Comandos:")  
 print("  x  → Cambiar punto medio (10–50)")  # Se explica el comando 'x'
+print("  p, i, d  → Cambiar Kp, Ki o Kd del PID (0–127.99)")  # Se explican los comandos de las ganancias
 print("  q  → Salir\n")  # Se explica el comando 'q' para salir del programa
 
 threading.Thread(target=hilo_consola, args=(ser,), daemon=True).start()  # Se inicia un hilo paralelo para escuchar comandos en consola
@@ -80,12 +88,13 @@ ax1.tick_params(axis='y', labelcolor='r')  # Se colorean las etiquetas del eje Y
 ax1.grid(True)  # Se activa la cuadrícula en la gráfica
 
 ax2 = ax1.twinx()  # Se crea un segundo eje Y para mostrar el valor PWM
-line_pwm,  = ax2.plot([], [], 'g--', label='PWM')  # Se define la línea verde discontinua correspondiente al PWM
-ax2.set_ylabel('PWM [0–255]', color='g')  # Se etiqueta el eje Y derecho
+line_calef, = ax2.plot([], [], 'm--', label='Calefactor')  # Se define la línea magenta discontinua con el duty del calefactor
+line_vent,  = ax2.plot([], [], 'g--', label='Ventilador')  # Se define la línea verde discontinua con el duty del ventilador
+ax2.set_ylabel('Duty [0–255]', color='g')  # Se etiqueta el eje Y derecho
 ax2.set_ylim(0, 255)  # Se fija el rango de valores del PWM
 ax2.tick_params(axis='y', labelcolor='g')  # Se colorean las etiquetas del eje Y derecho en verde
 
-lines = [line_temp, line_pm, line_pwm]  # Se agrupan las líneas de datos
+lines = [line_temp, line_pm, line_calef, line_vent]  # Se agrupan las líneas de datos
 labels = [l.get_label() for l in lines]  # Se obtienen las etiquetas de cada línea
 ax1.legend(lines, labels, loc='upper right')  # Se agrega la leyenda en la esquina superior derecha
 
@@ -96,23 +105,24 @@ try:
     while running:  # Se ejecuta el bucle principal mientras la bandera esté activa
         linea = ser.readline().decode('latin-1', errors='ignore').strip()  # Se lee una línea del puerto serie y se decodifica
         if linea:  # Si la línea contiene datos válidos
-            match = re.search(r"Temp:(\d+)C\s*\|\s*PM:(\d+)\s*\|\s*(.*)", linea)  # Se busca el patrón con temperatura, punto medio y acción
+            match = re.search(r"Temp:(\d+(?:\.\d+)?)C\s*\|\s*PM:(\d+)\s*\|\s*Calef:(\d+)\s*\|\s*Vent:(\d+)", linea)  # Se busca el patrón con temperatura, punto medio y salidas del PID
             if match:
-                temp = int(match.group(1))  # Se obtiene la temperatura en °C
+                temp = float(match.group(1))  # Se obtiene la temperatura en °C (con decimales)
                 pm = int(match.group(2))  # Se obtiene el valor de punto medio
-                accion = match.group(3).strip()  # Se obtiene la acción (por ejemplo, "Bajo", "Medio", "Alto")
-                pwm = pwm_por_accion(accion)  # Se calcula el PWM correspondiente según la acción
+                calef = int(match.group(3))  # Se obtiene el duty del calefactor (fracción de la ventana de 1 s)
+                vent = int(match.group(4))  # Se obtiene el duty del PWM del ventilador
                 t = time.time() - t0  # Se calcula el tiempo transcurrido desde el inicio
 
                 temps.append(temp)  # Se almacena la temperatura en la lista
                 pms.append(pm)  # Se almacena el punto medio
-                pwms.append(pwm)  # Se almacena el valor de PWM
-                acciones.append(accion)  # Se guarda la descripción de la acción
+                calefs.append(calef)  # Se almacena el duty del calefactor
+                vents.append(vent)  # Se almacena el duty del ventilador
                 tiempos.append(t)  # Se guarda el tiempo relativo
 
                 line_temp.set_data(tiempos, temps)  # Se actualiza la línea de temperatura
                 line_pm.set_data(tiempos, pms)  # Se actualiza la línea de punto medio
-                line_pwm.set_data(tiempos, pwms)  # Se actualiza la línea de PWM
+                line_calef.set_data(tiempos, calefs)  # Se actualiza la línea del calefactor
+                line_vent.set_data(tiempos, vents)  # Se actualiza la línea del ventilador
 
                 ax1.relim()  # Se recalculan los límites del eje izquierdo
                 ax1.autoscale_view()  # Se actualiza la vista según los nuevos valores
@@ -120,7 +130,7 @@ try:
                 ax2.autoscale_view()  # Se actualiza la vista del eje derecho
                 plt.pause(0.001)  # Se actualiza la gráfica en pantalla
 
-                print(f"Temperatura={temp:2d}°C | PM={pm:2d} | PWM={pwm:3d} | Acción={accion}")  # Se muestra el estado actual en consola
+                print(f"Temperatura={temp:5.2f}°C | PM={pm:2d} | Calefactor={calef:3d} | Ventilador={vent:3d}")  # Se muestra el estado actual en consola
 
         time.sleep(TIEMPO_MUESTREO)  # Se respeta el intervalo de muestreo antes de la siguiente lectura
 
@@ -1,5 +1,6 @@
 #define F_CPU 16000000UL // Se define la frecuencia del CPU a 16 MHz
 #include <avr/io.h> // Se incluye la librería de entrada/salida del microcontrolador AVR
+#include <avr/interrupt.h> // Se incluye la librería para el manejo de interrupciones
 #include <util/delay.h> // Se incluye la librería para generar retardos
 #include <stdlib.h> // Se incluye la librería estándar para funciones como atoi()
 #include <stdio.h> // Se incluye para manejo de cadenas formateadas con sprintf()
@@ -7,6 +8,8 @@
 #include "uart.h" // Se incluye la librería personalizada para la comunicación UART
 #include "adc.h" // Se incluye la librería personalizada para la lectura analógica del ADC
 #include "pwm.h" // Se incluye la librería personalizada para el control PWM
+#include "pid.h" // Se incluye la librería personalizada del controlador PID en punto fijo
+#include "eeprom.h" // Se incluye la librería personalizada para guardar las ganancias en la EEPROM
 
 #define BAUD 9600 // Se define la velocidad de comunicación serial en baudios
 #define MYUBRR (F_CPU / 16 / BAUD - 1) // Se calcula el valor del registro UBRR para la UART
@@ -16,18 +19,146 @@
 #define IN1 PD2 // Se define el pin PD2 como entrada IN1 del puente H
 #define IN2 PD3 // Se define el pin PD3 como entrada IN2 del puente H
 
-static uint8_t punto_medio = 26; // Se define el valor inicial del punto medio de temperatura en 26 °C
+#define FRECUENCIA_VENTILADOR 31372UL // Frecuencia del PWM del ventilador en Hz (16 MHz / 510, la máxima del Timer0 en phase correct)
+
+#define BITS_EXTRA 2 // Bits extra por sobremuestreo: 16 conversiones por medición dan 12 bits (0,12 °C por cuenta)
+// Conversión a °C en punto fijo Q8.8: T = v * 500 / 4096 °C, y en Q8.8 T * 256 = v * 125 / 4 (solo multiplicación y desplazamiento).
+// El resultado queda en 32 bits: desde 128 °C (v = 1049) no entra en int16_t
+#define TEMP_Q8_8(v) (((uint32_t)(v) * 125UL) >> BITS_EXTRA) // Temperatura en Q8.8 (32 bits)
+#define FALLA_SENSOR 4000 // Lectura desde la cual se toma el sensor como desconectado o en corto (488 °C, cerca del fondo de escala)
+
+// Control PID: una muestra por segundo (disparada por el Timer1) y salida de -255 a 255. La salida positiva es el duty
+// del calefactor y la negativa el del ventilador, así nunca funcionan los dos a la vez. Las ganancias van en Q8.8 y en
+// cuentas de salida: KP por °C de error, KI por °C de error y por segundo, KD por °C/s de cambio de la temperatura
+#define FRECUENCIA_MUESTREO 1 // Frecuencia de muestreo del PID en Hz
+#define KP_INICIAL (40 << 8) // Ganancias de partida mientras no haya otras guardadas en la EEPROM (40, 0,5 y 64)
+#define KI_INICIAL (1 << 7) // Ki de partida (0,5)
+#define KD_INICIAL (64 << 8) // Kd de partida (64)
+#define FILTRO_DERIVADA 2 // La derivada se filtra en 2^2 = 4 muestras
+#define GANANCIAS_DIRECCION 0 // Dirección de la EEPROM donde se guardan las ganancias
+#define GANANCIAS_SEMILLA 0x5A // Valor inicial de la suma de verificación (una EEPROM borrada no da una suma válida)
+
+// Calefactor proporcional en el tiempo: el pin se enciende una parte de una ventana de 256 ranuras igual al duty. El
+// Timer2 en CTC con prescaler 1024 (64 µs) interrumpe cada RANURA_CALEFACTOR + 1 = 61 cuentas (3,9 ms), así la ventana
+// dura 1 s, lo mismo que el período de muestreo: un calefactor resistivo no sigue variaciones más rápidas
+#define RANURA_CALEFACTOR 60 // Valor de OCR2A
+
+static volatile uint8_t punto_medio = 26; // Se define el valor inicial del punto medio de temperatura en 26 °C
 static uint8_t pausa = 0; // Variable bandera que indica si el sistema está en modo pausa para ajuste
+static char ajuste = 'x'; // Valor que se está ingresando en el modo pausa (x: punto medio, p, i o d: ganancias)
+
+static PID pid; // Estado del controlador (lo actualiza la interrupción del ADC)
+static volatile uint8_t duty_calefactor = 0; // Fracción de la ventana con el calefactor encendido (0 a 255)
+static volatile uint8_t duty_ventilador = 0; // Duty del PWM del ventilador (0 a 255)
+static volatile uint8_t falla_sensor = 0; // Vale 1 mientras la lectura del sensor está cerca del fondo de escala
+
+typedef struct {
+	int16_t kp, ki, kd; // Ganancias en Q8.8
+	uint8_t suma; // Suma de verificación
+} Ganancias;
+
+static Ganancias ganancias = { KP_INICIAL, KI_INICIAL, KD_INICIAL, 0 }; // Ganancias vigentes
+
+// Función que devuelve la suma de verificación de las ganancias
+static uint8_t GANANCIAS_SUMA(const Ganancias *g){
+	const uint8_t *p = (const uint8_t *)g; // Bytes de las ganancias
+	uint8_t suma = GANANCIAS_SEMILLA; // Se parte de la semilla
+	for (uint8_t i = 0; i < sizeof(Ganancias) - 1; i++) suma += p[i]; // Todos los bytes menos la suma
+	return suma; // Suma de verificación
+}
+
+// Función que carga las ganancias guardadas en la EEPROM (si no son válidas quedan las de partida)
+static void GANANCIAS_CARGAR(void){
+	Ganancias g; // Copia leída de la EEPROM
+	uint8_t *p = (uint8_t *)&g; // Bytes de la copia
+	for (uint8_t i = 0; i < sizeof g; i++) p[i] = EEPROM_LEER(GANANCIAS_DIRECCION + i); // Se leen los bytes en orden
+	if (g.suma == GANANCIAS_SUMA(&g)) ganancias = g; // Solo se usa una copia válida
+	PID_GANANCIAS(&pid, ganancias.kp, ganancias.ki, ganancias.kd); // Se aplican al PID
+}
+
+// Función que aplica las ganancias vigentes y las guarda en la EEPROM (solo los bytes que cambiaron)
+static void GANANCIAS_GUARDAR(void){
+	cli(); // El PID las usa desde la interrupción del ADC
+	PID_GANANCIAS(&pid, ganancias.kp, ganancias.ki, ganancias.kd); // Se aplican las ganancias nuevas al PID
+	sei(); // Se habilitan las interrupciones
+	ganancias.suma = GANANCIAS_SUMA(&ganancias); // Suma de la copia nueva
+	const uint8_t *p = (const uint8_t *)&ganancias; // Bytes a guardar
+	for (uint8_t i = 0; i < sizeof ganancias; i++){ // La suma es el último byte: si se corta a medias la copia queda inválida
+		if (EEPROM_LEER(GANANCIAS_DIRECCION + i) == p[i]) continue; // Byte sin cambios (la lectura espera a que termine la escritura anterior)
+		uint8_t sreg = SREG; // Se guarda el estado de las interrupciones
+		cli(); // EEMPE y EEPE deben escribirse con menos de 4 ciclos de diferencia: ninguna interrupción en el medio
+		EEPROM_ESCRIBIR(GANANCIAS_DIRECCION + i, p[i]); // No espera: la EEPROM quedó libre al leer el byte
+		SREG = sreg; // Se restaura el estado de las interrupciones
+	}
+}
+
+// Función que convierte un número con hasta dos decimales ("12.5", "0.25") a Q8.8. Devuelve 0 si no es válido o no está entre 0 y 127,99
+static uint8_t LEER_Q8_8(const char *texto, int16_t *valor){
+	uint16_t entero = 0, fraccion = 0, escala = 1; // Parte entera, decimales y 10^decimales
+	if (!*texto) return 0; // Texto vacío
+	while (*texto >= '0' && *texto <= '9'){ entero = entero * 10 + (*texto++ - '0'); if (entero > 127) return 0; } // Parte entera (hasta 127)
+	if (*texto == '.' || *texto == ','){ // Separador decimal (punto o coma)
+		texto++; // Se saltea el separador
+		while (*texto >= '0' && *texto <= '9' && escala < 100){ fraccion = fraccion * 10 + (*texto++ - '0'); escala *= 10; } // Hasta dos decimales
+	}
+	if (*texto) return 0; // Caracteres de más
+	*valor = (int16_t)((entero << 8) + (((uint32_t)fraccion << 8) + escala / 2) / escala); // Decimales redondeados a 1/256
+	return 1; // Valor válido
+}
+
+// Función que imprime un valor Q8.8 positivo con dos decimales
+static void IMPRIMIR_Q8_8(char *buffer, const char *nombre, int16_t valor){
+	sprintf(buffer, "%s=%u.%02u ", nombre, (uint16_t)valor >> 8, (uint16_t)((((uint16_t)valor & 0xFF) * 100U + 128) >> 8)); // Nombre, parte entera y centésimas redondeadas
+	UART_IMPRIMIR(buffer); // Se envía por UART
+}
+
+// Función que imprime las ganancias vigentes
+static void IMPRIMIR_GANANCIAS(char *buffer){
+	IMPRIMIR_Q8_8(buffer, "Kp", ganancias.kp); // Ganancia proporcional
+	IMPRIMIR_Q8_8(buffer, "Ki", ganancias.ki); // Ganancia integral
+	IMPRIMIR_Q8_8(buffer, "Kd", ganancias.kd); // Ganancia derivativa
+	UART_IMPRIMIR("\r\n"); // Fin de línea
+}
+
+// Función que ejecuta el PID con cada medición. Se llama desde la interrupción del ADC, así el período de muestreo lo
+// fija el Timer1 y no depende de la UART ni del modo pausa. Con una lectura de falla se apagan el calefactor y el
+// ventilador, y al volver una lectura válida el PID arranca de nuevo desde la salida nula
+static void CONTROLAR(void){
+	uint16_t v = ADC_ULTIMO(0); // Medición de 12 bits
+	int16_t salida = 0; // Sin lectura válida no se calienta ni se enfría
+	if (v >= FALLA_SENSOR) falla_sensor = 1; // Sensor desconectado: no se puede controlar
+	else{ // Lectura válida
+		uint32_t t = TEMP_Q8_8(v); // Temperatura en Q8.8
+		int16_t temp_q = (t > INT16_MAX) ? INT16_MAX : (int16_t)t; // Se satura en 127,99 °C (sigue mandando a enfriar)
+		if (falla_sensor){ PID_REINICIAR(&pid, temp_q, 0); falla_sensor = 0; } // Sin integral ni derivada de antes de la falla
+		salida = PID_ACTUALIZAR(&pid, (int16_t)punto_medio << 8, temp_q); // Positiva calienta y negativa enfría
+	}
+	if (salida > 0){ // Se calienta
+		duty_calefactor = (uint8_t)salida; // El duty del calefactor es la salida
+		duty_ventilador = 0; // Ventilador apagado
+		PORTD &= ~((1 << IN1) | (1 << IN2)); // Se detiene el ventilador
+	}else{ // Se enfría (o no se hace nada)
+		duty_calefactor = 0; // Calefactor apagado
+		duty_ventilador = (uint8_t)(-salida); // El duty del ventilador es la salida cambiada de signo
+		if (duty_ventilador){ PORTD |= (1 << IN1); PORTD &= ~(1 << IN2); } // Se gira el ventilador en un sentido
+		else PORTD &= ~((1 << IN1) | (1 << IN2)); // Se detiene el ventilador
+	}
+	PWM_ESTABLECER_DUTY(duty_ventilador); // Velocidad continua del ventilador
+}
+
+// Interrupción de cada ranura de la ventana del calefactor
+ISR(TIMER2_COMPA_vect){
+	static uint8_t ranura = 0; // Ranura actual de la ventana
+	if (ranura < duty_calefactor) PORTB |= (1 << CALEFACTOR); // Encendido durante las primeras 'duty' ranuras
+	else PORTB &= ~(1 << CALEFACTOR); // Apagado el resto de la ventana
+	ranura++; // Al pasar de 255 a 0 empieza otra ventana
+}
 
 int main(void) { // Función principal del programa
 	char buffer[64]; // Buffer para almacenar mensajes formateados
 	char entrada[8]; // Buffer para capturar la entrada del usuario por UART
 	uint8_t idx = 0; // Índice para recorrer el arreglo de entrada
 
-	UART_INICIAR(MYUBRR); // Se inicializa la comunicación UART con el baudrate definido
-	ADC_INICIAR(); // Se inicializa el módulo ADC para la lectura de temperatura
-	PWM_INICIAR(64); // Se inicializa el módulo PWM con un prescaler de 64
-
 	DDRB |= (1 << CALEFACTOR) | (1 << ENABLE); // Se configuran los pines PB0 y PB1 como salidas
 	DDRD |= (1 << IN1) | (1 << IN2); // Se configuran los pines PD2 y PD3 como salidas
 
@@ -35,28 +166,68 @@ int main(void) { // Función principal del programa
 	PORTD &= ~((1 << IN1) | (1 << IN2)); // Se apagan ambas entradas del puente H
 	PORTB |=  (1 << ENABLE); // Se habilita el puente H
 
-	UART_IMPRIMIR("=== Control de Temperatura con PWM y Puente H ===\r\n"); // Se muestra el título del sistema
-	UART_IMPRIMIR("Presione 'x' para cambiar el punto medio\r\n"); // Se indica al usuario cómo modificar el punto medio
+	UART_INICIAR(MYUBRR); // Se inicializa la comunicación UART con el baudrate definido
+	PID_INICIAR(&pid, -255, 255, FILTRO_DERIVADA); // Salida de -255 (ventilador al máximo) a 255 (calefactor siempre encendido)
+	GANANCIAS_CARGAR(); // Se recuperan las ganancias guardadas
+
+	TCCR2A = (1 << WGM21); // Timer2 en modo CTC para la ventana del calefactor
+	TCCR2B = (1 << CS22) | (1 << CS21) | (1 << CS20); // Prescaler 1024
+	OCR2A = RANURA_CALEFACTOR; // Una ranura cada 3,9 ms
+	TIMSK2 = (1 << OCIE2A); // Se habilita la interrupción de comparación
+
+	ADC_INICIAR(); // Se inicializa el módulo ADC para la lectura de temperatura
+	PWM_TIMER_INICIAR(0, PWM_FASE_CORRECTA, FRECUENCIA_VENTILADOR); // Timer0 en phase correct sin prescaler: PWM de 31,4 kHz, fuera del rango audible
+	PWM_CANAL_INICIAR(PWM_OC0A, PWM_NORMAL); // Se conecta la salida OC0A (PD6) al puente H del ventilador
+	PWM_ESTABLECER_DUTY(0); // Ventilador detenido hasta la primera medición
+	const uint8_t canal_temp = 0; // Canal del sensor de temperatura
+	ADC_SOBREMUESTREO(0, BITS_EXTRA); // Cada disparo convierte una ráfaga de 16 muestras (1,7 ms) y publica su promedio en 12 bits
+	ADC_AL_COMPLETAR(CONTROLAR); // El PID corre con cada medición, dentro de la interrupción del ADC
+	ADC_ESCANEO_PERIODICO(&canal_temp, 1, ADC_DISPARO_TIMER1, FRECUENCIA_MUESTREO); // El Timer1 dispara una conversión exacta por período, independiente de la UART (habilita las interrupciones)
+
+	UART_IMPRIMIR("=== Control de Temperatura PID con PWM y Puente H ===\r\n"); // Se muestra el título del sistema
+	UART_IMPRIMIR("Presione 'x' para cambiar el punto medio, 'p', 'i' o 'd' para cambiar las ganancias\r\n"); // Se indica al usuario cómo modificar los parámetros
+	IMPRIMIR_GANANCIAS(buffer); // Se muestran las ganancias vigentes
 	UART_IMPRIMIR("-------------------------------------------------\r\n"); // Separador visual en la consola
 
 	while (1){ // Bucle principal del programa
 		if (UART_DISPONIBLE()){ // Si hay datos disponibles por UART
 			char t = UART_LEER(); // Se lee el carácter recibido
-			if (t == 'x' || t == 'X'){ // Si el usuario presiona 'x' o 'X'
+			if (!pausa && (t == 'x' || t == 'X')){ // Si el usuario presiona 'x' o 'X'
 				pausa = 1; // Se activa el modo pausa
+				ajuste = 'x'; // Se ingresa el punto medio
 				UART_IMPRIMIR("\r\n>> Ajuste de punto medio activado\r\n"); // Se notifica al usuario
 				UART_IMPRIMIR("Ingrese nuevo valor (10–50): "); // Se solicita un nuevo valor
 				idx = 0; // Se reinicia el índice de entrada
+				}else if (!pausa && (t == 'p' || t == 'P' || t == 'i' || t == 'I' || t == 'd' || t == 'D')){ // Si el usuario elige una ganancia
+				pausa = 1; // Se activa el modo pausa (el control sigue funcionando)
+				ajuste = t | 0x20; // Ganancia a ingresar, en minúscula
+				sprintf(buffer, "\r\n>> Ajuste de K%c activado\r\n", ajuste); // Se notifica al usuario
+				UART_IMPRIMIR(buffer); // Se envía la notificación
+				UART_IMPRIMIR("Ingrese nuevo valor (0–127.99): "); // Se solicita un nuevo valor
+				idx = 0; // Se reinicia el índice de entrada
 				}else if (pausa){ // Si el sistema está en modo pausa
 				if (t == '\r' || t == '\n'){ // Si el usuario presiona Enter
 					entrada[idx] = '\0'; // Se finaliza la cadena de entrada
-					int nuevo_pm = atoi(entrada); // Se convierte la cadena a número entero
-
-					if (nuevo_pm >= 10 && nuevo_pm <= 50){ // Si el valor ingresado está dentro del rango permitido
-						punto_medio = nuevo_pm; // Se actualiza el punto medio
-						UART_IMPRIMIR("\r\nPunto medio actualizado correctamente\r\n"); // Se confirma la actualización
-						}else{ // Si el valor está fuera del rango
-						UART_IMPRIMIR("\r\nValor fuera de rango (10–50)\r\n"); // Se notifica error
+					if (ajuste == 'x'){ // Punto medio
+						int nuevo_pm = atoi(entrada); // Se convierte la cadena a número entero
+						if (nuevo_pm >= 10 && nuevo_pm <= 50){ // Si el valor ingresado está dentro del rango permitido
+							punto_medio = nuevo_pm; // Se actualiza el punto medio
+							UART_IMPRIMIR("\r\nPunto medio actualizado correctamente\r\n"); // Se confirma la actualización
+							}else{ // Si el valor está fuera del rango
+							UART_IMPRIMIR("\r\nValor fuera de rango (10–50)\r\n"); // Se notifica error
+						}
+						}else{ // Ganancia
+						int16_t valor; // Ganancia en Q8.8
+						if (LEER_Q8_8(entrada, &valor)){ // Si el valor es válido
+							if (ajuste == 'p') ganancias.kp = valor; // Nueva Kp
+							else if (ajuste == 'i') ganancias.ki = valor; // Nueva Ki
+							else ganancias.kd = valor; // Nueva Kd
+							GANANCIAS_GUARDAR(); // Se aplica y se guarda en la EEPROM
+							UART_IMPRIMIR("\r\nGanancias actualizadas: "); // Se confirma la actualización
+							IMPRIMIR_GANANCIAS(buffer); // Se muestran las ganancias vigentes
+							}else{ // Si el valor no es válido
+							UART_IMPRIMIR("\r\nValor fuera de rango (0–127.99)\r\n"); // Se notifica error
+						}
 					}
 					pausa = 0; // Se desactiva el modo pausa
 					idx = 0; // Se reinicia el índice
@@ -69,58 +240,14 @@ int main(void) { // Función principal del programa
 			}
 		}
 
-		if(!pausa){ // Si el sistema no está en modo pausa
-			uint16_t adc_val = ADC_LEER_CANAL(0); // Se lee el valor analógico del canal 0 (sensor de temperatura)
-			uint16_t tempC = (adc_val * 500UL) / 1023UL; // Se convierte el valor ADC a grados Celsius (escala 0–500 mV)
-
-			int16_t lim_calef      = punto_medio - 4; // Límite inferior para encender el calefactor
-			int16_t lim_neutro_min = punto_medio - 3; // Límite inferior de la zona neutra
-			int16_t lim_neutro_max = punto_medio + 4; // Límite superior de la zona neutra
-			int16_t lim_vlow_min   = punto_medio + 5; // Límite inferior para ventilador en velocidad baja
-			int16_t lim_vlow_max   = punto_medio + 14; // Límite superior para ventilador en velocidad baja
-			int16_t lim_vmed_min   = punto_medio + 15; // Límite inferior para ventilador en velocidad media
-			int16_t lim_vmed_max   = punto_medio + 24; // Límite superior para ventilador en velocidad media
-			int16_t lim_valt_min   = punto_medio + 25; // Límite inferior para ventilador en velocidad alta
-
-			const char *accion = "Ninguna"; // Se inicializa la variable de texto para mostrar la acción actual
-
-			if(tempC <= lim_calef){ // Si la temperatura está por debajo del rango de calefacción
-				PORTB |=  (1 << CALEFACTOR); // Se enciende el calefactor
-				PORTD &= ~((1 << IN1) | (1 << IN2)); // Se detiene el ventilador
-				PWM_ESTABLECER_DUTY(0); // Se establece el duty cycle del PWM en 0
-				accion = "Calefactor ON"; // Se actualiza la acción actual
-				}else if(tempC >= lim_neutro_min && tempC <= lim_neutro_max){ // Si la temperatura está dentro del rango neutro
-				PORTB &= ~(1 << CALEFACTOR); // Se apaga el calefactor
-				PORTD &= ~((1 << IN1) | (1 << IN2)); // Se apaga el ventilador
-				PWM_ESTABLECER_DUTY(0); // Duty cycle 0%
-				accion = "Todo OFF"; // Se indica que todo está apagado
-				}else if(tempC >= lim_vlow_min && tempC <= lim_vlow_max){ // Si la temperatura está entre los límites de velocidad baja
-				PORTB &= ~(1 << CALEFACTOR); // Se apaga el calefactor
-				PORTD |=  (1 << IN1); // Se activa IN1 para girar el ventilador en un sentido
-				PORTD &= ~(1 << IN2); // Se mantiene IN2 apagado
-				PWM_ESTABLECER_DUTY(85); // Se ajusta el PWM a velocidad baja (~33%)
-				accion = "Ventilador BAJO"; // Se actualiza la acción
-				}else if(tempC >= lim_vmed_min && tempC <= lim_vmed_max){ // Si la temperatura está entre los límites de velocidad media
-				PORTB &= ~(1 << CALEFACTOR); // Se apaga el calefactor
-				PORTD |=  (1 << IN1); // Se activa el pin IN1
-				PORTD &= ~(1 << IN2); // Se apaga IN2
-				PWM_ESTABLECER_DUTY(170); // Se ajusta el PWM a velocidad media (~66%)
-				accion = "Ventilador MEDIO"; // Se actualiza la acción
-				}else if(tempC >= lim_valt_min){ // Si la temperatura está por encima del límite superior
-				PORTB &= ~(1 << CALEFACTOR); // Se apaga el calefactor
-				PORTD |=  (1 << IN1); // Se activa el ventilador en el mismo sentido
-				PORTD &= ~(1 << IN2); // Se mantiene el otro pin apagado
-				PWM_ESTABLECER_DUTY(255); // Se establece el PWM en 100% de velocidad
-				accion = "Ventilador ALTO"; // Se actualiza la acción
-				}else{ // En cualquier otro caso (seguridad)
-				PORTB &= ~(1 << CALEFACTOR); // Se apaga el calefactor
-				PORTD &= ~((1 << IN1) | (1 << IN2)); // Se detiene el ventilador
-				PWM_ESTABLECER_DUTY(0); // Duty cycle 0%
-				accion = "Todo OFF"; // Se indica que todo está apagado
-			}
-			sprintf(buffer, "Temp:%uC | PM:%u | %s\r\n", tempC, punto_medio, accion); // Se formatea el mensaje con temperatura, punto medio y acción
+		if(ADC_CONJUNTO_LISTO() && !pausa){ // Si el Timer1 disparó una nueva medición (el PID ya la procesó) y no se está ingresando un valor
+			uint16_t adc_val = ADC_ULTIMO(0); // Se toma la muestra de 12 bits del canal 0 (sensor de temperatura)
+			uint32_t temp_q = TEMP_Q8_8(adc_val); // Se convierte a grados Celsius en Q8.8 sin divisiones
+			uint16_t tempC = (uint16_t)(temp_q >> 8); // Parte entera
+			uint8_t centesimas = ((temp_q & 0xFF) * 100U) >> 8; // Parte decimal en centésimas para mostrar
+			if (falla_sensor) UART_IMPRIMIR("Falla del sensor: calefactor y ventilador apagados | "); // Se avisa antes de la lectura
+			sprintf(buffer, "Temp:%u.%02uC | PM:%u | Calef:%u | Vent:%u\r\n", tempC, centesimas, punto_medio, duty_calefactor, duty_ventilador); // Se formatea el mensaje con temperatura (con decimales), punto medio y salidas del PID
 			UART_IMPRIMIR(buffer); // Se envía la información al puerto serial
-			_delay_ms(1000); // Se espera 1 segundo antes de la siguiente lectura
 		}
 	}
 }
@@ -6,11 +6,16 @@ import re  # Se importa la librería 're' para utilizar expresiones regulares en
 PUERTO = 'COM5'  # Se define el puerto serie donde está conectado el microcontrolador
 BAUDRATE = 9600  # Se define la velocidad de comunicación en baudios
 TIEMPO_MUESTREO = 0.1  # Se define el intervalo de muestreo (en segundos) entre cada lectura
+UMBRAL_ESCALON = 40  # Cambio mínimo de la referencia entre dos informes (en cuentas del ADC) que se considera un escalón
+BANDA = 10  # Error (en cuentas del ADC, ~1 %) por debajo del cual se considera que el motor llegó a la posición
 
 ser = serial.Serial(PUERTO, BAUDRATE, timeout=1)  # Se inicializa la comunicación serie con los parámetros definidos
 time.sleep(2)  # Se espera 2 segundos para permitir que el microcontrolador se reinicie y estabilice la conexión
 
 refs, acts, pwms, tiempos, sentidos = [], [], [], [], []  # Se inicializan listas vacías para almacenar los datos recibidos: referencias, valores actuales, PWM, tiempos y sentido de giro
+escalon = None  # Instante y amplitud del escalón de referencia que todavía no se asentó
+asentamientos = []  # Tiempos de asentamiento medidos (en segundos, con la resolución de un informe: 200 ms)
+errores_reposo = []  # Errores |ref - act| medidos con el motor ya asentado
 
 plt.ion()  # Se habilita el modo interactivo de matplotlib para actualizar la gráfica en tiempo real
 fig, ax = plt.subplots(figsize=(8,4))  # Se crea una figura y un eje con tamaño 8x4 pulgadas
@@ -57,6 +62,16 @@ try:
 
                 plt.pause(0.001)  # Se actualiza la gráfica con una pequeña pausa para refrescar la visualización
 
+                # Se miden el tiempo de asentamiento de cada escalón de la referencia y el error de posición en reposo
+                if len(refs) > 1 and abs(ref - refs[-2]) >= UMBRAL_ESCALON:  # La referencia cambió bruscamente
+                    escalon = (t, abs(ref - refs[-2]))  # Se empieza (o se reinicia) la medición del escalón
+                elif escalon is not None and abs(ref - act) <= BANDA:  # El motor entró en la banda después del escalón
+                    asentamientos.append(t - escalon[0])  # Se guarda el tiempo de asentamiento
+                    print(f"Escalon de {escalon[1]} cuentas: asentamiento = {t - escalon[0]:.1f} s")
+                    escalon = None  # Se espera el próximo escalón
+                elif escalon is None:  # Motor asentado y referencia quieta
+                    errores_reposo.append(abs(ref - act))  # Se acumula el error de posición
+
                 # Se imprime en consola el valor de cada parámetro recibido
                 print(f"Potenciometro 1={ref:4d} | Potenciometro 2={act:4d} | PWM={pwm:3d} | Estado={sentido}")
 
@@ -64,6 +79,10 @@ try:
 
 except KeyboardInterrupt:  # Si el usuario interrumpe el programa con Ctrl+C
     print("\nLectura finalizada por el usuario.")  # Se muestra un mensaje indicando la finalización manual
+    if asentamientos:  # Se resumen los tiempos de asentamiento
+        print(f"Escalones={len(asentamientos)} | Asentamiento medio={sum(asentamientos) / len(asentamientos):.2f} s | Maximo={max(asentamientos):.2f} s")
+    if errores_reposo:  # Se resume el error de posición en reposo
+        print(f"Error en reposo: medio={sum(errores_reposo) / len(errores_reposo):.1f} cuentas | maximo={max(errores_reposo)} cuentas")
 
 finally:
     ser.close()  # Se cierra el puerto serie para liberar el recurso
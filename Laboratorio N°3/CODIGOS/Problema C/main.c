@@ -2,99 +2,135 @@
 
 #include <avr/io.h> // Librería principal para el manejo de registros de entrada/salida del microcontrolador
 #include <util/delay.h> // Librería para generar retardos precisos en milisegundos
+#include <avr/interrupt.h> // Librería para cli()/sei() al compartir variables con la interrupción del ADC
 #include <stdlib.h> // Librería estándar con funciones generales (como abs(), rand(), etc.)
 #include <stdio.h> // Librería para formateo de cadenas (sprintf)
 #include "uart.h" // Librería personalizada para comunicación serial UART
 #include "adc.h" // Librería personalizada para manejo del conversor analógico-digital (ADC)
+#include "filtros.h" // Librería personalizada de filtros digitales en punto fijo
+#include "pwm.h" // Librería personalizada de PWM (modo motor en Timer1)
 
 #define BAUD 9600 // Se define la velocidad de transmisión UART en 9600 baudios
 #define MYUBRR (F_CPU / 16 / BAUD - 1) // Se calcula el valor del registro UBRR para configurar la UART
 
 #define IN1 PB0 // Pin PB0 asignado al control de dirección del motor (entrada 1 del puente H)
 #define IN2 PB1 // Pin PB1 asignado al control de dirección del motor (entrada 2 del puente H)
-#define PWM PD6 // Pin PD6 asignado como salida PWM (OC0A) para control de velocidad
+#define PWM PB2 // Pin PB2 asignado como salida PWM (OC1B) para control de velocidad (PWM ultrasónico de 20 kHz)
 
 // Prototipos de funciones
-void PWM_INICIAR(void); // Inicializa el módulo PWM
-void PWM_SETEAR(uint8_t value); // Ajusta el ciclo de trabajo del PWM
 void MOTOR(int16_t error); // Controla la dirección y velocidad del motor según el error
+void CONTROL(void); // Ejecuta un ciclo de control con el conjunto de muestras recién convertido
+void CAPTURA(uint8_t canal); // Captura una ráfaga rápida de un canal y la envía a visor_captura.py
 
 // Constantes del control proporcional
-#define KP 0.35f // Constante proporcional (ganancia P)
-#define PWM_MIN 80 // Valor mínimo de PWM para superar la inercia del motor
+#define KP 525 // Constante proporcional en Q8.8 (2,05) en unidades del comando de 10 bits (misma pendiente que la anterior 0,35 sobre 255 desde PWM_MIN 80)
+#define PWM_MINIMO 125 // Comparación mínima que mantiene al motor girando (31 % de PWM_MOTOR_TOPE, el anterior PWM_MIN 80 de 255)
+#define PWM_ARRANQUE 160 // Comparación para vencer la fricción estática al arrancar desde detenido (40 %)
 #define DEAD_ERR 1 // Zona muerta: error mínimo para considerar el motor detenido
+#define FRECUENCIA_CONTROL 100 // Frecuencia del lazo de control en Hz (el Timer0 de 8 bits no llega a 50 Hz; 156 cuentas con prescaler 1024)
+#define CICLOS_INFORME 20 // Ciclos de control entre impresiones (200 ms)
 
-void PWM_INICIAR(void) {
-	DDRD |= (1 << PWM); // Configura el pin PD6 como salida (canal OC0A)
-	TCCR0A = (1 << COM0A1) | (1 << WGM00) | (1 << WGM01); // Configura el Timer0 en modo Fast PWM, salida no inversora
-	TCCR0B = (1 << CS01) | (1 << CS00); // Selecciona prescaler 64 → frecuencia PWM ≈ 1 kHz (según F_CPU)
-}
+static volatile uint16_t ref, act; // Últimas lecturas de referencia (setpoint) y valor actual usadas por el control
+static volatile int16_t error_actual; // Última diferencia entre ref y act
+static volatile uint8_t ciclos = 0; // Cantidad de ciclos de control desde la última impresión
+static FILTRO_MEDIANA3 mediana_ref, mediana_act; // Medianas de 3 muestras que eliminan picos de los cursores de los potenciómetros
+static const uint8_t canales[] = {0, 1}; // Canales a escanear: referencia (posición 0) y valor actual (posición 1)
 
-void PWM_SETEAR(uint8_t value) {
-	OCR0A = value; // Carga el valor del ciclo de trabajo (duty cycle) en el registro OCR0A
-}
+// Captura rápida (osciloscopio por software)
+#define CAPTURA_TAM 512 // Muestras por captura (potencia de 2): 6,7 ms a 76,9 kmuestras/s
+#define CAPTURA_UBRR 1 // UBRR para 500 kbaud exactos durante el volcado binario
+static uint8_t captura[CAPTURA_TAM]; // Buffer de la captura
 
 void MOTOR(int16_t error) {
 	int16_t abs_err = (error >= 0) ? error : -error; // Calcula el valor absoluto del error
 
 	if (abs_err > DEAD_ERR) { // Si el error supera la zona muerta
-		float pwm_f = PWM_MIN + (KP * abs_err); // Calcula el valor PWM proporcional al error
-		if (pwm_f > 255.0f) pwm_f = 255.0f; // Limita el valor máximo del PWM a 255
-		uint8_t pwm = (uint8_t)pwm_f; // Convierte el valor flotante a entero
+		uint32_t comando = ((uint32_t)abs_err * KP) >> 8; // Calcula el comando proporcional al error en enteros, sin punto flotante dentro de la interrupción (la librería le suma el mínimo que vence la fricción)
+		if (comando > PWM_MOTOR_MAXIMO) comando = PWM_MOTOR_MAXIMO; // Limita el comando al máximo de 10 bits
+		uint16_t pwm = (uint16_t)comando; // Comando de 10 bits
 
 		if (error > 0) { // Si el error es positivo → el valor real es menor que el de referencia
 			PORTB |= (1 << IN1); // Activa IN1
 			PORTB &= ~(1 << IN2); // Desactiva IN2 → Gira en sentido horario
-			PWM_SETEAR(pwm); // Ajusta la velocidad según el valor PWM calculado
+			PWM_MOTOR(PWM_OC1B, pwm); // Ajusta la velocidad según el comando calculado
 		} else { // Si el error es negativo → el valor real es mayor que el de referencia
 			PORTB |= (1 << IN2); // Activa IN2
 			PORTB &= ~(1 << IN1); // Desactiva IN1 → Gira en sentido antihorario
-			PWM_SETEAR(pwm); // Ajusta la velocidad
+			PWM_MOTOR(PWM_OC1B, pwm); // Ajusta la velocidad
 		}
 	} else { // Si el error está dentro de la zona muerta → se detiene el motor
 		PORTB &= ~((1 << IN1) | (1 << IN2)); // Desactiva ambas entradas del puente H
-		PWM_SETEAR(0); // Aplica 0% de ciclo útil → sin movimiento
+		PWM_MOTOR(PWM_OC1B, 0); // Aplica 0% de ciclo útil → sin movimiento
 	}
 }
 
+void CONTROL(void) { // Se llama desde la interrupción del ADC cada vez que el Timer0 completa un conjunto de muestras
+	ref = FILTRO_MEDIANA3_ACTUALIZAR(&mediana_ref, ADC_ULTIMO(0)); // Muestra filtrada del valor de referencia (potenciómetro de entrada)
+	act = FILTRO_MEDIANA3_ACTUALIZAR(&mediana_act, ADC_ULTIMO(1)); // Muestra filtrada del valor actual (potenciómetro acoplado al motor)
+	error_actual = (int16_t)ref - (int16_t)act; // Cálculo del error como diferencia entre ambos valores
+	MOTOR(error_actual); // Controla el motor según el error calculado
+	ciclos++; // Se cuenta el ciclo para la impresión periódica
+}
+
+void CAPTURA(uint8_t canal) {
+	ADC_CAPTURA cfg = {canal, ADC_CAP_DIV16, ADC_CAP_SUBIDA, 128, CAPTURA_TAM / 8, 65535UL}; // Flanco de subida en media escala, 1/8 de muestras previas y espera máxima de ~0,85 s
+	uint16_t inicio; // Posición de la muestra más antigua
+	ADC_ESCANEO_DETENER(); // Se detiene el lazo de control: ya no llegan conjuntos nuevos a CONTROL
+	MOTOR(0); // Se detiene el motor, porque sin lazo quedaría con el último PWM hasta ~0,85 s
+	uint8_t disparado = ADC_CAPTURAR(captura, CAPTURA_TAM, &cfg, &inicio); // Se captura con las interrupciones deshabilitadas
+	ADC_ESCANEO_PERIODICO(canales, 2, ADC_DISPARO_TIMER0, FRECUENCIA_CONTROL); // Se retoma el lazo de control, que vuelve a mover el motor desde el próximo conjunto
+
+	UART_IMPRIMIR("CAPTURA\r\n"); // Se avisa al visor que cambie a la velocidad del volcado
+	_delay_ms(50); // Tiempo para que el visor cambie de velocidad
+	UART_INICIAR(CAPTURA_UBRR); // Se pasa a 500 kbaud
+	ADC_VOLCAR(captura, CAPTURA_TAM, inicio, &cfg, disparado, UART_ENVIAR); // Se envía la captura en binario (~10 ms)
+	_delay_ms(1); // Se espera a que salga el último byte
+	UART_INICIAR(MYUBRR); // Se vuelve a la velocidad normal
+}
+
 int main(void) {
 	UART_INICIAR(MYUBRR); // Inicializa la comunicación serial UART
 	ADC_INICIAR(); // Inicializa el módulo ADC para lectura de potenciómetros
-	PWM_INICIAR(); // Inicializa el módulo PWM para control del motor
+	PWM_MOTOR_INICIAR(PWM_OC1B, PWM_MINIMO, PWM_ARRANQUE); // Timer1 en phase correct a 20 kHz sobre OC1B para control del motor
 	DDRB |= (1 << IN1) | (1 << IN2); // Configura los pines de dirección del motor como salidas
+	FILTRO_MEDIANA3_INICIAR(&mediana_ref, ADC_LEER_CANAL(0)); // Se cargan las medianas con una lectura inicial para evitar el transitorio
+	FILTRO_MEDIANA3_INICIAR(&mediana_act, ADC_LEER_CANAL(1)); // Ídem para el valor actual
+	ADC_AL_COMPLETAR(CONTROL); // El control se ejecuta apenas se completa cada conjunto de muestras
+	ADC_ESCANEO_PERIODICO(canales, 2, ADC_DISPARO_TIMER0, FRECUENCIA_CONTROL); // El Timer0 dispara el muestreo a frecuencia fija, sin depender del bucle ni de la UART
 
 	char buffer[64]; // Buffer para almacenar los mensajes a enviar por UART
-	uint16_t ref, act; // Variables para la lectura de referencia (setpoint) y valor actual
-	int16_t error; // Variable para almacenar la diferencia entre ref y act
-	uint8_t pwm; // Variable para almacenar el valor actual del PWM
+	uint16_t r, a; // Copias de la referencia y del valor actual para imprimir
+	int16_t e; // Copia del error para imprimir
+	uint16_t pwm; // Variable para almacenar el valor actual del PWM (0 a PWM_MOTOR_TOPE)
 	char *sentido; // Puntero a texto descriptivo del sentido de giro
-	uint16_t contador = 0; // Contador para limitar la frecuencia de impresión UART
 
 	UART_IMPRIMIR("\r\n=== Control de potenciometro con motor PWM ===\r\n"); // Mensaje inicial de bienvenida
 
-	while (1) { // Bucle principal de ejecución continua
-		ref = ADC_LEER_CANAL(0); // Lectura del valor de referencia (potenciómetro de entrada)
-		act = ADC_LEER_CANAL(1); // Lectura del valor actual (potenciómetro acoplado al motor)
-		error = (int16_t)ref - (int16_t)act; // Cálculo del error como diferencia entre ambos valores
+	while (1) { // Bucle principal de ejecución continua: solo informa, el control corre en la interrupción
+		if (UART_DISPONIBLE() && UART_LEER() == 'c') { // Comando de captura: 'c' seguido del número de canal
+			char c = UART_LEER(); // Se espera el número de canal
+			if (c >= '0' && c <= '7') CAPTURA(c - '0'); // Se captura el canal pedido
+			continue; // Se vuelve al inicio del bucle
+		}
+		if (ciclos < CICLOS_INFORME) continue; // Se envían los datos por UART cada CICLOS_INFORME ciclos de control (200 ms)
 
-		MOTOR(error); // Controla el motor según el error calculado
-		pwm = OCR0A; // Lee el valor actual del PWM aplicado al motor
+		cli(); // Se copian las variables compartidas con la interrupción de forma atómica
+		r = ref; // Copia de la referencia
+		a = act; // Copia del valor actual
+		e = error_actual; // Copia del error
+		pwm = OCR1B; // Lee el valor actual del PWM aplicado al motor
+		ciclos = 0; // Reinicia el contador
+		sei(); // Se vuelven a habilitar las interrupciones
 
 		int16_t tolerancia = 25; // Define una tolerancia para determinar el estado de movimiento
-		if (error > tolerancia)
+		if (e > tolerancia)
 			sentido = "Horario"; // Si el error es positivo → motor gira en sentido horario
-		else if (error < -tolerancia)
+		else if (e < -tolerancia)
 			sentido = "Antihorario"; // Si el error es negativo → motor gira en sentido antihorario
 		else
 			sentido = "Detenido"; // Si el error está dentro del rango → el motor está quieto
 
-		contador++; // Incrementa el contador de ciclos
-		if (contador >= 10) { // Envía los datos por UART cada 10 iteraciones
-			sprintf(buffer, "Ref:%u | Act:%u | PWM:%u | Sent:%s\r\n", ref, act, pwm, sentido); // Formatea los datos
-			UART_IMPRIMIR(buffer); // Envía el mensaje al monitor serial
-			contador = 0; // Reinicia el contador
-		}
-
-		_delay_ms(30); // Pequeño retardo para estabilidad del bucle y del ADC
+		sprintf(buffer, "Ref:%u | Act:%u | PWM:%u | Sent:%s\r\n", r, a, pwm, sentido); // Formatea los datos
+		UART_IMPRIMIR(buffer); // Envía el mensaje al monitor serial
 	}
 }
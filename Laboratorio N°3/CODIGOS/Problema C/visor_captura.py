@@ -0,0 +1,83 @@
+import serial  # Se importa la librería 'serial' para establecer comunicación por puerto serie con el microcontrolador
+import matplotlib.pyplot as plt  # Se importa la librería 'matplotlib' para graficar las capturas
+import time  # Se importa la librería 'time' para manejar tiempos de espera
+
+PUERTO = 'COM5'  # Se define el puerto serie donde está conectado el microcontrolador
+BAUDRATE = 9600  # Se define la velocidad normal de comunicación en baudios
+BAUDRATE_VOLCADO = 500000  # Se define la velocidad del volcado binario (CAPTURA_UBRR = 1 en el microcontrolador)
+F_CPU = 16000000  # Se define la frecuencia del microcontrolador para calcular la frecuencia de muestreo
+VREF = 5.0  # Se define la tensión de referencia del ADC (AVCC)
+
+
+def capturar(ser, canal):  # Se pide una captura del canal indicado y se devuelven sus datos
+    ser.reset_input_buffer()  # Se descartan los mensajes de control pendientes
+    ser.write(f"c{canal}".encode())  # Se envía el comando de captura
+    limite = time.time() + 3.0  # Se establece un tiempo máximo de espera (incluye la espera del disparo)
+    while time.time() < limite:  # Se espera el aviso de volcado
+        if b"CAPTURA" in ser.readline():  # El microcontrolador avisa antes de cambiar de velocidad
+            break
+    else:
+        return None  # No llegó el aviso
+
+    ser.baudrate = BAUDRATE_VOLCADO  # Se cambia a la velocidad del volcado
+    try:
+        encabezado = ser.read(9)  # "CAP", divisor, tamaño, previas y disparo
+        if len(encabezado) != 9 or encabezado[:3] != b"CAP":  # Se verifica la marca de inicio
+            return None
+        divisor = encabezado[3]  # Divisor del reloj del ADC
+        tam = encabezado[4] | (encabezado[5] << 8)  # Cantidad de muestras
+        previas = encabezado[6] | (encabezado[7] << 8)  # Posición de la muestra de disparo
+        disparado = encabezado[8]  # Indica si hubo disparo
+        muestras = ser.read(tam)  # Se leen las muestras
+        suma = ser.read(1)  # Se lee la suma de verificación
+        if len(muestras) != tam or len(suma) != 1 or (sum(muestras) & 0xFF) != suma[0]:  # Se verifica la captura
+            return None
+    finally:
+        ser.baudrate = BAUDRATE  # Se vuelve siempre a la velocidad normal
+
+    fs = F_CPU / (divisor * 13)  # Frecuencia de muestreo: 13 ciclos de ADC por conversión
+    return fs, previas, disparado, list(muestras)
+
+
+ser = serial.Serial(PUERTO, BAUDRATE, timeout=1)  # Se inicializa la comunicación serie con los parámetros definidos
+time.sleep(2)  # Se espera 2 segundos para permitir que el microcontrolador se reinicie y estabilice la conexión
+
+plt.ion()  # Se habilita el modo interactivo de matplotlib
+fig, ax = plt.subplots(figsize=(8, 4))  # Se crea una figura y un eje con tamaño 8x4 pulgadas
+
+try:
+    while True:  # Se repiten capturas a pedido del usuario
+        entrada = input("Canal a capturar (0-7, Enter = 1, 'q' para salir): ").strip()  # Se pide el canal
+        if entrada.lower() == 'q':  # Se sale con 'q'
+            break
+        canal = int(entrada) if entrada.isdigit() else 1  # Canal por defecto: potenciómetro del motor
+
+        resultado = capturar(ser, canal)  # Se realiza la captura
+        if resultado is None:  # Si la captura falló
+            print("Captura inválida, intente nuevamente")
+            continue
+        fs, previas, disparado, muestras = resultado  # Se separan los datos
+
+        tiempos = [(n - previas) / fs * 1e6 for n in range(len(muestras))]  # Tiempo de cada muestra en µs (0 = disparo)
+        voltajes = [m * VREF / 256 for m in muestras]  # Tensión de cada muestra (8 bits)
+
+        ax.clear()  # Se borra la captura anterior
+        ax.plot(tiempos, voltajes, 'b-', label=f'Canal {canal}')  # Se grafica la forma de onda
+        ax.axvline(0, color='r', linestyle='--', label='Disparo' if disparado else 'Sin disparo')  # Se marca el instante de disparo
+        ax.set_xlabel('Tiempo [µs]')  # Se etiqueta el eje X
+        ax.set_ylabel('Tensión [V]')  # Se etiqueta el eje Y
+        ax.set_ylim(0, VREF)  # Se fija el rango del ADC
+        ax.set_title(f'{len(muestras)} muestras a {fs / 1000:.1f} kmuestras/s')  # Se muestran los datos de la captura
+        ax.legend(loc='upper right')  # Se coloca la leyenda
+        ax.grid(True)  # Se activa la cuadrícula
+        plt.pause(0.001)  # Se actualiza la gráfica
+
+        print(f"Muestras={len(muestras)} | Fs={fs:.0f} Hz | Min={min(voltajes):.2f} V | Max={max(voltajes):.2f} V | Disparo={'SI' if disparado else 'NO'}")
+
+except KeyboardInterrupt:  # Si el usuario interrumpe el programa con Ctrl+C
+    print("\nVisor finalizado por el usuario.")  # Se muestra un mensaje indicando la finalización manual
+
+finally:
+    ser.close()  # Se cierra el puerto serie para liberar el recurso
+    plt.ioff()  # Se desactiva el modo interactivo de matplotlib
+    plt.show()  # Se mantiene visible la última captura al finalizar el programa
@@ -0,0 +1,127 @@
+import serial  # Se importa la librería 'serial' para establecer comunicación por puerto serie con el microcontrolador
+import time  # Se importa la librería 'time' para medir los cuadros por segundo
+import math  # Se importa la librería 'math' para generar la animación de prueba
+
+PUERTO = 'COM5'  # Se define el puerto serie donde está conectado el microcontrolador
+BAUDRATE = 1000000  # Se define la velocidad del modo en vivo (FLUJO_UBRR = 0 en el microcontrolador)
+ANCHO, ALTO = 8, 8  # Se define el tamaño de la matriz (WS2812_ANCHO x WS2812_ALTO)
+NUM_LEDS = ANCHO * ALTO  # Se calcula la cantidad de LEDs
+TIEMPO_ESPERA = 0.2  # Se define el tiempo máximo (en segundos) a esperar la confirmación de cada cuadro
+SILENCIO = 0.03  # Se define una pausa mayor a FLUJO_SILENCIO_MS para que el microcontrolador descarte un cuadro cortado
+
+SINCRONISMO = 0xA5  # Byte de inicio de cuadro (FLUJO_SINCRONISMO)
+CRUDO, RLE, DELTA = 0, 1, 2  # Tipos de cuadro (FLUJO_CRUDO, FLUJO_RLE, FLUJO_DELTA)
+LISTO, RECHAZO = 0x06, 0x15  # Respuestas del microcontrolador (FLUJO_LISTO, FLUJO_RECHAZO)
+
+
+def codificar_crudo(cuadro):  # Se devuelven los datos del cuadro sin compresión
+    return bytes(b for pixel in cuadro for b in pixel)  # Se concatenan los 3 bytes de cada píxel
+
+
+def codificar_rle(cuadro):  # Se agrupan los píxeles consecutivos del mismo color en grupos [n - 1, G, R, B]
+    datos = bytearray()  # Se inicializan los datos codificados
+    i = 0  # Se empieza por el primer píxel
+    while i < len(cuadro):  # Se recorre todo el cuadro
+        n = 1  # Largo de la corrida actual
+        while i + n < len(cuadro) and n < 256 and cuadro[i + n] == cuadro[i]:
+            n += 1  # Se extiende la corrida mientras el color se repita (máximo 256)
+        datos += bytes([n - 1, *cuadro[i]])  # Se agrega el grupo de la corrida
+        i += n  # Se salta al primer píxel de la próxima corrida
+    return bytes(datos)
+
+
+def codificar_delta(cuadro, anterior):  # Se envían solo los píxeles que cambiaron, en grupos [salto, n, píxeles]
+    datos = bytearray()  # Se inicializan los datos codificados
+    i = 0  # Se empieza por el primer píxel
+    while i < len(cuadro):  # Se recorre todo el cuadro
+        salto = 0  # Píxeles iguales al cuadro anterior
+        while i < len(cuadro) and salto < 255 and cuadro[i] == anterior[i]:  # Se cuentan los píxeles que no cambiaron
+            salto += 1  # Se cuenta el píxel igual
+            i += 1  # Se avanza al siguiente
+        if i == len(cuadro):  # Si no quedan cambios no hace falta otro grupo
+            break  # Se termina la codificación
+        n = 0  # Píxeles distintos al cuadro anterior
+        while i + n < len(cuadro) and n < 255 and cuadro[i + n] != anterior[i + n]:  # Se cuentan los píxeles que cambiaron
+            n += 1  # Se cuenta el píxel distinto
+        datos += bytes([salto, n])  # Se agrega el encabezado del grupo
+        for pixel in cuadro[i:i + n]:  # Se agregan los píxeles nuevos
+            datos += bytes(pixel)
+        i += n  # Se avanza después de los píxeles enviados
+    return bytes(datos)  # Se devuelven los datos codificados
+
+
+def armar_paquete(tipo, datos):  # Se agrega el encabezado y el checksum que deja la suma en 0
+    encabezado = bytes([tipo, len(datos) & 0xFF, len(datos) >> 8])  # Tipo y largo en little endian
+    suma = sum(encabezado) + sum(datos)  # Suma de todos los bytes verificados
+    return bytes([SINCRONISMO]) + encabezado + datos + bytes([(-suma) & 0xFF])  # Paquete completo listo para enviar
+
+
+def codificar(cuadro, anterior):  # Se elige la codificación más corta para el cuadro
+    opciones = [(CRUDO, codificar_crudo(cuadro)), (RLE, codificar_rle(cuadro))]  # Codificaciones siempre posibles
+    if anterior is not None:  # El delta solo es posible si el microcontrolador ya muestra un cuadro conocido
+        opciones.append((DELTA, codificar_delta(cuadro, anterior)))
+    tipo, datos = min(opciones, key=lambda o: len(o[1]))  # Se queda con la opción de menos bytes
+    return tipo, armar_paquete(tipo, datos)
+
+
+def generar_cuadro(t):  # Se genera un cuadro de prueba: arcoíris que se desplaza y un punto blanco que rebota
+    cuadro = []  # Lista de píxeles en orden lógico (fila por fila)
+    for y in range(ALTO):  # Se recorren las filas
+        for x in range(ANCHO):  # Se recorren las columnas
+            fase = (x + y) / (ANCHO + ALTO) * 2 * math.pi + t * 3  # Fase del arcoíris según la diagonal y el tiempo
+            r = int(20 + 20 * math.sin(fase))
+            g = int(20 + 20 * math.sin(fase + 2.094))
+            b = int(20 + 20 * math.sin(fase + 4.189))  # Componentes desfasadas 120° entre sí
+            cuadro.append((g, r, b))  # Se guarda en orden G, R, B como lo espera el buffer del microcontrolador
+    px = int((math.sin(t * 2.3) + 1) / 2 * (ANCHO - 1) + 0.5)
+    py = int((math.sin(t * 1.7) + 1) / 2 * (ALTO - 1) + 0.5)  # Posición del punto que rebota
+    cuadro[py * ANCHO + px] = (80, 80, 80)  # Se dibuja el punto blanco
+    return cuadro  # Se devuelve el cuadro generado
+
+
+if __name__ == '__main__':
+    ser = serial.Serial(PUERTO, BAUDRATE, timeout=TIEMPO_ESPERA)  # Se inicializa la comunicación serie a la velocidad del modo en vivo
+    print("Esperando al microcontrolador (mantener el botón presionado al encender)...")  # Se indica cómo entrar al modo en vivo
+
+    while ser.read(1) != bytes([LISTO]):  # Se espera el primer pedido de cuadro (se ignora el mensaje de texto previo)
+        pass
+
+    anterior = None  # Último cuadro confirmado (el que está mostrando la matriz)
+    cuadros = rechazos = bytes_enviados = 0  # Contadores totales
+    usos = {CRUDO: 0, RLE: 0, DELTA: 0}  # Cantidad de cuadros enviados con cada codificación
+    t0 = t_informe = time.time()  # Tiempos de referencia
+    cuadros_informe = 0  # Cuadros confirmados desde el último informe
+    print("Enviando cuadros... (Ctrl+C para detener)\n")  # Se indica el inicio de la transmisión
+
+    try:
+        while True:
+            cuadro = generar_cuadro(time.time() - t0)  # Se genera el cuadro correspondiente al instante actual
+            tipo, paquete = codificar(cuadro, anterior)  # Se codifica con la opción más corta
+            ser.write(paquete)  # Se envía el cuadro completo (el microcontrolador ya avisó que puede recibirlo)
+            respuesta = ser.read(1)  # Se espera la confirmación que llega después de WS2812_MOSTRAR
+            if respuesta == bytes([LISTO]):  # El cuadro se mostró
+                anterior = cuadro  # Pasa a ser la base de los cuadros delta
+                cuadros += 1  # Se cuenta el cuadro total
+                cuadros_informe += 1  # Se cuenta el cuadro del intervalo
+                bytes_enviados += len(paquete)  # Se acumulan los bytes enviados
+                usos[tipo] += 1  # Se cuenta la codificación usada
+            else:  # El cuadro se rechazó o no hubo respuesta
+                rechazos += 1  # Se cuenta el rechazo
+                anterior = None  # Sin confirmación no se sabe qué muestra la matriz, el próximo cuadro no puede ser delta
+                time.sleep(SILENCIO)  # Se deja pasar el tiempo de silencio para que el decodificador se reinicie
+                ser.reset_input_buffer()  # Se descartan respuestas atrasadas antes de reenviar
+
+            ahora = time.time()  # Se toma el tiempo actual
+            if ahora - t_informe >= 1.0:  # Se informa una vez por segundo
+                fps = cuadros_informe / (ahora - t_informe)  # Cuadros por segundo del último intervalo
+                promedio = bytes_enviados / cuadros if cuadros else 0  # Tamaño promedio de los paquetes
+                print(f"FPS={fps:6.1f} | Bytes/cuadro={promedio:6.1f} | Crudo={usos[CRUDO]} RLE={usos[RLE]} Delta={usos[DELTA]} | Rechazos={rechazos}")
+                t_informe = ahora  # Comienza un nuevo intervalo
+                cuadros_informe = 0  # Se reinicia el contador del intervalo
+
+    except KeyboardInterrupt:  # Si el usuario interrumpe el programa con Ctrl+C
+        total = time.time() - t0  # Tiempo total de transmisión
+        print(f"\nCuadros={cuadros} en {total:.1f} s | FPS sostenidos={cuadros / total:.1f} | Rechazos={rechazos}")
+
+    finally:
+        ser.close()  # Se cierra el puerto serie para liberar el recurso
@@ -9,8 +9,11 @@
 #include "uart.h" // Librería personalizada para manejo de comunicación UART
 #include "adc.h" // Librería personalizada para manejo del conversor analógico-digital
 #include "ws2812.h" // Librería personalizada para control de la matriz de LEDs WS2812B
+#include "flujo.h" // Librería personalizada para recibir cuadros en vivo desde la PC
+#include "filtros.h" // Librería personalizada de filtros digitales en punto fijo
 
 uint8_t leds[NUM_LEDS][3]; // Arreglo bidimensional que almacena los valores RGB de cada LED de la matriz
+static int16_t ventana_x[8], ventana_y[8]; // Ventanas del promedio móvil de 8 muestras de cada eje
 
 int main(void){ // Función principal del programa
 	UART_INICIAR(MYUBRR); // Inicializa la comunicación UART con el valor calculado del registro UBRR
@@ -19,8 +22,24 @@ int main(void){ // Función principal del programa
 
 	DDRD &= ~(1 << PD2); // Configura el pin PD2 como entrada (botón del joystick)
 	PORTD |= (1 << PD2); // Activa la resistencia pull-up interna en PD2
+	_delay_ms(1); // Pequeña espera para que la entrada se estabilice con el pull-up
+
+	if (!(PIND & (1 << PD2))){ // Si el botón está presionado al encender se entra al modo de transmisión en vivo
+		UART_IMPRIMIR("\r\n=== MODO TRANSMISION EN VIVO (1 Mbaud) ===\r\n"); // Se avisa por UART antes de cambiar la velocidad
+		_delay_ms(10); // Se espera a que termine de salir el mensaje
+		FLUJO_EJECUTAR(); // Se reciben y muestran los cuadros enviados por emisor_cuadros.py (no retorna)
+	}
 
 	srand(ADC_LEER_CANAL(0)); // Inicializa la semilla del generador de números aleatorios con una lectura del ADC
+	const uint8_t canales[] = {0, 1}; // Canales a escanear: eje X (posición 0) y eje Y (posición 1) del joystick
+	ADC_ESCANEO_INICIAR(canales, 2); // A partir de aquí el ADC convierte ambos ejes por interrupción
+
+	FILTRO_PROMEDIO filtro_x, filtro_y; // Promedios móviles que suavizan el ruido del joystick
+	FILTRO_PROMEDIO_INICIAR(&filtro_x, ventana_x, 3, 512); // Ventana de 2^3 muestras del eje X arrancando en el centro
+	FILTRO_PROMEDIO_INICIAR(&filtro_y, ventana_y, 3, 512); // Ventana de 2^3 muestras del eje Y arrancando en el centro
+	uint8_t sec_x = 0, sec_y = 0; // Secuencias de la última muestra leída de cada eje
+	uint16_t nuevas[ADC_MUESTRAS]; // Muestras nuevas copiadas del buffer del ADC
+	uint16_t x = 512, y = 512; // Lecturas filtradas de los ejes
 
 	uint8_t posX = 3, posY = 3; // Posición inicial del LED encendido en la matriz (coordenadas X,Y)
 	uint8_t r, g, b; // Variables para almacenar los componentes de color RGB
@@ -33,8 +52,10 @@ int main(void){ // Función principal del programa
 	UART_IMPRIMIR("\r\n=== CONTROL DE LED DE MATRIZ WS2813B CON JOYSTICK ===\r\n"); // Mensaje de inicio por UART
 
 	while (1){ // Bucle principal del programa
-		uint16_t x = ADC_LEER_CANAL(0); // Lectura del eje X del joystick (valor analógico)
-		uint16_t y = ADC_LEER_CANAL(1); // Lectura del eje Y del joystick (valor analógico)
+		uint8_t n = ADC_NUEVAS(0, &sec_x, nuevas); // Se toman las muestras del eje X llegadas desde la última vuelta
+		for (uint8_t i = 0; i < n; i++) x = FILTRO_PROMEDIO_ACTUALIZAR(&filtro_x, nuevas[i]); // Se pasan por el promedio móvil
+		n = ADC_NUEVAS(1, &sec_y, nuevas); // Se toman las muestras del eje Y llegadas desde la última vuelta
+		for (uint8_t i = 0; i < n; i++) y = FILTRO_PROMEDIO_ACTUALIZAR(&filtro_y, nuevas[i]); // Se pasan por el promedio móvil
 		uint8_t sw; // Variable para almacenar el estado del botón (switch) del joystick
 		
 		if (PIND & (1 << PD2)){ // Si el pin PD2 está en alto, el botón no está presionado
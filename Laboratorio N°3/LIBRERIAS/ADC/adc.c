@@ -1,4 +1,23 @@
 #include "adc.h"  // Se incluye el archivo de cabecera del ADC con las definiciones y prototipos necesarios
+#include <avr/sleep.h>  // Se incluye para el modo de reposo de reducción de ruido del ADC
+
+#define ADC_MASCARA  (ADC_MUESTRAS - 1)  // Máscara para que los índices den la vuelta al final de cada buffer
+
+static uint8_t lista[ADC_MAX_CANALES];  // Canales que recorre el escaneo
+static uint8_t n_canales = 0;  // Cantidad de canales de la lista
+static volatile uint8_t actual = 0;  // Posición en la lista del canal que se está convirtiendo
+static volatile uint8_t activo = 0;  // Indica si el escaneo debe seguir lanzando conversiones
+static volatile uint16_t muestras[ADC_MAX_CANALES][ADC_MUESTRAS];  // Buffer circular de muestras de cada canal
+static volatile uint8_t secuencia[ADC_MAX_CANALES];  // Contador de muestras recibidas de cada canal (también indica la próxima posición del buffer)
+static uint8_t disparo = 0;  // Fuente de disparo del escaneo periódico (0 si el escaneo es continuo)
+static volatile uint8_t conjunto_listo = 0;  // Bandera de conjunto completo de muestras
+static void (*al_completar)(void) = 0;  // Función que se llama al completar cada conjunto
+static uint8_t repeticiones[ADC_MAX_CANALES];  // Conversiones seguidas que se acumulan por muestra de cada canal (4^n, 0 equivale a 1)
+static uint8_t bits_extra[ADC_MAX_CANALES];  // Bits adicionales de resolución de cada canal (n)
+static uint16_t acumulado = 0;  // Suma de las conversiones de la ráfaga en curso (64 x 1023 entra en 16 bits)
+static uint8_t contados = 0;  // Conversiones acumuladas en la ráfaga en curso
+static volatile uint8_t dormido = 0;  // Indica que la conversión en curso la lanzó ADC_LEER_DORMIDO
+static volatile uint8_t dormido_listo = 0;  // Bandera de conversión completa en el modo dormido
 
 void ADC_INICIAR(void) {
     ADMUX = (1 << REFS0);  // Se selecciona AVCC como tensión de referencia para el ADC (bit REFS0 = 1)
@@ -11,3 +30,254 @@ uint16_t ADC_LEER_CANAL(uint8_t canal) {
     while (ADCSRA & (1 << ADSC));  // Se espera hasta que la conversión finalice (el bit ADSC se limpia automáticamente)
     return ADC;  // Se devuelve el valor digital de 10 bits obtenido de la conversión
 }
+
+ISR(ADC_vect) {  // Interrupción de conversión completa: guarda la muestra y lanza la conversión del siguiente canal
+    if (dormido) { dormido_listo = 1; return; }  // En el modo dormido solo se despierta al programa
+    uint8_t pos = actual;  // Canal que acaba de convertirse
+    acumulado += ADC;  // Se acumula la conversión
+    if (++contados < repeticiones[pos]) {  // Si la ráfaga de sobremuestreo no terminó
+        if (activo) ADCSRA |= (1 << ADSC);  // Se convierte otra vez el mismo canal
+        return;  // La muestra todavía no está completa
+    }
+    uint16_t valor = acumulado >> bits_extra[pos];  // Decimación: suma de 4^n conversiones dividida por 2^n
+    acumulado = 0;  // Se reinicia la ráfaga
+    contados = 0;  // Se reinicia la cuenta
+    uint8_t s = secuencia[pos];  // Contador del canal
+    muestras[pos][s & ADC_MASCARA] = valor;  // Se guarda la muestra en el buffer circular
+    secuencia[pos] = s + 1;  // Se publica la muestra nueva
+    if (++pos >= n_canales) pos = 0;  // Se pasa al siguiente canal de la lista
+    actual = pos;  // Se guarda la posición
+    ADMUX = (ADMUX & 0xF0) | lista[pos];  // Se selecciona el canal antes de iniciar la conversión
+    if (pos == 0) {  // Si se completó la lista
+        if (disparo == ADC_DISPARO_TIMER1) TIFR1 = (1 << OCF1B);  // Se limpia la bandera del disparo para que la próxima comparación genere un flanco
+        else if (disparo == ADC_DISPARO_TIMER0) TIFR0 = (1 << OCF0A);  // Ídem para el Timer0
+        conjunto_listo = 1;  // Se avisa que hay un conjunto nuevo
+        if (al_completar) al_completar();  // Se llama a la función registrada
+        if (disparo) return;  // En el escaneo periódico el próximo conjunto lo lanza el temporizador
+    }
+    if (activo) ADCSRA |= (1 << ADSC);  // Se lanza la siguiente conversión mientras el escaneo siga activo
+}
+
+static uint8_t adc_cargarLista(const uint8_t *canales, uint8_t n) {  // Detiene un escaneo previo y carga una nueva lista de canales
+    if (n > ADC_MAX_CANALES) n = ADC_MAX_CANALES;  // Se limita la lista al espacio disponible
+    if (n == 0) return 0;  // Sin canales no hay nada que escanear
+    ADC_ESCANEO_DETENER();  // Se espera a que termine un escaneo previo
+    acumulado = 0;  // Se descarta una ráfaga de sobremuestreo incompleta
+    contados = 0;  // Se reinicia la cuenta de la ráfaga
+    for (uint8_t i = 0; i < n; i++) {  // Se copia la lista y se reinician los contadores
+        lista[i] = canales[i] & 0x0F;  // Se guarda el canal
+        secuencia[i] = 0;  // Todavía no hay muestras
+    }
+    n_canales = n;  // Se guarda la cantidad de canales
+    actual = 0;  // Se empieza por el primer canal
+    conjunto_listo = 0;  // Todavía no hay conjuntos completos
+    ADMUX = (ADMUX & 0xF0) | lista[0];  // Se selecciona el primer canal
+    ADCSRA |= (1 << ADIF);  // Se limpia una bandera de conversión pendiente
+    return 1;  // La lista quedó cargada
+}
+
+void ADC_ESCANEO_INICIAR(const uint8_t *canales, uint8_t n) {  // Comienza el escaneo continuo de la lista de canales
+    if (!adc_cargarLista(canales, n)) return;  // Se carga la lista (sin canales no hay escaneo)
+    disparo = 0;  // Escaneo continuo, sin temporizador
+    activo = 1;  // El escaneo queda activo
+    ADCSRA |= (1 << ADIE) | (1 << ADSC);  // Se habilita la interrupción y se lanza la primera conversión
+    sei();  // Se habilitan las interrupciones globales
+}
+
+void ADC_ESCANEO_DETENER(void) {  // Detiene el escaneo sin cortar una conversión en curso
+    activo = 0;  // La interrupción deja de lanzar conversiones
+    ADCSRA &= ~(1 << ADATE);  // Se desactiva el disparo automático por temporizador
+    while (ADCSRA & (1 << ADSC));  // Se espera a que termine la conversión en curso
+    ADCSRA &= ~(1 << ADIE);  // Se deshabilita la interrupción
+}
+
+uint16_t ADC_ULTIMO(uint8_t pos) {  // Devuelve la última muestra del canal ubicado en 'pos' dentro de la lista
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Se evita que la interrupción modifique la muestra mientras se leen sus dos bytes
+    uint16_t v = muestras[pos][(secuencia[pos] - 1) & ADC_MASCARA];  // Se toma la muestra más reciente
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+    return v;  // Se devuelve la muestra
+}
+
+uint8_t ADC_SECUENCIA(uint8_t pos) {  // Devuelve el contador de muestras del canal (un byte, se lee de forma atómica)
+    return secuencia[pos];  // Se devuelve el contador
+}
+
+uint8_t ADC_NUEVAS(uint8_t pos, uint8_t *sec, uint16_t *destino) {  // Copia las muestras que llegaron después de la última lectura
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Se congela el buffer durante la copia (como máximo ADC_MUESTRAS palabras)
+    uint8_t fin = secuencia[pos];  // Contador actual del canal
+    uint8_t n = fin - *sec;  // Muestras nuevas desde la última lectura
+    if (n > ADC_MUESTRAS) n = ADC_MUESTRAS;  // Las más viejas ya se sobrescribieron
+    for (uint8_t i = 0; i < n; i++)  // Se copian en orden cronológico
+        destino[i] = muestras[pos][(uint8_t)(fin - n + i) & ADC_MASCARA];  // Se toma cada muestra del buffer circular
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+    *sec = fin;  // Se actualiza la secuencia del lector
+    return n;  // Se devuelve la cantidad de muestras copiadas
+}
+
+uint8_t ADC_ESCANEO_PERIODICO(const uint8_t *canales, uint8_t n, uint8_t fuente, uint16_t frecuencia_hz) {  // Escanea la lista de canales disparado por un temporizador a frecuencia fija
+    static const uint16_t divisores[] = {1, 8, 64, 256, 1024};  // Prescalers disponibles en Timer0 y Timer1 (el mismo código de CS para ambos)
+    uint32_t cuentas = 0;  // Cuentas del temporizador por período
+    uint8_t cs = 0;  // Código de selección del prescaler (CSn2:0)
+
+    if (frecuencia_hz == 0) return 0;  // Sin frecuencia no hay escaneo
+    for (uint8_t i = 0; i < 5; i++) {  // Se busca el prescaler más chico con el que el período entra en el temporizador
+        cuentas = F_CPU / ((uint32_t)divisores[i] * frecuencia_hz);  // Cuentas necesarias con este prescaler
+        if (cuentas >= 2 && cuentas <= ((fuente == ADC_DISPARO_TIMER1) ? 65536UL : 256UL)) { cs = i + 1; break; }  // Se acepta el primero que entra
+    }
+    if (cs == 0) return 0;  // La frecuencia no es alcanzable con este temporizador
+
+    if (!adc_cargarLista(canales, n)) return 0;  // Se carga la lista de canales
+    disparo = fuente;  // Se guarda la fuente para limpiar su bandera en la interrupción
+    activo = 1;  // El escaneo queda activo
+
+    if (fuente == ADC_DISPARO_TIMER1) {  // Disparo por comparación B del Timer1
+        TCCR1A = 0;  // Sin salidas en los pines OC1A/OC1B
+        TCCR1B = (1 << WGM12);  // Modo CTC con TOP = OCR1A, temporizador detenido durante la configuración
+        TCNT1 = 0;  // Se reinicia la cuenta
+        OCR1A = cuentas - 1;  // Período del muestreo
+        OCR1B = cuentas - 1;  // La comparación B coincide con el final de cada período
+        TIFR1 = (1 << OCF1B);  // Se limpia una bandera pendiente
+        TCCR1B |= cs;  // Se arranca el temporizador con el prescaler elegido
+    } else {  // Disparo por comparación A del Timer0
+        TCCR0A = (1 << WGM01);  // Modo CTC con TOP = OCR0A, sin salidas en los pines
+        TCCR0B = 0;  // Temporizador detenido durante la configuración
+        TCNT0 = 0;  // Se reinicia la cuenta
+        OCR0A = cuentas - 1;  // Período del muestreo
+        TIFR0 = (1 << OCF0A);  // Se limpia una bandera pendiente
+        TCCR0B = cs;  // Se arranca el temporizador con el prescaler elegido
+    }
+
+    ADCSRB = (ADCSRB & ~0x07) | fuente;  // Se selecciona la fuente de disparo (ADTS2:0)
+    ADCSRA |= (1 << ADATE) | (1 << ADIE);  // Se habilitan el disparo automático y la interrupción
+    sei();  // Se habilitan las interrupciones globales
+    return 1;  // El escaneo periódico quedó en marcha
+}
+
+uint8_t ADC_CONJUNTO_LISTO(void) {  // Devuelve si hay un conjunto nuevo y limpia la bandera
+    if (!conjunto_listo) return 0;  // No hay conjunto nuevo
+    conjunto_listo = 0;  // Se consume la bandera
+    return 1;  // Hay un conjunto nuevo
+}
+
+void ADC_AL_COMPLETAR(void (*funcion)(void)) {  // Registra la función a llamar al completar cada conjunto
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Se cambia el puntero de forma atómica
+    al_completar = funcion;  // Se guarda la función
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+}
+
+uint8_t ADC_CAPTURAR(uint8_t *buffer, uint16_t tam, const ADC_CAPTURA *cfg, uint16_t *inicio) {  // Captura una ráfaga de muestras de 8 bits con disparo y muestras previas
+    uint16_t mascara = tam - 1;  // Máscara del buffer circular (tam es potencia de 2)
+    uint16_t i = 0;  // Próxima posición de escritura
+    uint16_t previas = (cfg->previas < tam) ? cfg->previas : tam - 1;  // Muestras previas limitadas al buffer
+    uint16_t armado = 0;  // Muestras tomadas antes de habilitar el disparo
+    uint32_t esperadas = 0;  // Muestras tomadas esperando el disparo
+    uint8_t anterior = 0;  // Muestra anterior para detectar flancos
+    uint8_t disparado = (cfg->disparo == ADC_CAP_LIBRE);  // En modo libre no hay disparo que esperar
+    uint8_t ps = (cfg->divisor == ADC_CAP_DIV16) ? ((1 << ADPS2)) : ((1 << ADPS2) | (1 << ADPS0));  // Bits de prescaler 16 (100) o 32 (101)
+
+    ADC_ESCANEO_DETENER();  // Se detiene el escaneo por interrupción
+    uint8_t admux = ADMUX;  // Se guarda la configuración del multiplexor
+    uint8_t adcsrb = ADCSRB;  // Se guarda la fuente de disparo
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Sin interrupciones para no perder muestras
+
+    ADMUX = (admux & 0xC0) | (1 << ADLAR) | (cfg->canal & 0x0F);  // Misma referencia, resultado justificado a izquierda y canal de captura
+    ADCSRB = adcsrb & ~0x07;  // Fuente de disparo: modo libre
+    ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADATE) | (1 << ADIF) | ps;  // Se arranca el modo libre y se limpia ADIF
+    while (!(ADCSRA & (1 << ADIF)));  // Se descarta la primera conversión (tarda 25 ciclos de ADC y sigue al cambio de canal)
+    ADCSRA |= (1 << ADIF);  // Se limpia la bandera
+
+    while (1) {  // Fase de espera del disparo: se llena el buffer circular continuamente
+        while (!(ADCSRA & (1 << ADIF)));  // Se espera la próxima conversión
+        ADCSRA |= (1 << ADIF);  // Se limpia la bandera
+        uint8_t v = ADCH;  // Se leen los 8 bits altos
+        buffer[i] = v;  // Se guarda la muestra
+        i = (i + 1) & mascara;  // Se avanza en el buffer circular
+        if (armado < previas) { armado++; anterior = v; continue; }  // Primero se juntan las muestras previas
+        if (!disparado) {  // Se evalúa la condición de disparo
+            if (cfg->disparo == ADC_CAP_NIVEL) disparado = (v >= cfg->nivel);  // Disparo por nivel
+            else if (cfg->disparo == ADC_CAP_SUBIDA) disparado = (anterior < cfg->nivel && v >= cfg->nivel);  // Flanco de subida
+            else disparado = (anterior >= cfg->nivel && v < cfg->nivel);  // Flanco de bajada
+        }
+        if (disparado) break;  // La muestra actual es la del disparo
+        anterior = v;  // Se guarda para el próximo flanco
+        if (cfg->espera && ++esperadas >= cfg->espera) break;  // Si se agotó la espera se captura igual
+    }
+
+    for (uint16_t n = tam - previas - 1; n; n--) {  // Fase posterior: se completan las muestras después del disparo
+        while (!(ADCSRA & (1 << ADIF)));  // Se espera la próxima conversión
+        ADCSRA |= (1 << ADIF);  // Se limpia la bandera
+        buffer[i] = ADCH;  // Se guarda la muestra
+        i = (i + 1) & mascara;  // Se avanza en el buffer circular
+    }
+
+    ADCSRA = (1 << ADEN) | (1 << ADIF) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);  // Se vuelve a conversión simple con prescaler 128
+    ADMUX = admux;  // Se restaura el multiplexor (sin ADLAR)
+    ADCSRB = adcsrb;  // Se restaura la fuente de disparo
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+    *inicio = i;  // La próxima posición de escritura es la muestra más antigua
+    return disparado;  // Se informa si hubo disparo
+}
+
+void ADC_VOLCAR(const uint8_t *buffer, uint16_t tam, uint16_t inicio, const ADC_CAPTURA *cfg, uint8_t disparado, void (*enviar)(char)) {  // Envía la captura en binario en orden cronológico
+    uint16_t previas = (cfg->previas < tam) ? cfg->previas : tam - 1;  // Muestras previas efectivas
+    uint8_t suma = 0;  // Suma de verificación de las muestras
+    enviar('C'); enviar('A'); enviar('P');  // Marca de inicio de la captura
+    enviar(cfg->divisor);  // Divisor del ADC (la frecuencia de muestreo es F_CPU / (divisor * 13))
+    enviar(tam & 0xFF); enviar(tam >> 8);  // Cantidad de muestras (little endian)
+    enviar(previas & 0xFF); enviar(previas >> 8);  // Posición de la muestra de disparo (little endian)
+    enviar(disparado);  // 1 si hubo disparo, 0 si se agotó la espera
+    for (uint16_t n = 0; n < tam; n++) {  // Se envían las muestras desde la más antigua
+        uint8_t v = buffer[(inicio + n) & (tam - 1)];  // Muestra en orden cronológico
+        suma += v;  // Se acumula en la suma
+        enviar(v);  // Se envía la muestra
+    }
+    enviar(suma);  // Suma de verificación (módulo 256)
+}
+
+void ADC_SOBREMUESTREO(uint8_t pos, uint8_t n) {  // Configura cuántos bits extra se obtienen por sobremuestreo en un canal de la lista
+    if (pos >= ADC_MAX_CANALES) return;  // Posición fuera de la lista
+    if (n > 3) n = 3;  // Como máximo 13 bits (64 conversiones, la suma entra en 16 bits)
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Se cambia la configuración de forma atómica respecto de la interrupción
+    bits_extra[pos] = n;  // Bits adicionales
+    repeticiones[pos] = 1 << (2 * n);  // Se acumulan 4^n conversiones por muestra
+    acumulado = 0;  // Se descarta una ráfaga incompleta
+    contados = 0;  // Se reinicia la cuenta
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+}
+
+uint16_t ADC_LEER_DORMIDO(uint8_t canal, uint8_t n) {  // Lee un canal con 10 + n bits convirtiendo en el modo de reposo de reducción de ruido
+    uint16_t suma = 0;  // Suma de las conversiones
+    uint8_t cantidad = 1 << (2 * n);  // Conversiones a acumular (4^n)
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+
+    if (n > 3) return 0;  // Como máximo 13 bits
+    ADC_ESCANEO_DETENER();  // El escaneo por interrupción no puede convivir con el reposo
+    ADMUX = (ADMUX & 0xF0) | (canal & 0x0F);  // Se selecciona el canal
+    dormido = 1;  // La interrupción solo despierta al programa
+    set_sleep_mode(SLEEP_MODE_ADC);  // Reposo de reducción de ruido: la CPU y el reloj de E/S se detienen durante la conversión
+    ADCSRA |= (1 << ADIF) | (1 << ADIE);  // Se limpia la bandera y se habilita la interrupción que despierta a la CPU
+
+    for (uint8_t i = 0; i < cantidad; i++) {  // Se acumulan las conversiones
+        dormido_listo = 0;  // Se espera una conversión nueva
+        cli();  // Se evita perder la interrupción entre la consulta y el reposo
+        while (!dormido_listo) {  // Si otra interrupción despierta a la CPU, se vuelve a dormir sin relanzar la conversión
+            sleep_enable();  // Se habilita el reposo
+            sei();  // La instrucción siguiente a sei() se ejecuta antes de atender interrupciones
+            sleep_cpu();  // Al dormir el ADC arranca la conversión
+            sleep_disable();  // Se deshabilita el reposo al despertar
+            cli();  // Se vuelve a consultar la bandera sin interrupciones
+        }
+        sei();  // Se habilitan las interrupciones
+        suma += ADC;  // Se acumula la conversión
+    }
+
+    ADCSRA &= ~(1 << ADIE);  // Se deshabilita la interrupción
+    dormido = 0;  // Se vuelve al modo normal
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+    return suma >> n;  // Decimación a 10 + n bits
+}
@@ -1,10 +1,79 @@
 #ifndef ADC_H  // Se define una directiva de preprocesador para evitar inclusiones múltiples del mismo archivo
 #define ADC_H  // Se indica el inicio del bloque de protección de inclusión
 
+#ifndef F_CPU  // Verifica si no está definida la frecuencia del microcontrolador
+#define F_CPU 16000000UL  // Define la frecuencia del reloj principal en 16 MHz
+#endif  // Fin de la comprobación de F_CPU
+
 #include <avr/io.h>  // Se incluye la librería principal de E/S del AVR que permite el acceso a los registros del microcontrolador
+#include <avr/interrupt.h>  // Se incluye para el manejo de la interrupción de conversión completa del ADC
 #include <stdint.h>  // Se incluye la librería estándar para el uso de tipos de datos enteros con tamaño definido (uint8_t, uint16_t, etc.)
 
+#ifndef ADC_MAX_CANALES  // Permite cambiar la cantidad de canales del escaneo desde las opciones del compilador
+#define ADC_MAX_CANALES  4  // Cantidad máxima de canales en la lista de escaneo
+#endif  // Fin de la comprobación de ADC_MAX_CANALES
+
+#ifndef ADC_MUESTRAS  // Permite cambiar el largo de los buffers circulares desde las opciones del compilador
+#define ADC_MUESTRAS  8  // Muestras que guarda el buffer circular de cada canal (potencia de 2)
+#endif  // Fin de la comprobación de ADC_MUESTRAS
+
+#if ADC_MUESTRAS & (ADC_MUESTRAS - 1)  // Verifica que el largo del buffer permita usar una máscara
+#error "ADC_MUESTRAS debe ser potencia de 2"
+#endif  // Fin de la verificación del largo del buffer
+
 void ADC_INICIAR(void);  // Prototipo de función para inicializar el módulo ADC
-uint16_t ADC_LEER_CANAL(uint8_t canal);  // Prototipo de función para leer un canal analógico específico y retornar el valor convertido
+uint16_t ADC_LEER_CANAL(uint8_t canal);  // Prototipo de función para leer un canal analógico específico y retornar el valor convertido (no usar con el escaneo activo)
+
+// Escaneo por interrupción: el ADC recorre la lista de canales sin detener al programa (una conversión cada 104 µs
+// con prescaler 128, es decir 9615 muestras/s repartidas entre los canales). Las funciones reciben la posición del
+// canal en la lista (0, 1, ...), no el número de canal.
+void ADC_ESCANEO_INICIAR(const uint8_t *canales, uint8_t n);  // Prototipo para comenzar el escaneo continuo de una lista de canales
+void ADC_ESCANEO_DETENER(void);  // Prototipo para detener el escaneo al terminar la conversión en curso
+uint16_t ADC_ULTIMO(uint8_t pos);  // Prototipo que devuelve la última muestra de un canal de la lista
+uint8_t ADC_SECUENCIA(uint8_t pos);  // Prototipo que devuelve el contador de muestras de un canal (cambia cada vez que llega una nueva)
+uint8_t ADC_NUEVAS(uint8_t pos, uint8_t *secuencia, uint16_t *destino);  // Prototipo que copia las muestras llegadas desde 'secuencia' (hasta ADC_MUESTRAS), actualiza 'secuencia' y devuelve cuántas copió
+
+// Escaneo periódico: un temporizador dispara (ADATE/ADTS) la conversión del primer canal a una frecuencia fija y la
+// interrupción encadena el resto de la lista. El instante de muestreo del primer canal no depende del programa: ocurre
+// 2 ciclos de ADC después de la comparación del temporizador. Si el período en ciclos de CPU es múltiplo de 128 (el
+// prescaler del ADC), lo que siempre se cumple con prescaler de temporizador 256 o 1024, el desfase es fijo y no hay jitter.
+// Los canales siguientes se muestrean 104 µs después del anterior (más la latencia de la interrupción, unos pocos ciclos).
+#define ADC_DISPARO_TIMER0  3  // Fuente de disparo: comparación A del Timer0 en modo CTC (ADTS = 011), usa el Timer0 completo
+#define ADC_DISPARO_TIMER1  5  // Fuente de disparo: comparación B del Timer1 en modo CTC (ADTS = 101), usa el Timer1 completo
+
+uint8_t ADC_ESCANEO_PERIODICO(const uint8_t *canales, uint8_t n, uint8_t fuente, uint16_t frecuencia_hz);  // Prototipo para escanear la lista a una frecuencia fija (devuelve 0 si la frecuencia no es alcanzable)
+uint8_t ADC_CONJUNTO_LISTO(void);  // Prototipo que indica (y limpia) si se completó un nuevo conjunto de muestras de todos los canales
+void ADC_AL_COMPLETAR(void (*funcion)(void));  // Prototipo para registrar una función que se llama desde la interrupción al completar cada conjunto (NULL para ninguna)
+
+// Sobremuestreo y decimación: cada muestra publicada de un canal es la suma de 4^n conversiones seguidas dividida por 2^n,
+// con 10 + n bits (n = 1, 2 o 3 para 11, 12 o 13 bits). Requiere algo de ruido (al menos 1 LSB) en la señal para que los
+// bits extra sean efectivos. Frecuencia efectiva en escaneo continuo: 9615 / (4^n * canales) muestras/s (11 bits: 2404,
+// 12 bits: 601, 13 bits: 150 con un canal). En el escaneo periódico la ráfaga se hace en cada disparo (4^n * 104 µs),
+// por lo que la frecuencia efectiva es la del temporizador.
+void ADC_SOBREMUESTREO(uint8_t pos, uint8_t n);  // Prototipo para obtener n bits extra (0 a 3) en un canal de la lista (se conserva entre escaneos)
+uint16_t ADC_LEER_DORMIDO(uint8_t canal, uint8_t n);  // Prototipo para leer un canal con 10 + n bits en el reposo de reducción de ruido (bloqueante, 4^n * ~110 µs; detiene Timer0/Timer1/UART mientras duerme)
+
+// Captura rápida de 8 bits (osciloscopio): el ADC corre en modo libre con ADLAR y se lee solo ADCH, consultando ADIF
+// con las interrupciones deshabilitadas, de modo que las muestras quedan equiespaciadas por hardware. Detiene el escaneo
+// por interrupción: al terminar se debe volver a llamar a ADC_ESCANEO_INICIAR o ADC_ESCANEO_PERIODICO.
+#define ADC_CAP_DIV16  16  // Prescaler 16: reloj de ADC de 1 MHz, 76923 muestras/s (precisión reducida, suficiente para 8 bits)
+#define ADC_CAP_DIV32  32  // Prescaler 32: reloj de ADC de 500 kHz, 38462 muestras/s
+
+#define ADC_CAP_LIBRE   0  // Sin disparo: se captura apenas se completan las muestras previas
+#define ADC_CAP_NIVEL   1  // Disparo cuando la muestra es mayor o igual que el nivel
+#define ADC_CAP_SUBIDA  2  // Disparo en el flanco de subida que cruza el nivel
+#define ADC_CAP_BAJADA  3  // Disparo en el flanco de bajada que cruza el nivel
+
+typedef struct {  // Configuración de una captura
+    uint8_t canal;  // Canal analógico a capturar (0 a 7)
+    uint8_t divisor;  // ADC_CAP_DIV16 o ADC_CAP_DIV32
+    uint8_t disparo;  // ADC_CAP_LIBRE, ADC_CAP_NIVEL, ADC_CAP_SUBIDA o ADC_CAP_BAJADA
+    uint8_t nivel;  // Nivel de disparo en 8 bits (0 a 255)
+    uint16_t previas;  // Muestras anteriores al disparo que se conservan (menor que el tamaño del buffer)
+    uint32_t espera;  // Muestras máximas a esperar el disparo antes de capturar igual (0 = esperar indefinidamente)
+} ADC_CAPTURA;
+
+uint8_t ADC_CAPTURAR(uint8_t *buffer, uint16_t tam, const ADC_CAPTURA *cfg, uint16_t *inicio);  // Prototipo para capturar 'tam' muestras (potencia de 2) en un buffer circular; devuelve 1 si hubo disparo y en 'inicio' la muestra más antigua
+void ADC_VOLCAR(const uint8_t *buffer, uint16_t tam, uint16_t inicio, const ADC_CAPTURA *cfg, uint8_t disparado, void (*enviar)(char));  // Prototipo para enviar la captura en binario: "CAP", divisor, tam, previas, disparado, muestras y suma
 
 #endif  // Fin de la protección contra inclusión múltiple del archivo
@@ -0,0 +1,206 @@
+#include "animacion.h"  // Se incluye el archivo de cabecera con las definiciones y prototipos del motor de animación
+
+// Figuras portadas de Evaluación N°6 (Matriz_Led.txt), fila 0 arriba, bit 7 = columna izquierda
+static const uint8_t ALIEN_DATOS[] PROGMEM = {0x18, 0x3C, 0x7E, 0xDB, 0xFF, 0x24, 0x42, 0x81};  // FIG_ALIEN
+static const uint8_t CORAZON_DATOS[] PROGMEM = {0x66, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C, 0x18, 0x00};  // FIG_HEART
+static const uint8_t ROMBO_DATOS[] PROGMEM = {0x18, 0x3C, 0x7E, 0xFF, 0x7E, 0x3C, 0x18, 0x00};  // FIG_DIAMOND
+// Caras portadas de Matriz Caras: se usan las tablas sin invertir y se voltean las filas porque allí la fila 0 está abajo
+static const uint8_t CARA_FELIZ_DATOS[] PROGMEM = {0x00, 0x24, 0x24, 0x00, 0x00, 0x42, 0x3C, 0x00};  // Ojos arriba y sonrisa abajo
+static const uint8_t CARA_TRISTE_DATOS[] PROGMEM = {0x00, 0x24, 0x24, 0x00, 0x3C, 0x42, 0x00, 0x00};  // Ojos arriba y boca invertida abajo
+
+const SPRITE_1BIT SPRITE_ALIEN PROGMEM = {8, 8, ALIEN_DATOS};  // Sprite del alien
+const SPRITE_1BIT SPRITE_CORAZON PROGMEM = {8, 8, CORAZON_DATOS};  // Sprite del corazón
+const SPRITE_1BIT SPRITE_ROMBO PROGMEM = {8, 8, ROMBO_DATOS};  // Sprite del rombo
+const SPRITE_1BIT SPRITE_CARA_FELIZ PROGMEM = {8, 8, CARA_FELIZ_DATOS};  // Sprite de la cara feliz
+const SPRITE_1BIT SPRITE_CARA_TRISTE PROGMEM = {8, 8, CARA_TRISTE_DATOS};  // Sprite de la cara triste
+
+static const uint8_t CORAZON_COLOR_PALETA[] PROGMEM = {  // Paleta R, G, B del corazón de color
+    0, 0, 0,  // 0: fondo (transparente)
+    60, 0, 0,  // 1: contorno rojo oscuro
+    200, 0, 20,  // 2: relleno rojo
+    255, 120, 150  // 3: brillo rosado
+};
+static const uint8_t CORAZON_COLOR_DATOS[] PROGMEM = {  // Píxeles del corazón de color, 4 bytes por fila
+    0x01, 0x10, 0x01, 0x10,  // fila 0: 0 1 1 0 0 1 1 0
+    0x13, 0x21, 0x12, 0x21,  // fila 1: 1 3 2 1 1 2 2 1
+    0x13, 0x22, 0x22, 0x21,  // fila 2: 1 3 2 2 2 2 2 1
+    0x12, 0x22, 0x22, 0x21,  // fila 3: 1 2 2 2 2 2 2 1
+    0x01, 0x22, 0x22, 0x10,  // fila 4: 0 1 2 2 2 2 1 0
+    0x00, 0x12, 0x21, 0x00,  // fila 5: 0 0 1 2 2 1 0 0
+    0x00, 0x01, 0x10, 0x00,  // fila 6: 0 0 0 1 1 0 0 0
+    0x00, 0x00, 0x00, 0x00   // fila 7: vacía
+};
+const SPRITE_PALETA SPRITE_CORAZON_COLOR PROGMEM = {8, 8, 0, CORAZON_COLOR_PALETA, CORAZON_COLOR_DATOS};  // Sprite de paleta con el índice 0 transparente
+
+const CUADRO_CLAVE SECUENCIA_FIGURAS[] PROGMEM = {  // Reproduce la misma secuencia que el programa en ensamblador de la matriz
+    {&SPRITE_ALIEN,   ANIM_1BIT, 0, 0, 0, 80, 0, 2000},  // Alien verde durante 2 s
+    {&SPRITE_CORAZON, ANIM_1BIT, 0, 0, 80, 0, 0, 2000},  // Corazón rojo durante 2 s
+    {&SPRITE_ROMBO,   ANIM_1BIT, 0, 0, 0, 0, 80, 2000}   // Rombo azul durante 2 s
+};
+const uint8_t SECUENCIA_FIGURAS_N = sizeof(SECUENCIA_FIGURAS) / sizeof(SECUENCIA_FIGURAS[0]);  // Cantidad de cuadros de la secuencia
+
+#if (F_CPU / 256000UL) * ANIM_TICK_MS <= 256  // Si el tick entra en el Timer2 con prescaler 256 (hasta 4,096 ms)
+#define ANIM_PRESCALER  256UL  // Prescaler del Timer2 (16 µs por cuenta)
+#define ANIM_CS         ((1 << CS22) | (1 << CS21))  // Bits de selección del prescaler 256
+#elif (F_CPU / 1024000UL) * ANIM_TICK_MS <= 256  // Si entra con prescaler 1024 (hasta 16,4 ms)
+#define ANIM_PRESCALER  1024UL  // Prescaler del Timer2 (64 µs por cuenta)
+#define ANIM_CS         ((1 << CS22) | (1 << CS21) | (1 << CS20))  // Bits de selección del prescaler 1024
+#else  // El Timer2 no llega
+#error "ANIM_TICK_MS demasiado largo para el Timer2 (máximo 16 ms)"
+#endif  // Fin de la selección del prescaler
+
+static uint8_t buffers[2][NUM_LEDS][3];  // Doble buffer: uno se muestra mientras en el otro se compone el siguiente cuadro
+static uint8_t frente = 0;  // Índice del buffer que está en la matriz
+static volatile uint16_t ticks_restantes = 0;  // Ticks de ANIM_TICK_MS que le quedan al cuadro visible (lo descuenta el Timer2)
+
+static const CUADRO_CLAVE *secuencia;  // Secuencia en reproducción (en flash)
+static uint8_t secuencia_n;  // Cantidad de cuadros de la secuencia
+static uint8_t siguiente;  // Índice del próximo cuadro a componer
+static uint8_t repetir_secuencia;  // Indica si la secuencia vuelve a empezar al terminar
+static uint8_t activa = 0;  // Indica si hay una secuencia en reproducción
+static uint8_t compuesto = 0;  // Indica si el buffer trasero ya tiene listo el próximo cuadro
+static uint16_t ticks_siguiente;  // Duración en ticks del cuadro ya compuesto en el buffer trasero
+
+ISR(TIMER2_COMPA_vect) {  // Interrupción periódica del Timer2 que mide la duración de los cuadros
+    if (ticks_restantes) ticks_restantes--;  // Se descuenta un tick mientras el cuadro visible no haya vencido
+}
+
+static uint16_t anim_leerTicks(void) {  // Lee el contador de 16 bits compartido con la interrupción de forma atómica
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Se deshabilitan las interrupciones durante la lectura de los dos bytes
+    uint16_t t = ticks_restantes;  // Se copia el contador
+    SREG = sreg;  // Se restaura el estado previo de las interrupciones
+    return t;  // Se devuelve la copia
+}
+
+static void anim_escribirTicks(uint16_t t) {  // Escribe el contador compartido con la interrupción de forma atómica
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // Se deshabilitan las interrupciones durante la escritura de los dos bytes
+    ticks_restantes = t;  // Se carga el nuevo valor
+    SREG = sreg;  // Se restaura el estado previo de las interrupciones
+}
+
+void ANIM_INICIAR(void) {  // Inicializa los buffers y el Timer2 en modo CTC con período ANIM_TICK_MS
+    WS2812_LIMPIAR(buffers[0]);  // Se apagan todos los LEDs del primer buffer
+    WS2812_LIMPIAR(buffers[1]);  // Se apagan todos los LEDs del segundo buffer
+    frente = 0;  // El primer buffer pasa a ser el visible
+    activa = 0;  // No hay secuencia en reproducción
+    TCCR2A = (1 << WGM21);  // Se configura el Timer2 en modo CTC (TOP = OCR2A)
+    TCCR2B = ANIM_CS;  // Se selecciona el prescaler 256 o 1024 según el tick
+    OCR2A = (uint8_t)((F_CPU / ANIM_PRESCALER) * ANIM_TICK_MS / 1000UL - 1);  // Se carga el valor de comparación para un tick de ANIM_TICK_MS
+    TIMSK2 = (1 << OCIE2A);  // Se habilita la interrupción por coincidencia con OCR2A
+    sei();  // Se habilitan las interrupciones globales
+}
+
+uint8_t (*ANIM_BUFFER_TRASERO(void))[3] {  // Devuelve el buffer que no se está mostrando
+    return buffers[frente ^ 1];  // Se retorna el buffer opuesto al visible
+}
+
+uint8_t (*ANIM_BUFFER_FRENTE(void))[3] {  // Devuelve el buffer que se está mostrando
+    return buffers[frente];  // Se retorna el buffer visible
+}
+
+void ANIM_INTERCAMBIAR(void) {  // Convierte el buffer trasero en el visible y lo envía a la matriz
+    frente ^= 1;  // Se intercambian los roles de los buffers
+    WS2812_MOSTRAR(buffers[frente]);  // Se envía el nuevo cuadro a los LEDs
+}
+
+void ANIM_DIBUJAR_1BIT(uint8_t (*leds)[3], const SPRITE_1BIT *sprite, int8_t x, int8_t y, uint8_t r, uint8_t g, uint8_t b) {  // Copia un sprite de 1 bit recortando lo que quede fuera de la matriz
+    SPRITE_1BIT s;  // Copia en RAM de la descripción del sprite
+    memcpy_P(&s, sprite, sizeof(s));  // Se lee la descripción desde la flash
+    uint8_t bytes_fila = (s.ancho + 7) >> 3;  // Cantidad de bytes que ocupa cada fila del sprite
+    int16_t c0 = (x < 0) ? -x : 0;  // Primera columna del sprite que cae dentro de la matriz
+    int16_t f0 = (y < 0) ? -y : 0;  // Primera fila del sprite que cae dentro de la matriz
+    int16_t c1 = s.ancho;  // Columna final (exclusiva) del sprite
+    int16_t f1 = s.alto;  // Fila final (exclusiva) del sprite
+    if (x + c1 > WS2812_ANCHO) c1 = WS2812_ANCHO - x;  // Se recorta por el borde derecho
+    if (y + f1 > WS2812_ALTO) f1 = WS2812_ALTO - y;  // Se recorta por el borde inferior
+
+    for (int16_t f = f0; f < f1; f++) {  // Se recorren solo las filas visibles
+        const uint8_t *fila = s.datos + f * bytes_fila;  // Dirección en flash de la fila actual
+        uint8_t byte = pgm_read_byte(fila + (c0 >> 3));  // Se lee el byte que contiene la primera columna visible
+        for (int16_t c = c0; c < c1; c++) {  // Se recorren solo las columnas visibles
+            if ((c & 7) == 0) byte = pgm_read_byte(fila + (c >> 3));  // Al cruzar un límite de byte se lee el siguiente
+            if (byte & (0x80 >> (c & 7))) {  // Solo se dibujan los bits en 1 (los bits en 0 son transparentes)
+                uint16_t i = WS2812_INDICE(x + c, y + f);  // Índice del LED de destino
+                leds[i][0] = g;  // Se asigna la componente verde (orden GRB)
+                leds[i][1] = r;  // Se asigna la componente roja
+                leds[i][2] = b;  // Se asigna la componente azul
+            }
+        }
+    }
+}
+
+void ANIM_DIBUJAR_PALETA(uint8_t (*leds)[3], const SPRITE_PALETA *sprite, int8_t x, int8_t y) {  // Copia un sprite de paleta omitiendo el color transparente y recortando los bordes
+    SPRITE_PALETA s;  // Copia en RAM de la descripción del sprite
+    memcpy_P(&s, sprite, sizeof(s));  // Se lee la descripción desde la flash
+    uint8_t bytes_fila = (s.ancho + 1) >> 1;  // Cantidad de bytes por fila (2 píxeles por byte)
+    int16_t c0 = (x < 0) ? -x : 0;  // Primera columna visible
+    int16_t f0 = (y < 0) ? -y : 0;  // Primera fila visible
+    int16_t c1 = s.ancho;  // Columna final (exclusiva)
+    int16_t f1 = s.alto;  // Fila final (exclusiva)
+    if (x + c1 > WS2812_ANCHO) c1 = WS2812_ANCHO - x;  // Se recorta por el borde derecho
+    if (y + f1 > WS2812_ALTO) f1 = WS2812_ALTO - y;  // Se recorta por el borde inferior
+
+    for (int16_t f = f0; f < f1; f++) {  // Se recorren las filas visibles
+        const uint8_t *fila = s.datos + f * bytes_fila;  // Dirección en flash de la fila actual
+        for (int16_t c = c0; c < c1; c++) {  // Se recorren las columnas visibles
+            uint8_t par = pgm_read_byte(fila + (c >> 1));  // Byte con los dos píxeles de la pareja
+            uint8_t indice = (c & 1) ? (par & 0x0F) : (par >> 4);  // Se extrae el nibble del píxel
+            if (indice == s.transparente) continue;  // El color transparente deja el fondo intacto
+            const uint8_t *color = s.paleta + indice * 3;  // Dirección en flash del color en la paleta
+            uint16_t i = WS2812_INDICE(x + c, y + f);  // Índice del LED de destino
+            leds[i][0] = pgm_read_byte(color + 1);  // Componente verde (orden GRB)
+            leds[i][1] = pgm_read_byte(color);  // Componente roja
+            leds[i][2] = pgm_read_byte(color + 2);  // Componente azul
+        }
+    }
+}
+
+void ANIM_REPRODUCIR(const CUADRO_CLAVE *cuadros, uint8_t n, uint8_t repetir) {  // Comienza a reproducir una secuencia de cuadros clave
+    secuencia = cuadros;  // Se guarda la secuencia
+    secuencia_n = n;  // Se guarda la cantidad de cuadros
+    repetir_secuencia = repetir;  // Se guarda si la secuencia es cíclica
+    siguiente = 0;  // Se empieza por el primer cuadro
+    compuesto = 0;  // Todavía no hay cuadro compuesto
+    anim_escribirTicks(0);  // El primer cuadro se muestra apenas esté compuesto
+    activa = (n > 0);  // La secuencia solo queda activa si tiene cuadros
+}
+
+void ANIM_DETENER(void) {  // Detiene la secuencia en curso dejando el último cuadro en la matriz
+    activa = 0;  // Se marca la secuencia como inactiva
+}
+
+uint8_t ANIM_ACTIVA(void) {  // Indica si hay una secuencia en reproducción
+    return activa;  // Se devuelve la bandera
+}
+
+uint8_t ANIM_ACTUALIZAR(void) {  // Compone por adelantado el siguiente cuadro y lo intercambia cuando vence el actual
+    if (!activa) return 0;  // Si no hay secuencia no hay nada que hacer
+
+    if (!compuesto) {  // Si el buffer trasero todavía no tiene el próximo cuadro
+        if (siguiente >= secuencia_n) {  // Si ya se compusieron todos los cuadros
+            if (!repetir_secuencia) {  // Si la secuencia no es cíclica
+                if (anim_leerTicks() == 0) activa = 0;  // Termina cuando vence el último cuadro visible
+                return 0;  // No hay cuadro nuevo
+            }
+            siguiente = 0;  // Si es cíclica se vuelve al primer cuadro
+        }
+        CUADRO_CLAVE c;  // Copia en RAM del cuadro clave
+        memcpy_P(&c, &secuencia[siguiente], sizeof(c));  // Se lee el cuadro desde la flash
+        uint8_t (*trasero)[3] = buffers[frente ^ 1];  // Buffer donde se compone
+        WS2812_LIMPIAR(trasero);  // Se parte de un fondo apagado
+        if (c.tipo == ANIM_PALETA) ANIM_DIBUJAR_PALETA(trasero, (const SPRITE_PALETA *)c.sprite, c.x, c.y);  // Se dibuja el sprite de paleta
+        else ANIM_DIBUJAR_1BIT(trasero, (const SPRITE_1BIT *)c.sprite, c.x, c.y, c.r, c.g, c.b);  // Se dibuja el sprite de 1 bit con su tinta
+        ticks_siguiente = (c.duracion_ms + ANIM_TICK_MS - 1) / ANIM_TICK_MS;  // Se convierte la duración a ticks redondeando hacia arriba
+        siguiente++;  // Se avanza al siguiente cuadro clave
+        compuesto = 1;  // El buffer trasero queda listo
+    }
+
+    if (anim_leerTicks() != 0) return 0;  // Si el cuadro visible no venció se espera
+
+    ANIM_INTERCAMBIAR();  // Se muestra el cuadro que ya estaba compuesto
+    anim_escribirTicks(ticks_siguiente);  // Se arma la duración del nuevo cuadro visible
+    compuesto = 0;  // El buffer trasero queda libre para componer el siguiente
+    return 1;  // Se informa que hubo un cuadro nuevo
+}
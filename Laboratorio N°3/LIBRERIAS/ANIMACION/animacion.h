@@ -0,0 +1,71 @@
+#ifndef ANIMACION_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define ANIMACION_H  // Marca el inicio del bloque protegido de inclusión
+
+#ifndef F_CPU  // Verifica si no está definida la frecuencia del microcontrolador
+#define F_CPU 16000000UL  // Define la frecuencia del reloj principal en 16 MHz
+#endif  // Fin de la comprobación de F_CPU
+
+#include <avr/io.h>  // Se incluye la librería para acceder a los registros del Timer2 usado como base de tiempo
+#include <avr/interrupt.h>  // Se incluye para declarar la interrupción de comparación del Timer2
+#include <avr/pgmspace.h>  // Se incluye para leer sprites y secuencias almacenados en la memoria flash
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+#include "ws2812.h"  // Se incluye la librería de la matriz WS2812 sobre la que se dibujan los cuadros
+
+// El tick debe ser más largo que la ventana de cli() de WS2812_MOSTRAR (unos 30 µs por LED: 1,9 ms con 8x8 y 7,7 ms
+// con 16x16) para que el Timer2 no pierda ticks mientras se envía un cuadro, así que se deriva de la cantidad de LEDs
+#ifndef ANIM_TICK_MS  // Permite fijar la resolución desde las opciones del compilador
+#if NUM_LEDS * 3 / 100 < 4  // Si la ventana de cli() entra en 4 ms
+#define ANIM_TICK_MS          4  // Resolución del planificador en ms
+#else  // Matrices grandes (más de 133 LEDs)
+#define ANIM_TICK_MS          (NUM_LEDS * 3 / 100 + 1)  // Resolución del planificador en ms, 1 ms más que la ventana de cli()
+#endif  // Fin de la selección del tick
+#endif  // Fin de la comprobación de ANIM_TICK_MS
+#define ANIM_SIN_TRANSPARENCIA 0xFF  // Valor de "transparente" que indica que ningún índice de la paleta es transparente
+
+#define ANIM_1BIT     0  // Tipo de sprite monocromo (1 bit por píxel)
+#define ANIM_PALETA   1  // Tipo de sprite de paleta (4 bits por píxel, hasta 16 colores)
+
+typedef struct {  // Sprite monocromo almacenado en flash: los bits en 1 se pintan con la tinta, los bits en 0 son transparentes
+    uint8_t ancho;  // Ancho del sprite en píxeles
+    uint8_t alto;  // Alto del sprite en píxeles
+    const uint8_t *datos;  // Filas empaquetadas en flash, (ancho + 7) / 8 bytes por fila, el bit 7 es la columna izquierda
+} SPRITE_1BIT;
+
+typedef struct {  // Sprite de paleta almacenado en flash con 4 bits por píxel
+    uint8_t ancho;  // Ancho del sprite en píxeles
+    uint8_t alto;  // Alto del sprite en píxeles
+    uint8_t transparente;  // Índice de la paleta que no se dibuja (ANIM_SIN_TRANSPARENCIA si todos se dibujan)
+    const uint8_t *paleta;  // Paleta en flash con 3 bytes por color en orden R, G, B
+    const uint8_t *datos;  // Píxeles en flash, 2 por byte, el nibble alto es el píxel de la izquierda
+} SPRITE_PALETA;
+
+typedef struct {  // Cuadro clave de una secuencia de animación almacenado en flash
+    const void *sprite;  // Puntero al SPRITE_1BIT o SPRITE_PALETA (en flash) que se dibuja en este cuadro
+    uint8_t tipo;  // Tipo de sprite: ANIM_1BIT o ANIM_PALETA
+    int8_t x;  // Columna donde se ubica la esquina superior izquierda (puede ser negativa para recortar)
+    int8_t y;  // Fila donde se ubica la esquina superior izquierda (puede ser negativa para recortar)
+    uint8_t r, g, b;  // Color de tinta usado por los sprites de 1 bit (ignorado en los de paleta)
+    uint16_t duracion_ms;  // Tiempo que el cuadro permanece visible en milisegundos
+} CUADRO_CLAVE;
+
+extern const SPRITE_1BIT SPRITE_ALIEN PROGMEM;  // Alien tipo Space Invaders portado de FIG_ALIEN (Matriz_Led.txt)
+extern const SPRITE_1BIT SPRITE_CORAZON PROGMEM;  // Corazón portado de FIG_HEART (Matriz_Led.txt)
+extern const SPRITE_1BIT SPRITE_ROMBO PROGMEM;  // Rombo portado de FIG_DIAMOND (Matriz_Led.txt)
+extern const SPRITE_1BIT SPRITE_CARA_FELIZ PROGMEM;  // Cara feliz portada de Matriz Caras (tabla sin invertir)
+extern const SPRITE_1BIT SPRITE_CARA_TRISTE PROGMEM;  // Cara triste portada de Matriz Caras (tabla sin invertir)
+extern const SPRITE_PALETA SPRITE_CORAZON_COLOR PROGMEM;  // Corazón de paleta con contorno, relleno y brillo
+extern const CUADRO_CLAVE SECUENCIA_FIGURAS[] PROGMEM;  // Secuencia alien, corazón y rombo de 2 s cada uno (equivalente a Matriz_Led.txt)
+extern const uint8_t SECUENCIA_FIGURAS_N;  // Cantidad de cuadros de SECUENCIA_FIGURAS
+
+void ANIM_INICIAR(void);  // Prototipo para inicializar el doble buffer y el Timer2 como base de tiempo del planificador
+uint8_t (*ANIM_BUFFER_TRASERO(void))[3];  // Prototipo que devuelve el buffer donde se compone el próximo cuadro
+uint8_t (*ANIM_BUFFER_FRENTE(void))[3];  // Prototipo que devuelve el buffer que se está mostrando
+void ANIM_INTERCAMBIAR(void);  // Prototipo para intercambiar los buffers y enviar el nuevo frente a la matriz
+void ANIM_DIBUJAR_1BIT(uint8_t (*leds)[3], const SPRITE_1BIT *sprite, int8_t x, int8_t y, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para copiar un sprite de 1 bit con recorte
+void ANIM_DIBUJAR_PALETA(uint8_t (*leds)[3], const SPRITE_PALETA *sprite, int8_t x, int8_t y);  // Prototipo para copiar un sprite de paleta con color transparente y recorte
+void ANIM_REPRODUCIR(const CUADRO_CLAVE *cuadros, uint8_t n, uint8_t repetir);  // Prototipo para iniciar la reproducción de una secuencia de cuadros clave
+void ANIM_DETENER(void);  // Prototipo para detener la secuencia en curso
+uint8_t ANIM_ACTIVA(void);  // Prototipo que indica si hay una secuencia en reproducción
+uint8_t ANIM_ACTUALIZAR(void);  // Prototipo que compone el próximo cuadro y lo muestra cuando vence el tiempo del actual (llamar en el bucle principal)
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
@@ -0,0 +1,94 @@
+#ifndef FILTROS_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define FILTROS_H  // Marca el inicio del bloque protegido de inclusión
+
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+
+// Filtros de una muestra por llamada, en enteros y sin punto flotante ni divisiones. Las muestras son int16_t, por lo que
+// sirven tanto para lecturas del ADC (0 a 1023, o más bits con sobremuestreo) como para valores Q8.8 o Q15.
+// Todas las funciones son static inline: la librería es solo este archivo de cabecera.
+
+typedef struct {  // Promedio móvil de 2^k muestras sobre un buffer circular
+    int16_t *buffer;  // Buffer de 2^k muestras provisto por el programa
+    int32_t suma;  // Suma de las muestras del buffer
+    uint8_t k;  // Logaritmo en base 2 del largo de la ventana (1 a 8: la posición es de 8 bits)
+    uint8_t pos;  // Posición de la muestra más antigua
+} FILTRO_PROMEDIO;
+
+typedef struct {  // Filtro IIR de primer orden y[n] = y[n-1] + (x[n] - y[n-1]) / 2^k
+    int32_t estado;  // Salida escalada por 2^k (guarda los bits fraccionarios para que no haya zona muerta)
+    uint8_t k;  // Coeficiente como desplazamiento: alfa = 1 / 2^k
+} FILTRO_IIR;
+
+typedef struct {  // Mediana de 3 muestras
+    int16_t v[2];  // Las dos muestras anteriores
+} FILTRO_MEDIANA3;
+
+typedef struct {  // Mediana de 5 muestras
+    int16_t v[5];  // Ventana circular de muestras
+    uint8_t pos;  // Posición donde se escribe la próxima muestra
+} FILTRO_MEDIANA5;
+
+static inline void FILTRO_PROMEDIO_INICIAR(FILTRO_PROMEDIO *f, int16_t *buffer, uint8_t k, int16_t inicial) {  // Prepara el promedio móvil con la ventana llena de un valor inicial
+    f->buffer = buffer;  // Se guarda el buffer de la ventana
+    f->k = k;  // Se guarda el largo de la ventana como potencia de 2
+    f->pos = 0;  // Se empieza por la primera posición
+    for (uint16_t i = 0; i < (uint16_t)(1 << k); i++) buffer[i] = inicial;  // Se llena la ventana para evitar el transitorio desde 0 (con k = 8 son 256 muestras, que no entran en 8 bits)
+    f->suma = (int32_t)inicial << k;  // La suma corresponde a la ventana llena
+}
+
+static inline int16_t FILTRO_PROMEDIO_ACTUALIZAR(FILTRO_PROMEDIO *f, int16_t x) {  // Agrega una muestra y devuelve el promedio en O(1)
+    f->suma += (int32_t)x - f->buffer[f->pos];  // Entra la muestra nueva y sale la más antigua (en 32 bits: la resta de dos Q15 no entra en int)
+    f->buffer[f->pos] = x;  // Se reemplaza la muestra más antigua
+    f->pos = (f->pos + 1) & ((1 << f->k) - 1);  // Se avanza en el buffer circular
+    return (int16_t)(f->suma >> f->k);  // Promedio por desplazamiento
+}
+
+static inline void FILTRO_IIR_INICIAR(FILTRO_IIR *f, uint8_t k, int16_t inicial) {  // Prepara el filtro IIR con la salida en un valor inicial
+    f->k = k;  // Se guarda el coeficiente (k = 1 a 8; constante de tiempo de ~2^k muestras)
+    f->estado = (int32_t)inicial << k;  // Se arranca en el valor inicial escalado
+}
+
+static inline int16_t FILTRO_IIR_ACTUALIZAR(FILTRO_IIR *f, int16_t x) {  // Agrega una muestra y devuelve la salida filtrada
+    f->estado += x - (f->estado >> f->k);  // estado = estado * (1 - 1/2^k) + x, equivalente a y += (x - y) / 2^k
+    return (int16_t)(f->estado >> f->k);  // Se quita la escala
+}
+
+static inline int16_t FILTRO_MEDIANA_DE_3(int16_t a, int16_t b, int16_t c) {  // Devuelve la mediana de tres valores con a lo sumo tres comparaciones
+    if (a > b) { int16_t t = a; a = b; b = t; }  // Ahora a <= b
+    if (b > c) b = (a > c) ? a : c;  // Si c es menor que b la mediana es el mayor entre a y c
+    return b;  // Mediana
+}
+
+static inline void FILTRO_MEDIANA3_INICIAR(FILTRO_MEDIANA3 *f, int16_t inicial) {  // Prepara la mediana de 3 con la ventana llena de un valor inicial
+    f->v[0] = f->v[1] = inicial;  // Se cargan las muestras anteriores
+}
+
+static inline int16_t FILTRO_MEDIANA3_ACTUALIZAR(FILTRO_MEDIANA3 *f, int16_t x) {  // Agrega una muestra y devuelve la mediana de las últimas 3
+    int16_t m = FILTRO_MEDIANA_DE_3(f->v[0], f->v[1], x);  // Mediana de la ventana
+    f->v[0] = f->v[1];  // Se corre la ventana
+    f->v[1] = x;  // Entra la muestra nueva
+    return m;  // Se devuelve la mediana
+}
+
+static inline void FILTRO_MEDIANA5_INICIAR(FILTRO_MEDIANA5 *f, int16_t inicial) {  // Prepara la mediana de 5 con la ventana llena de un valor inicial
+    for (uint8_t i = 0; i < 5; i++) f->v[i] = inicial;  // Se cargan las muestras
+    f->pos = 0;  // Se empieza por la primera posición
+}
+
+#define FILTRO_ORDENAR2(a, b) do { if ((a) > (b)) { int16_t t_ = (a); (a) = (b); (b) = t_; } } while (0)  // Intercambio condicional de la red de ordenamiento
+
+static inline int16_t FILTRO_MEDIANA5_ACTUALIZAR(FILTRO_MEDIANA5 *f, int16_t x) {  // Agrega una muestra y devuelve la mediana de las últimas 5
+    f->v[f->pos] = x;  // Entra la muestra nueva en lugar de la más antigua
+    if (++f->pos >= 5) f->pos = 0;  // Se avanza en la ventana circular
+    int16_t a = f->v[0], b = f->v[1], c = f->v[2], d = f->v[3], e = f->v[4];  // Copia de la ventana para ordenar
+    FILTRO_ORDENAR2(a, b);  // Red de selección de la mediana de 5 (7 comparaciones)
+    FILTRO_ORDENAR2(d, e);  // Se ordenan los pares (a, b) y (d, e)
+    FILTRO_ORDENAR2(a, d);  // a pasa a ser el menor de los cuatro y se descarta
+    FILTRO_ORDENAR2(b, e);  // e pasa a ser el mayor de los cuatro y se descarta
+    FILTRO_ORDENAR2(b, c);  // Quedan b, c y d como candidatos
+    FILTRO_ORDENAR2(c, d);  // d pasa a ser el mayor de los candidatos
+    FILTRO_ORDENAR2(b, c);  // c queda en el medio
+    return c;  // Mediana
+}
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
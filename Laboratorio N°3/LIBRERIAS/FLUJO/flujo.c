@@ -0,0 +1,152 @@
+#include "flujo.h"  // Se incluye el archivo de cabecera con el formato de los cuadros y los prototipos
+#include <util/delay.h>  // Se incluye para medir el silencio de la línea con _delay_us()
+#include <string.h>  // Se incluye para copiar el cuadro anterior con memcpy()
+
+#define FLUJO_BYTES  (NUM_LEDS * 3)  // Cantidad de bytes de un cuadro completo
+
+enum {  // Estados del decodificador
+    ESPERA_SINCRONISMO,  // Se descartan bytes hasta encontrar FLUJO_SINCRONISMO
+    ESPERA_TIPO,  // Se espera el tipo de cuadro
+    ESPERA_LARGO_L,  // Se espera el byte bajo del largo
+    ESPERA_LARGO_H,  // Se espera el byte alto del largo
+    RECIBIENDO_DATOS,  // Se decodifican los datos
+    ESPERA_CHECKSUM  // Se espera el byte de verificación
+};
+
+static uint8_t buffers[2][NUM_LEDS][3];  // Doble buffer: uno se muestra mientras en el otro se decodifica el siguiente cuadro
+static uint8_t frente = 0;  // Índice del buffer que está en la matriz
+
+static uint8_t estado = ESPERA_SINCRONISMO;  // Estado actual del decodificador
+static uint8_t tipo;  // Tipo del cuadro en curso
+static uint16_t largo;  // Bytes de datos que faltan recibir
+static uint8_t suma;  // Suma acumulada para el checksum
+static uint8_t *destino;  // Inicio del buffer trasero como arreglo de bytes
+static uint16_t pos;  // Próximo byte a escribir en el buffer trasero
+static uint8_t grupo[4];  // Bytes del grupo RLE o del encabezado delta en curso
+static uint8_t n_grupo;  // Cantidad de bytes acumulados en 'grupo'
+static uint16_t literales;  // Bytes de píxeles literales que faltan en el grupo delta en curso
+static uint8_t error;  // Indica que el cuadro en curso ya es inválido (se sigue consumiendo hasta el checksum)
+
+void FLUJO_INICIAR(void) {  // Prepara la UART y los buffers para el modo de transmisión en vivo
+    UART_INICIAR(FLUJO_UBRR);  // Se configura la UART a la velocidad del modo en vivo
+    UART_HABILITAR_RX_INT();  // La recepción pasa a interrupción para decodificar mientras llegan los bytes
+    WS2812_LIMPIAR(buffers[0]);  // Se apaga el primer buffer
+    WS2812_LIMPIAR(buffers[1]);  // Se apaga el segundo buffer
+    frente = 0;  // El primer buffer pasa a ser el visible
+    FLUJO_REINICIAR();  // El decodificador queda esperando un sincronismo
+}
+
+void FLUJO_REINICIAR(void) {  // Descarta el cuadro en curso
+    estado = ESPERA_SINCRONISMO;  // Se vuelve a buscar el inicio de un cuadro
+}
+
+static void flujo_pixel(uint8_t dato) {  // Escribe un byte de píxel en el buffer trasero verificando que no se pase del cuadro
+    if (pos >= FLUJO_BYTES) { error = 1; return; }  // Un cuadro con más píxeles que la matriz es inválido
+    destino[pos++] = dato;  // Se guarda el byte y se avanza
+}
+
+static void flujo_datos(uint8_t dato) {  // Decodifica un byte de datos según el tipo de cuadro
+    if (tipo == FLUJO_CRUDO) {  // Cuadro sin compresión
+        flujo_pixel(dato);  // Cada byte va directo al buffer
+    } else if (tipo == FLUJO_RLE) {  // Cuadro por longitud de corrida
+        grupo[n_grupo++] = dato;  // Se acumula el grupo [n - 1, G, R, B]
+        if (n_grupo < 4) return;  // Se espera hasta completar el grupo
+        n_grupo = 0;  // El próximo byte empieza otro grupo
+        uint16_t n = grupo[0] + 1;  // Cantidad de píxeles de la corrida
+        if (pos + n * 3 > FLUJO_BYTES) { error = 1; return; }  // La corrida no puede salirse de la matriz
+        uint8_t *p = destino + pos;  // Primer píxel de la corrida
+        pos += n * 3;  // Se avanza la posición de escritura
+        while (n--) {  // Se repite el color en toda la corrida
+            *p++ = grupo[1];  // Componente verde
+            *p++ = grupo[2];  // Componente roja
+            *p++ = grupo[3];  // Componente azul
+        }
+    } else {  // Cuadro delta
+        if (literales) {  // Si se están recibiendo los píxeles del grupo
+            flujo_pixel(dato);  // Se reemplaza el byte del cuadro anterior
+            literales--;  // Queda un byte menos del grupo
+            return;  // Se sigue con el próximo byte
+        }
+        grupo[n_grupo++] = dato;  // Se acumula el encabezado [salto, n]
+        if (n_grupo < 2) return;  // Se espera hasta completar el encabezado
+        n_grupo = 0;  // El próximo encabezado empieza de cero
+        pos += grupo[0] * 3;  // Se conservan 'salto' píxeles del cuadro anterior
+        literales = grupo[1] * 3;  // Se esperan n píxeles nuevos
+    }
+}
+
+uint8_t FLUJO_PROCESAR(uint8_t dato) {  // Avanza el decodificador con un byte recibido
+    switch (estado) {  // Se actúa según el estado
+    case ESPERA_SINCRONISMO:  // Buscando el inicio de un cuadro
+        if (dato == FLUJO_SINCRONISMO) estado = ESPERA_TIPO;  // Se encontró el sincronismo
+        return FLUJO_PENDIENTE;  // Los demás bytes se descartan
+
+    case ESPERA_TIPO:  // Se recibe el tipo de cuadro
+        tipo = dato;  // Se guarda el tipo
+        suma = dato;  // Se comienza la suma de verificación
+        estado = ESPERA_LARGO_L;  // Sigue el largo
+        return FLUJO_PENDIENTE;  // El cuadro no terminó
+
+    case ESPERA_LARGO_L:  // Se recibe el byte bajo del largo
+        largo = dato;  // Se guarda la parte baja
+        suma += dato;  // Se acumula en la suma
+        estado = ESPERA_LARGO_H;  // Sigue la parte alta
+        return FLUJO_PENDIENTE;  // El cuadro no terminó
+
+    case ESPERA_LARGO_H:  // Se recibe el byte alto del largo y se prepara el buffer trasero
+        largo |= (uint16_t)dato << 8;  // Se completa el largo
+        suma += dato;  // Se acumula en la suma
+        destino = buffers[frente ^ 1][0];  // Se decodifica sobre el buffer que no se muestra
+        pos = 0;  // Se empieza por el primer píxel
+        n_grupo = 0;  // No hay grupo en curso
+        literales = 0;  // No hay píxeles delta pendientes
+        error = (tipo > FLUJO_DELTA) || (tipo == FLUJO_CRUDO && largo != FLUJO_BYTES);  // Se validan el tipo y el largo del cuadro crudo
+        if (tipo == FLUJO_DELTA) memcpy(destino, buffers[frente], FLUJO_BYTES);  // El delta parte del cuadro que se está mostrando
+        estado = largo ? RECIBIENDO_DATOS : ESPERA_CHECKSUM;  // Un cuadro delta sin datos repite el anterior
+        return FLUJO_PENDIENTE;  // El cuadro no terminó
+
+    case RECIBIENDO_DATOS:  // Se decodifican los datos
+        suma += dato;  // Se acumula en la suma
+        if (!error) flujo_datos(dato);  // Si el cuadro sigue siendo válido se decodifica el byte
+        if (--largo == 0) estado = ESPERA_CHECKSUM;  // Al terminar los datos sigue el checksum
+        return FLUJO_PENDIENTE;  // El cuadro no terminó
+
+    default:  // ESPERA_CHECKSUM: se verifica el cuadro completo
+        estado = ESPERA_SINCRONISMO;  // El próximo byte debe iniciar otro cuadro
+        suma += dato;  // Se suma el checksum
+        if (error || suma != 0 || n_grupo || literales) return FLUJO_INVALIDO;  // Error de formato, de suma o grupo incompleto
+        if (tipo == FLUJO_RLE && pos != FLUJO_BYTES) return FLUJO_INVALIDO;  // Un cuadro RLE debe cubrir toda la matriz
+        return FLUJO_CUADRO;  // El buffer trasero contiene un cuadro válido
+    }
+}
+
+void FLUJO_MOSTRAR(void) {  // Muestra el cuadro decodificado y habilita al host a enviar el siguiente
+    frente ^= 1;  // El buffer trasero pasa a ser el visible
+    WS2812_MOSTRAR(buffers[frente]);  // Se envía el cuadro a la matriz (con las interrupciones deshabilitadas)
+    UART_ENVIAR(FLUJO_LISTO);  // Recién después de la ventana sin interrupciones se pide el próximo cuadro
+}
+
+void FLUJO_EJECUTAR(void) {  // Bucle del modo en vivo: recibe, decodifica y muestra cuadros indefinidamente
+    uint16_t silencio = 0;  // Tiempo sin datos en decenas de microsegundos
+
+    FLUJO_INICIAR();  // Se prepara la UART y los buffers
+    UART_ENVIAR(FLUJO_LISTO);  // Se avisa al host que puede enviar el primer cuadro
+
+    while (1) {  // Bucle principal del modo en vivo
+        if (!UART_DISPONIBLE()) {  // Si no hay bytes en el buffer de recepción
+            _delay_us(10);  // Se espera un instante
+            if (estado != ESPERA_SINCRONISMO && ++silencio >= FLUJO_SILENCIO_MS * 100) {  // Si un cuadro quedó cortado
+                FLUJO_REINICIAR();  // Se descarta lo recibido
+                UART_ENVIAR(FLUJO_RECHAZO);  // Se avisa al host para que reenvíe
+            }
+            continue;  // Se vuelve a consultar
+        }
+        silencio = 0;  // Llegó un byte: se reinicia el contador de silencio
+        uint8_t r = FLUJO_PROCESAR(UART_LEER());  // Se decodifica el byte
+        if (r == FLUJO_CUADRO) FLUJO_MOSTRAR();  // Si el cuadro está completo se muestra y se pide el siguiente
+        else if (r == FLUJO_INVALIDO || UART_RX_DESBORDE()) {  // Si el cuadro era inválido o se perdieron bytes
+            FLUJO_REINICIAR();  // Se descarta el cuadro en curso
+            UART_ENVIAR(FLUJO_RECHAZO);  // Se pide al host que envíe otro cuadro
+        }
+    }
+}
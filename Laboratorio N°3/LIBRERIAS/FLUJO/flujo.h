@@ -0,0 +1,44 @@
+#ifndef FLUJO_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define FLUJO_H  // Marca el inicio del bloque protegido de inclusión
+
+#ifndef F_CPU  // Verifica si no está definida la frecuencia del microcontrolador
+#define F_CPU 16000000UL  // Define la frecuencia del reloj principal en 16 MHz
+#endif  // Fin de la comprobación de F_CPU
+
+#include <avr/io.h>  // Se incluye la librería para acceder a los registros del microcontrolador
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+#include "uart.h"  // Se incluye la librería UART por la que llegan los cuadros
+#include "ws2812.h"  // Se incluye la librería de la matriz WS2812 donde se muestran los cuadros
+
+// Formato de un cuadro enviado por el host:
+//   FLUJO_SINCRONISMO | tipo | largo (2 bytes, little endian) | datos (largo bytes) | checksum
+// El checksum hace que la suma de tipo, largo, datos y checksum sea 0 (módulo 256).
+// Los píxeles van en orden lógico (fila por fila) y cada uno ocupa 3 bytes en orden G, R, B.
+//   FLUJO_CRUDO: NUM_LEDS * 3 bytes con todos los píxeles
+//   FLUJO_RLE:   grupos [n - 1, G, R, B] que repiten un color n veces (1 a 256) hasta cubrir la matriz
+//   FLUJO_DELTA: grupos [salto, n, n * (G, R, B)] que conservan 'salto' píxeles del cuadro anterior y reemplazan los n siguientes
+// Control de flujo: después de mostrar cada cuadro el microcontrolador envía FLUJO_LISTO y recién entonces
+// el host envía el siguiente, así nunca llegan bytes mientras WS2812_MOSTRAR tiene las interrupciones deshabilitadas.
+
+#define FLUJO_SINCRONISMO  0xA5  // Byte que marca el inicio de un cuadro
+#define FLUJO_CRUDO        0  // Tipo de cuadro sin compresión
+#define FLUJO_RLE          1  // Tipo de cuadro codificado por longitud de corrida
+#define FLUJO_DELTA        2  // Tipo de cuadro codificado como diferencias contra el cuadro anterior
+
+#define FLUJO_LISTO        0x06  // Byte (ACK) que indica al host que puede enviar el siguiente cuadro
+#define FLUJO_RECHAZO      0x15  // Byte (NAK) que indica que el cuadro recibido era inválido y se descartó
+
+#define FLUJO_UBRR         0  // Valor de UBRR para 1 Mbaud exacto a 16 MHz (1 para 500 kbaud)
+#define FLUJO_SILENCIO_MS  20  // Tiempo sin datos a mitad de un cuadro tras el cual se lo descarta
+
+#define FLUJO_PENDIENTE    0  // Resultado de FLUJO_PROCESAR: el cuadro todavía no terminó
+#define FLUJO_CUADRO       1  // Resultado de FLUJO_PROCESAR: hay un cuadro válido en el buffer trasero
+#define FLUJO_INVALIDO     2  // Resultado de FLUJO_PROCESAR: el cuadro tenía formato o checksum incorrecto
+
+void FLUJO_INICIAR(void);  // Prototipo para configurar la UART a FLUJO_UBRR con recepción por interrupción y limpiar los buffers
+uint8_t FLUJO_PROCESAR(uint8_t dato);  // Prototipo que decodifica un byte recibido dentro del buffer trasero
+void FLUJO_REINICIAR(void);  // Prototipo para descartar el cuadro a medio recibir y esperar un nuevo sincronismo
+void FLUJO_MOSTRAR(void);  // Prototipo para intercambiar los buffers, enviar el cuadro a la matriz y pedir el siguiente
+void FLUJO_EJECUTAR(void);  // Prototipo del bucle del modo de transmisión en vivo (no retorna)
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
@@ -0,0 +1,109 @@
+#include "gcode.h"  // Se incluye el archivo de cabecera con el formato del bloque y los prototipos
+#include "uart.h"  // Se incluye la librería UART por la que llegan las líneas
+
+uint8_t GCODE_RECIBIR_LINEA(char *linea) {  // Espera una línea terminada en '\n' o '\r' y la deja en 'linea'
+    uint8_t n = 0;  // Caracteres guardados
+    uint8_t completa = 1;  // Indica que la línea entró entera en el buffer
+    while (1) {  // Se leen caracteres hasta el fin de línea
+        char c = UART_LEER();  // Se espera el próximo carácter
+        if (c == '\n' || c == '\r') {  // Fin de línea
+            if (n == 0 && completa) continue;  // Se ignoran las líneas vacías y el '\n' de un "\r\n"
+            break;  // Se terminó la línea
+        }
+        if (n < GCODE_LINEA_MAX - 1) linea[n++] = c;  // Se guarda el carácter si hay lugar
+        else completa = 0;  // Si no, la línea se descarta al terminar
+    }
+    linea[n] = '\0';  // Terminador de la cadena
+    return completa;  // Se informa si la línea es utilizable
+}
+
+static const char *gcode_numero(const char *p, int32_t *valor) {  // Lee un número decimal en milésimas; devuelve NULL si no hay dígitos o no entra en int32_t
+    uint8_t negativo = 0;  // Signo del número
+    uint8_t digitos = 0;  // Cantidad de dígitos leídos
+    int32_t entero = 0;  // Parte entera
+    int32_t fraccion = 0;  // Parte fraccionaria en milésimas
+    int32_t peso = 100;  // Peso del próximo dígito decimal en milésimas
+    uint8_t decimales = 0;  // Cantidad de decimales leídos
+
+    while (*p == ' ') p++;  // Se permiten espacios entre la letra y el número
+    if (*p == '-' || *p == '+') negativo = (*p++ == '-');  // Signo opcional
+    while (*p >= '0' && *p <= '9') {  // Parte entera
+        entero = entero * 10 + (*p - '0');  // Se agrega el dígito
+        if (entero > 2147482L) return 0;  // Más grande no entra en int32_t al pasar a milésimas (con el redondeo): es un error
+        p++; digitos++;  // Se avanza
+    }
+    if (*p == '.') {  // Parte fraccionaria
+        p++;  // Se saltea el punto
+        while (*p >= '0' && *p <= '9') {  // Dígitos decimales
+            if (peso) fraccion += (*p - '0') * peso;  // Se guardan tres decimales en milésimas
+            else if (decimales == 3 && *p >= '5') fraccion++;  // El cuarto decimal redondea y los demás se ignoran
+            peso /= 10;  // Siguiente decimal
+            decimales++;  // Se cuenta el decimal
+            p++; digitos++;  // Se avanza
+        }
+    }
+    if (!digitos) return 0;  // No había número
+    *valor = entero * 1000 + fraccion;  // Valor en milésimas
+    if (negativo) *valor = -*valor;  // Se aplica el signo
+    return p;  // Posición siguiente al número
+}
+
+uint8_t GCODE_ANALIZAR(const char *linea, GCODE_BLOQUE *b) {  // Analiza una línea de G-code y completa el bloque
+    b->movimiento = GCODE_NINGUNO;  // Sin orden de movimiento
+    b->referencia = GCODE_NINGUNO;  // Sin búsqueda del origen
+    b->distancia = GCODE_NINGUNO;  // Sin cambio de modo de coordenadas
+    b->m = GCODE_NINGUNO;  // Sin orden M
+    b->presentes = 0;  // Sin palabras con valor
+    uint8_t palabras = 0;  // Cantidad de palabras útiles encontradas
+
+    const char *p = linea;  // Posición actual
+    while (*p) {  // Se recorre la línea
+        char letra = *p++;  // Letra de la palabra
+        if (letra == ' ' || letra == '\t') continue;  // Espacios
+        if (letra == ';' || letra == '*') break;  // Comentario o suma de verificación hasta el final de la línea
+        if (letra == '(') {  // Comentario entre paréntesis
+            while (*p && *p != ')') p++;  // Se busca el cierre
+            if (*p) p++;  // Se saltea el paréntesis
+            continue;  // Sigue la línea
+        }
+        if (letra >= 'a' && letra <= 'z') letra -= 'a' - 'A';  // Se pasa a mayúscula
+
+        int32_t valor;  // Valor de la palabra en milésimas
+        p = gcode_numero(p, &valor);  // Se lee el número
+        if (!p) return GCODE_ERROR;  // Toda letra debe estar seguida de un número
+
+        switch (letra) {  // Se guarda según la letra
+        case 'G':  // Orden G
+            if (valor % 1000) return GCODE_ERROR;  // No se admiten subórdenes como G38.2
+            valor /= 1000;  // Número de la orden
+            if (valor >= 0 && valor <= 3) b->movimiento = (int8_t)valor;  // Movimiento
+            else if (valor == 28) b->referencia = 28;  // Búsqueda del origen
+            else if (valor == 90 || valor == 91) b->distancia = (int8_t)valor;  // Coordenadas absolutas o relativas
+            else return GCODE_ERROR;  // Orden no soportada
+            break;  // Fin de la orden G
+        case 'M':  // Orden M (el programa decide cuáles soporta)
+            if (valor < 0 || valor % 1000) return GCODE_ERROR;  // Debe ser un entero positivo
+            b->m = (int16_t)(valor / 1000);  // Número de la orden
+            break;  // Fin de la orden M
+        case 'X': b->x = valor; b->presentes |= GCODE_X; break;  // Coordenada X
+        case 'Y': b->y = valor; b->presentes |= GCODE_Y; break;  // Coordenada Y
+        case 'I': b->i = valor; b->presentes |= GCODE_I; break;  // Centro del arco en X
+        case 'J': b->j = valor; b->presentes |= GCODE_J; break;  // Centro del arco en Y
+        case 'F': b->f = valor; b->presentes |= GCODE_F; break;  // Avance
+        case 'N': continue;  // Número de línea: se ignora
+        default: return GCODE_ERROR;  // Letra no soportada
+        }
+        palabras++;  // Se contó una palabra útil
+    }
+    return palabras ? GCODE_OK : GCODE_VACIA;  // Resultado del análisis
+}
+
+void GCODE_OK_ENVIAR(void) {  // Responde que la línea fue aceptada
+    UART_IMPRIMIR("ok\r\n");  // Respuesta esperada por el host para enviar la siguiente
+}
+
+void GCODE_ERROR_ENVIAR(const char *motivo) {  // Responde que la línea fue rechazada
+    UART_IMPRIMIR("error: ");  // Prefijo de error
+    UART_IMPRIMIR(motivo);  // Motivo
+    UART_IMPRIMIR("\r\n");  // Fin de la respuesta
+}
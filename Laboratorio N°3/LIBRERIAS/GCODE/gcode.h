@@ -0,0 +1,43 @@
+#ifndef GCODE_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define GCODE_H  // Marca el inicio del bloque protegido de inclusión
+
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+
+// Intérprete de un subconjunto de G-code. La librería solo recibe y analiza líneas; qué hace cada orden lo decide el
+// programa. Los valores numéricos se devuelven en milésimas (enteros de 32 bits, sin punto flotante), así "X12.5"
+// queda como 12500. Se ignoran los espacios, los comentarios entre paréntesis o después de ';', los números de
+// línea (N) y las sumas de verificación ('*'), y se aceptan letras minúsculas.
+// Órdenes reconocidas: G0, G1, G2, G3 (movimiento), G28 (búsqueda del origen), G90, G91 (coordenadas absolutas o
+// relativas) y cualquier M.
+
+#define GCODE_LINEA_MAX  72  // Largo máximo de una línea (incluye el terminador)
+
+#define GCODE_VACIA      0  // Resultado de GCODE_ANALIZAR: la línea no tiene órdenes (vacía o solo comentario)
+#define GCODE_OK         1  // Resultado de GCODE_ANALIZAR: el bloque es válido
+#define GCODE_ERROR      2  // Resultado de GCODE_ANALIZAR: la línea tiene una palabra o un número inválido
+
+#define GCODE_X  0x01  // Bandera de 'presentes': hay palabra X
+#define GCODE_Y  0x02  // Bandera de 'presentes': hay palabra Y
+#define GCODE_I  0x04  // Bandera de 'presentes': hay palabra I
+#define GCODE_J  0x08  // Bandera de 'presentes': hay palabra J
+#define GCODE_F  0x10  // Bandera de 'presentes': hay palabra F
+
+#define GCODE_NINGUNO  (-1)  // Valor de 'movimiento', 'referencia', 'distancia' o 'm' cuando la línea no los incluye
+
+typedef struct {  // Bloque de G-code analizado
+    int8_t movimiento;  // 0 a 3 si la línea tiene G0, G1, G2 o G3
+    int8_t referencia;  // 28 si la línea tiene G28
+    int8_t distancia;  // 90 o 91 si la línea tiene G90 o G91
+    int16_t m;  // Número de la orden M
+    uint8_t presentes;  // Palabras con valor presentes en la línea (GCODE_X, GCODE_Y, ...)
+    int32_t x, y;  // Coordenadas del punto final en milésimas
+    int32_t i, j;  // Centro del arco respecto del inicio en milésimas
+    int32_t f;  // Avance en milésimas por minuto
+} GCODE_BLOQUE;
+
+uint8_t GCODE_RECIBIR_LINEA(char *linea);  // Prototipo que espera una línea completa por UART (sin eco) y devuelve 0 si se pasó del largo máximo
+uint8_t GCODE_ANALIZAR(const char *linea, GCODE_BLOQUE *b);  // Prototipo que analiza una línea y completa el bloque
+void GCODE_OK_ENVIAR(void);  // Prototipo que responde "ok" para que el host envíe la línea siguiente
+void GCODE_ERROR_ENVIAR(const char *motivo);  // Prototipo que responde "error: motivo" (el host también puede enviar la siguiente)
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
@@ -0,0 +1,142 @@
+#include "graficos.h"  // Se incluye el archivo de cabecera con los prototipos de las primitivas de dibujo
+#include <string.h>  // Se incluye para mover y borrar bloques de memoria con memmove(), memcpy() y memset()
+
+#define FILA_BYTES  (WS2812_ANCHO * 3)  // Cantidad de bytes que ocupa una fila del buffer lógico
+
+static inline void graf_pintar(uint8_t *led, uint8_t r, uint8_t g, uint8_t b) {  // Escribe un color en un LED del buffer sin verificar límites
+    led[0] = g;  // Se asigna la componente verde (orden GRB)
+    led[1] = r;  // Se asigna la componente roja
+    led[2] = b;  // Se asigna la componente azul
+}
+
+void GRAF_PIXEL(uint8_t (*leds)[3], int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {  // Pinta un píxel solo si cae dentro de la matriz
+    if (x < 0 || y < 0 || x >= WS2812_ANCHO || y >= WS2812_ALTO) return;  // Se descartan las coordenadas fuera de la matriz
+    graf_pintar(leds[(uint16_t)y * WS2812_ANCHO + x], r, g, b);  // Se pinta el LED correspondiente
+}
+
+void GRAF_LINEA(uint8_t (*leds)[3], int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t r, uint8_t g, uint8_t b) {  // Traza una línea entre dos puntos con el algoritmo de Bresenham
+    int16_t dx = (x1 > x0) ? x1 - x0 : x0 - x1;  // Distancia horizontal absoluta
+    int16_t dy = (y1 > y0) ? y0 - y1 : y1 - y0;  // Distancia vertical absoluta con signo negativo
+    int8_t sx = (x0 < x1) ? 1 : -1;  // Sentido del avance en x
+    int8_t sy = (y0 < y1) ? 1 : -1;  // Sentido del avance en y
+    int16_t err = dx + dy;  // Error acumulado inicial
+
+    if (dy == 0) {  // Si la línea es horizontal se recorta una sola vez y se pinta la fila de corrido
+        if (y0 < 0 || y0 >= WS2812_ALTO) return;  // La fila está fuera de la matriz
+        if (x0 > x1) { int16_t t = x0; x0 = x1; x1 = t; }  // Se ordenan los extremos
+        if (x0 < 0) x0 = 0;  // Se recorta por la izquierda
+        if (x1 >= WS2812_ANCHO) x1 = WS2812_ANCHO - 1;  // Se recorta por la derecha
+        uint8_t *led = leds[(uint16_t)y0 * WS2812_ANCHO + x0];  // Primer LED de la fila
+        for (; x0 <= x1; x0++, led += 3) graf_pintar(led, r, g, b);  // Se pintan los LEDs consecutivos
+        return;  // La línea horizontal queda completa
+    }
+
+    while (1) {  // Se avanza un píxel por iteración
+        GRAF_PIXEL(leds, x0, y0, r, g, b);  // Se pinta el punto actual con recorte
+        if (x0 == x1 && y0 == y1) break;  // Se termina al llegar al extremo final
+        int16_t e2 = 2 * err;  // Se duplica el error para comparar sin fracciones
+        if (e2 >= dy) { err += dy; x0 += sx; }  // Paso en x
+        if (e2 <= dx) { err += dx; y0 += sy; }  // Paso en y
+    }
+}
+
+void GRAF_RELLENAR(uint8_t (*leds)[3], int16_t x, int16_t y, int16_t ancho, int16_t alto, uint8_t r, uint8_t g, uint8_t b) {  // Rellena un rectángulo recortado a la matriz
+    int16_t x1 = x + ancho;  // Columna final (exclusiva)
+    int16_t y1 = y + alto;  // Fila final (exclusiva)
+    if (x < 0) x = 0;  // Se recorta por la izquierda
+    if (y < 0) y = 0;  // Se recorta por arriba
+    if (x1 > WS2812_ANCHO) x1 = WS2812_ANCHO;  // Se recorta por la derecha
+    if (y1 > WS2812_ALTO) y1 = WS2812_ALTO;  // Se recorta por abajo
+    if (x >= x1 || y >= y1) return;  // El rectángulo quedó vacío
+
+    uint8_t *primera = leds[(uint16_t)y * WS2812_ANCHO + x];  // Primer LED de la primera fila
+    uint8_t *led = primera;  // Puntero para recorrer la primera fila
+    for (int16_t c = x; c < x1; c++, led += 3) graf_pintar(led, r, g, b);  // Se pinta solo la primera fila píxel a píxel
+    uint16_t bytes = (uint16_t)(x1 - x) * 3;  // Bytes que ocupa el tramo pintado
+    for (int16_t f = y + 1; f < y1; f++) memcpy(primera + (uint16_t)(f - y) * FILA_BYTES, primera, bytes);  // Las demás filas se copian en bloque
+}
+
+void GRAF_RECTANGULO(uint8_t (*leds)[3], int16_t x, int16_t y, int16_t ancho, int16_t alto, uint8_t r, uint8_t g, uint8_t b) {  // Traza el contorno de un rectángulo
+    if (ancho <= 0 || alto <= 0) return;  // Un rectángulo sin área no se dibuja
+    GRAF_RELLENAR(leds, x, y, ancho, 1, r, g, b);  // Lado superior
+    GRAF_RELLENAR(leds, x, y + alto - 1, ancho, 1, r, g, b);  // Lado inferior
+    GRAF_RELLENAR(leds, x, y, 1, alto, r, g, b);  // Lado izquierdo
+    GRAF_RELLENAR(leds, x + ancho - 1, y, 1, alto, r, g, b);  // Lado derecho
+}
+
+void GRAF_CIRCULO(uint8_t (*leds)[3], int16_t xc, int16_t yc, int16_t radio, uint8_t r, uint8_t g, uint8_t b) {  // Traza una circunferencia con el algoritmo del punto medio
+    int16_t x = radio;  // Se parte del punto (radio, 0) del primer octante
+    int16_t y = 0;  // Coordenada y inicial
+    int16_t err = 1 - radio;  // Variable de decisión del punto medio
+    if (radio < 0) return;  // Un radio negativo no se dibuja
+
+    while (x >= y) {  // Se recorre un octante y se refleja en los otros siete
+        GRAF_PIXEL(leds, xc + x, yc + y, r, g, b);  // Octante 1
+        GRAF_PIXEL(leds, xc + y, yc + x, r, g, b);  // Octante 2
+        GRAF_PIXEL(leds, xc - y, yc + x, r, g, b);  // Octante 3
+        GRAF_PIXEL(leds, xc - x, yc + y, r, g, b);  // Octante 4
+        GRAF_PIXEL(leds, xc - x, yc - y, r, g, b);  // Octante 5
+        GRAF_PIXEL(leds, xc - y, yc - x, r, g, b);  // Octante 6
+        GRAF_PIXEL(leds, xc + y, yc - x, r, g, b);  // Octante 7
+        GRAF_PIXEL(leds, xc + x, yc - y, r, g, b);  // Octante 8
+        y++;  // Se avanza siempre en y
+        if (err < 0) {  // Si el punto medio queda dentro de la circunferencia
+            err += 2 * y + 1;  // Se mantiene x
+        } else {  // Si el punto medio queda fuera
+            x--;  // Se retrocede en x
+            err += 2 * (y - x) + 1;  // Se actualiza la decisión
+        }
+    }
+}
+
+void GRAF_DESPLAZAR(uint8_t (*leds)[3], int8_t dx, int8_t dy) {  // Corre la imagen dx columnas y dy filas, apagando lo que queda libre
+    uint8_t *base = leds[0];  // Inicio del buffer como arreglo de bytes
+
+    if (dy >= WS2812_ALTO || dy <= -WS2812_ALTO || dx >= WS2812_ANCHO || dx <= -WS2812_ANCHO) {  // Si la imagen sale completa de la matriz
+        memset(base, 0, NUM_LEDS * 3);  // Se apaga todo el buffer
+        return;  // No queda nada que mover
+    }
+
+    if (dy > 0) {  // Desplazamiento hacia abajo
+        memmove(base + dy * FILA_BYTES, base, (WS2812_ALTO - dy) * FILA_BYTES);  // Se mueven las filas en un único bloque
+        memset(base, 0, dy * FILA_BYTES);  // Se apagan las filas superiores que quedaron libres
+    } else if (dy < 0) {  // Desplazamiento hacia arriba
+        memmove(base, base - dy * FILA_BYTES, (WS2812_ALTO + dy) * FILA_BYTES);  // Se mueven las filas en un único bloque
+        memset(base + (WS2812_ALTO + dy) * FILA_BYTES, 0, -dy * FILA_BYTES);  // Se apagan las filas inferiores que quedaron libres
+    }
+
+    if (dx == 0) return;  // Sin desplazamiento horizontal no hay más que hacer
+    for (uint8_t f = 0; f < WS2812_ALTO; f++) {  // Se corre cada fila por separado
+        uint8_t *fila = base + f * FILA_BYTES;  // Inicio de la fila
+        if (dx > 0) {  // Desplazamiento hacia la derecha
+            memmove(fila + dx * 3, fila, (WS2812_ANCHO - dx) * 3);  // Se mueve el tramo que sigue visible
+            memset(fila, 0, dx * 3);  // Se apagan las columnas izquierdas
+        } else {  // Desplazamiento hacia la izquierda
+            memmove(fila, fila - dx * 3, (WS2812_ANCHO + dx) * 3);  // Se mueve el tramo que sigue visible
+            memset(fila + (WS2812_ANCHO + dx) * 3, 0, -dx * 3);  // Se apagan las columnas derechas
+        }
+    }
+}
+
+void GRAF_ROTAR(uint8_t (*leds)[3], int8_t dx, int8_t dy) {  // Corre la imagen dx columnas y dy filas, reinsertando por el borde opuesto lo que sale
+    uint8_t *base = leds[0];  // Inicio del buffer como arreglo de bytes
+    uint8_t temp[FILA_BYTES];  // Buffer auxiliar de una fila
+    int8_t ky = dy % WS2812_ALTO;  // Filas a rotar reducidas al alto de la matriz
+    int8_t kx = dx % WS2812_ANCHO;  // Columnas a rotar reducidas al ancho de la matriz
+    if (ky < 0) ky += WS2812_ALTO;  // Se expresa la rotación vertical siempre hacia abajo
+    if (kx < 0) kx += WS2812_ANCHO;  // Se expresa la rotación horizontal siempre hacia la derecha
+
+    while (ky--) {  // Se rota de a una fila para usar un único buffer auxiliar chico
+        memcpy(temp, base + (WS2812_ALTO - 1) * FILA_BYTES, FILA_BYTES);  // Se guarda la última fila
+        memmove(base + FILA_BYTES, base, (WS2812_ALTO - 1) * FILA_BYTES);  // Se bajan las demás filas en un único bloque
+        memcpy(base, temp, FILA_BYTES);  // La fila guardada pasa a ser la primera
+    }
+
+    if (kx == 0) return;  // Sin rotación horizontal no hay más que hacer
+    for (uint8_t f = 0; f < WS2812_ALTO; f++) {  // Se rota cada fila por separado
+        uint8_t *fila = base + f * FILA_BYTES;  // Inicio de la fila
+        memcpy(temp, fila + (WS2812_ANCHO - kx) * 3, kx * 3);  // Se guardan las columnas que salen por la derecha
+        memmove(fila + kx * 3, fila, (WS2812_ANCHO - kx) * 3);  // Se corre el resto de la fila
+        memcpy(fila, temp, kx * 3);  // Las columnas guardadas entran por la izquierda
+    }
+}
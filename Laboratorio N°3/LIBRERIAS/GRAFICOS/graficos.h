@@ -0,0 +1,16 @@
+#ifndef GRAFICOS_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define GRAFICOS_H  // Marca el inicio del bloque protegido de inclusión
+
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+#include "ws2812.h"  // Se incluye la librería de la matriz WS2812 cuyo buffer lógico se dibuja
+
+// Todas las primitivas trabajan sobre el buffer lógico (índice = y * WS2812_ANCHO + x) y recortan lo que quede fuera de la matriz
+void GRAF_PIXEL(uint8_t (*leds)[3], int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para pintar un píxel con recorte
+void GRAF_LINEA(uint8_t (*leds)[3], int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para trazar una línea con el algoritmo de Bresenham
+void GRAF_RECTANGULO(uint8_t (*leds)[3], int16_t x, int16_t y, int16_t ancho, int16_t alto, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para trazar el contorno de un rectángulo
+void GRAF_RELLENAR(uint8_t (*leds)[3], int16_t x, int16_t y, int16_t ancho, int16_t alto, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para rellenar un rectángulo
+void GRAF_CIRCULO(uint8_t (*leds)[3], int16_t xc, int16_t yc, int16_t radio, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para trazar una circunferencia con el algoritmo del punto medio
+void GRAF_DESPLAZAR(uint8_t (*leds)[3], int8_t dx, int8_t dy);  // Prototipo para correr la imagen dejando apagado lo que queda libre (shift)
+void GRAF_ROTAR(uint8_t (*leds)[3], int8_t dx, int8_t dy);  // Prototipo para correr la imagen haciendo reaparecer por el borde opuesto lo que sale (scroll)
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
@@ -0,0 +1,47 @@
+#include "pid.h"  // Se incluye el archivo de cabecera con el estado del controlador y los prototipos
+
+#define PID_SATURAR(v, a, b)  ((v) < (a) ? (a) : ((v) > (b) ? (b) : (v)))  // Limita un valor al rango [a, b]
+
+void PID_INICIAR(PID *pid, int16_t minimo, int16_t maximo, uint8_t filtro_k) {  // Prepara el controlador sin ganancias
+    pid->kp = pid->ki = pid->kd = 0;  // Las ganancias se cargan con PID_GANANCIAS
+    pid->minimo = minimo;  // Se guardan los límites de la salida
+    pid->maximo = maximo;  // Ídem el máximo
+    FILTRO_IIR_INICIAR(&pid->derivada, filtro_k, 0);  // Se fija la constante del filtro de la derivada
+    pid->salida = 0;  // Salida inicial
+    pid->integral = 0;  // Sin integral acumulada
+    pid->anterior = INT16_MIN;  // Marca de que todavía no hay medición anterior
+}
+
+void PID_GANANCIAS(PID *pid, int16_t kp, int16_t ki, int16_t kd) {  // Cambia las ganancias
+    pid->kp = kp;  // La integral ya acumulada no depende de ki, así que la salida no salta
+    pid->ki = ki;  // Ganancia integral
+    pid->kd = kd;  // Ganancia derivativa
+}
+
+void PID_REINICIAR(PID *pid, int16_t medicion, int16_t salida) {  // Arranca desde una salida conocida
+    pid->salida = PID_SATURAR(salida, pid->minimo, pid->maximo);  // Salida de partida dentro del rango
+    pid->integral = (int32_t)pid->salida << 8;  // La integral toma toda la salida (el error se supone chico)
+    pid->anterior = medicion;  // La derivada arranca en 0
+    FILTRO_IIR_INICIAR(&pid->derivada, pid->derivada.k, 0);  // Se vacía el filtro de la derivada (misma constante)
+}
+
+int16_t PID_ACTUALIZAR(PID *pid, int16_t consigna, int16_t medicion) {  // Procesa una muestra
+    if (pid->anterior == INT16_MIN) PID_REINICIAR(pid, medicion, 0);  // Primera muestra: sin derivada ni integral previa
+    int32_t error = PID_SATURAR((int32_t)consigna - medicion, -32767L, 32767L);  // Error en Q8.8, limitado a 16 bits
+    int16_t cambio = (int16_t)PID_SATURAR((int32_t)medicion - pid->anterior, -32767L, 32767L);  // Cambio de la medición desde la muestra anterior
+    pid->anterior = medicion;  // Se guarda para la próxima muestra
+    cambio = FILTRO_IIR_ACTUALIZAR(&pid->derivada, cambio);  // Se suaviza el ruido de la diferencia
+
+    int32_t p = ((int32_t)pid->kp * error) >> 8;  // Proporcional en Q8.8 de salida (Q8.8 * Q8.8 >> 8)
+    int32_t d = -(((int32_t)pid->kd * cambio) >> 8);  // Derivada sobre la medición: se opone a su cambio
+    int32_t integral = pid->integral + (((int32_t)pid->ki * error) >> 8);  // Integral con la muestra nueva
+    int32_t minimo = (int32_t)pid->minimo << 8, maximo = (int32_t)pid->maximo << 8;  // Límites en Q8.8
+    integral = PID_SATURAR(integral, minimo, maximo);  // La integral sola nunca supera el rango de la salida
+    int32_t u = p + integral + d;  // Salida sin limitar
+    if ((u > maximo && error > 0) || (u < minimo && error < 0)) u = p + pid->integral + d;  // Saturada en el sentido del error: no se integra
+    else pid->integral = integral;  // Se acepta la integral nueva
+
+    u = (u + 128) >> 8;  // Se redondea a cuentas de salida
+    pid->salida = (int16_t)PID_SATURAR(u, (int32_t)pid->minimo, (int32_t)pid->maximo);  // Salida limitada
+    return pid->salida;  // Se devuelve la salida
+}
@@ -0,0 +1,35 @@
+#ifndef PID_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define PID_H  // Marca el inicio del bloque protegido de inclusión
+
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+#include "filtros.h"  // Se incluye la librería de filtros para suavizar la derivada de la medición
+
+// Controlador PID en enteros para un período de muestreo fijo (el del temporizador que dispara la medición). La
+// consigna y la medición van en Q8.8 (por ejemplo °C * 256) y las ganancias también en Q8.8, en cuentas de salida:
+//   kp: cuentas por unidad de error
+//   ki: cuentas por unidad de error y por muestra (Ki * T)
+//   kd: cuentas por unidad de cambio de la medición entre muestras (Kd / T)
+// La salida es un entero entre 'minimo' y 'maximo'; los términos se suman en Q8.8 de salida (int32) y se redondea al final.
+//   Integral: acumula ki * error (no ki * suma de errores), así cambiar ki no produce un salto en la salida. Anti-windup
+//     por integración condicional: si la salida está saturada y el error la empujaría más allá, la integral no crece, y
+//     además queda acotada al rango de la salida.
+//   Derivada sobre la medición (no sobre el error): un cambio de consigna no produce un pico en la salida. Se filtra con
+//     un IIR de primer orden de 2^k muestras, porque la diferencia entre dos muestras amplifica el ruido de cuantización.
+// Cálculo (estimación a mano, sin medir en el hardware): tres productos de 16 x 16 bits a 32 bits y sumas de 32 bits,
+// del orden de 200 ciclos, por lo que se puede llamar desde una interrupción.
+
+typedef struct {  // Estado de un controlador
+    int16_t kp, ki, kd;  // Ganancias en Q8.8
+    int16_t minimo, maximo;  // Límites de la salida
+    int32_t integral;  // Término integral en Q8.8 de salida
+    int16_t anterior;  // Medición anterior (Q8.8)
+    FILTRO_IIR derivada;  // Cambio de la medición entre muestras, filtrado
+    int16_t salida;  // Última salida
+} PID;
+
+void PID_INICIAR(PID *pid, int16_t minimo, int16_t maximo, uint8_t filtro_k);  // Prototipo que prepara el controlador con la salida en 0 y la derivada filtrada en 2^filtro_k muestras (1 a 8)
+void PID_GANANCIAS(PID *pid, int16_t kp, int16_t ki, int16_t kd);  // Prototipo que cambia las ganancias sin salto en la salida (no usar a la vez que PID_ACTUALIZAR)
+void PID_REINICIAR(PID *pid, int16_t medicion, int16_t salida);  // Prototipo que arranca desde una medición y una salida dadas (por ejemplo al pasar de manual a automático)
+int16_t PID_ACTUALIZAR(PID *pid, int16_t consigna, int16_t medicion);  // Prototipo que procesa una muestra y devuelve la salida (llamar una vez por período de muestreo)
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
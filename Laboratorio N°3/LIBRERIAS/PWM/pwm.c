@@ -1,5 +1,17 @@
 #include "pwm.h"  // Se incluye el archivo de cabecera con las definiciones y prototipos del módulo PWM
 
+static uint16_t tope[3] = {255, 255, 255};  // Tope de cada temporizador
+static uint16_t escala_alta[3] = {1, 1, 1};  // Parte entera de (tope + 1) / 256: escala del duty de cada temporizador
+static uint8_t escala_baja[3];  // Parte fraccionaria de (tope + 1) / 256 en 1/256
+
+static uint16_t motor_minimo[2];  // Comparación mínima de cada canal de Timer1 en modo motor
+static uint16_t motor_arranque[2];  // Comparación de arranque de cada canal
+static uint16_t motor_escala[2];  // (tope - minimo) * 64: pendiente del mapeo en 1/65536 por unidad de comando
+static uint8_t motor_despegue[2];  // Llamadas que quedan con el duty de arranque (0xFF = motor detenido)
+
+static const uint16_t prescalers[] = {1, 8, 64, 256, 1024};  // Prescalers de Timer0 y Timer1 (CS = posición + 1)
+static const uint16_t prescalers2[] = {1, 8, 32, 64, 128, 256, 1024};  // Prescalers de Timer2 (CS = posición + 1)
+
 void PWM_INICIAR(unsigned int prescaler) {  // Inicializa el PWM con el prescaler especificado
     DDRD |= (1 << PD6);  // Configura el pin PD6 (OC0A) como salida para la señal PWM
     
@@ -27,3 +39,146 @@ void PWM_DETENER(void) {  // Detiene la generación de la señal PWM
     TCCR0B = 0;  // Detiene el temporizador desactivando el reloj
     DDRD &= ~(1 << PD6);  // Configura nuevamente el pin PD6 como entrada
 }
+
+static void pwm_escala(uint8_t timer, uint16_t t) {  // Guarda el tope y precalcula la escala del duty
+    uint32_t e = (uint32_t)t + 1;  // Cuentas de un período (hasta 65536)
+    tope[timer] = t;  // Se guarda el tope
+    escala_alta[timer] = e >> 8;  // Parte entera de la escala (hasta 256)
+    escala_baja[timer] = e & 0xFF;  // Parte fraccionaria de la escala
+}
+
+uint16_t PWM_TIMER_INICIAR(uint8_t timer, uint8_t modo, uint32_t frecuencia_hz) {  // Configura un temporizador para PWM y devuelve su tope
+    uint8_t cs;  // Bits de selección de reloj (posición del prescaler + 1)
+    uint16_t minimo = (timer == 1) ? ((modo == PWM_FASE_CORRECTA) ? 4 : 3) : ((modo == PWM_FASE_CORRECTA) ? 510 : 256);  // Ciclos del período más corto sin prescaler (en Timer1, tope 2: tres niveles)
+    if (frecuencia_hz == 0 || frecuencia_hz > F_CPU / minimo) return 0;  // Frecuencia nula o mayor que la máxima: no se configura nada
+
+    if (timer == 1) {  // Timer1: se usa el menor prescaler con el que el tope entra en 16 bits (máxima resolución)
+        uint32_t t = 0;  // Tope calculado
+        for (cs = 0; cs < 5; cs++) {  // Se prueban los prescalers de menor a mayor
+            uint32_t cuentas = F_CPU / ((uint32_t)prescalers[cs] * frecuencia_hz);  // Ciclos del temporizador por período
+            t = (modo == PWM_FASE_CORRECTA) ? cuentas / 2 : cuentas - 1;  // Tope según el modo
+            if (t <= 0xFFFF) break;  // El primer prescaler que entra da la mayor resolución
+        }
+        if (cs == 5) { cs = 4; t = 0xFFFF; }  // Frecuencia demasiado baja: se usa la mínima posible
+        cs++;  // Los bits CS son la posición más uno
+
+        TCCR1B = 0;  // Se detiene el temporizador mientras se configura
+        TCCR1A &= (1 << COM1A1) | (1 << COM1A0) | (1 << COM1B1) | (1 << COM1B0);  // Se conservan las salidas ya conectadas
+        TCNT1 = 0;  // Se reinicia la cuenta
+        ICR1 = (uint16_t)t;  // El tope va en ICR1 para dejar libres OCR1A y OCR1B
+        pwm_escala(1, (uint16_t)t);  // Se precalcula la escala del duty
+        if (modo == PWM_FASE_CORRECTA) {  // Modo 10: phase correct con tope en ICR1
+            TCCR1A |= (1 << WGM11);  // Parte baja del modo
+            TCCR1B = (1 << WGM13) | cs;  // Parte alta del modo y arranque con el prescaler elegido
+        } else {  // Modo 14: fast PWM con tope en ICR1
+            TCCR1A |= (1 << WGM11);  // Parte baja del modo
+            TCCR1B = (1 << WGM13) | (1 << WGM12) | cs;  // Parte alta del modo y arranque con el prescaler elegido
+        }
+        return tope[1];  // Se devuelve el tope
+    }
+
+    // Timer0 y Timer2: tope fijo de 255; se elige el menor prescaler cuya frecuencia no supere la pedida
+    const uint16_t *lista = (timer == 2) ? prescalers2 : prescalers;  // Prescalers disponibles según el temporizador
+    uint8_t n = (timer == 2) ? 7 : 5;  // Cantidad de prescalers disponibles
+    uint16_t ciclos = (modo == PWM_FASE_CORRECTA) ? 510 : 256;  // Ciclos del temporizador por período
+    for (cs = 0; cs < n - 1; cs++) {  // Se prueban los prescalers de menor a mayor (el último se usa si ninguno alcanza)
+        if (F_CPU / ((uint32_t)lista[cs] * ciclos) <= frecuencia_hz) break;  // Primera frecuencia que no supera la pedida
+    }
+    cs++;  // Los bits CS son la posición más uno
+    pwm_escala(timer, 255);  // Escala unitaria: el duty se escribe directo
+
+    uint8_t wgm = (modo == PWM_FASE_CORRECTA) ? (1 << WGM00) : ((1 << WGM01) | (1 << WGM00));  // Modo 1 (phase correct) o 3 (fast PWM); WGM20/21 ocupan los mismos bits
+    if (timer == 2) {  // Timer2
+        TCCR2B = 0;  // Se detiene el temporizador mientras se configura
+        TIMSK2 = 0;  // Se desactivan sus interrupciones: las de ANIMACION y PWM_SW escriben OCR2A y romperían el duty
+        TCCR2A = (TCCR2A & ((1 << COM2A1) | (1 << COM2A0) | (1 << COM2B1) | (1 << COM2B0))) | wgm;  // Se fija el modo conservando las salidas
+        TCNT2 = 0;  // Se reinicia la cuenta
+        TCCR2B = cs;  // Se arranca con el prescaler elegido
+    } else {  // Timer0
+        TCCR0B = 0;  // Se detiene el temporizador mientras se configura
+        TCCR0A = (TCCR0A & ((1 << COM0A1) | (1 << COM0A0) | (1 << COM0B1) | (1 << COM0B0))) | wgm;  // Se fija el modo conservando las salidas
+        TCNT0 = 0;  // Se reinicia la cuenta
+        TCCR0B = cs;  // Se arranca con el prescaler elegido
+    }
+    return 255;  // Tope fijo de los temporizadores de 8 bits
+}
+
+void PWM_TIMER1_TOPE(uint16_t t) {  // Cambia la frecuencia de Timer1 con un tope calculado de antemano (por ejemplo con PWM_TOPE_RAPIDO)
+    ICR1 = t;  // Nuevo tope (los valores de comparación no se reescalan)
+    pwm_escala(1, t);  // Se recalcula la escala del duty, sin divisiones
+}
+
+uint16_t PWM_TOPE(uint8_t timer) {  // Devuelve el tope del temporizador
+    return tope[timer];  // Valor de comparación que corresponde al 100 %
+}
+
+void PWM_TIMER_DETENER(uint8_t timer) {  // Detiene un temporizador y desconecta sus salidas
+    PWM_CANAL_DETENER(timer * 2);  // Se libera el canal A
+    PWM_CANAL_DETENER(timer * 2 + 1);  // Se libera el canal B
+    if (timer == 0) { TCCR0B = 0; TCCR0A = 0; }  // Se detiene Timer0
+    else if (timer == 1) { TCCR1B = 0; TCCR1A = 0; }  // Se detiene Timer1
+    else { TCCR2B = 0; TCCR2A = 0; }  // Se detiene Timer2
+}
+
+void PWM_CANAL_INICIAR(uint8_t canal, uint8_t polaridad) {  // Conecta la salida de un canal al pin
+    uint8_t com = polaridad == PWM_INVERTIDO ? 3 : 2;  // COMnx1:0 = 10 (no invertida) o 11 (invertida)
+    PWM_ESCRIBIR(canal, 0);  // Se arranca con duty 0
+    switch (canal) {  // Se conecta la salida y se configura el pin
+        case PWM_OC0A: TCCR0A = (TCCR0A & ~(3 << COM0A0)) | (com << COM0A0); DDRD |= (1 << PD6); break;  // OC0A en PD6
+        case PWM_OC0B: TCCR0A = (TCCR0A & ~(3 << COM0B0)) | (com << COM0B0); DDRD |= (1 << PD5); break;  // OC0B en PD5
+        case PWM_OC1A: TCCR1A = (TCCR1A & ~(3 << COM1A0)) | (com << COM1A0); DDRB |= (1 << PB1); break;  // OC1A en PB1
+        case PWM_OC1B: TCCR1A = (TCCR1A & ~(3 << COM1B0)) | (com << COM1B0); DDRB |= (1 << PB2); break;  // OC1B en PB2
+        case PWM_OC2A: TCCR2A = (TCCR2A & ~(3 << COM2A0)) | (com << COM2A0); DDRB |= (1 << PB3); break;  // OC2A en PB3
+        default:       TCCR2A = (TCCR2A & ~(3 << COM2B0)) | (com << COM2B0); DDRD |= (1 << PD3); break;  // OC2B en PD3
+    }
+}
+
+void PWM_CANAL_DETENER(uint8_t canal) {  // Desconecta la salida de un canal
+    switch (canal) {  // Se desconecta la salida y el pin vuelve a ser entrada
+        case PWM_OC0A: TCCR0A &= ~(3 << COM0A0); DDRD &= ~(1 << PD6); break;  // Se libera PD6
+        case PWM_OC0B: TCCR0A &= ~(3 << COM0B0); DDRD &= ~(1 << PD5); break;  // Se libera PD5
+        case PWM_OC1A: TCCR1A &= ~(3 << COM1A0); DDRB &= ~(1 << PB1); break;  // Se libera PB1
+        case PWM_OC1B: TCCR1A &= ~(3 << COM1B0); DDRB &= ~(1 << PB2); break;  // Se libera PB2
+        case PWM_OC2A: TCCR2A &= ~(3 << COM2A0); DDRB &= ~(1 << PB3); break;  // Se libera PB3
+        default:       TCCR2A &= ~(3 << COM2B0); DDRD &= ~(1 << PD3); break;  // Se libera PD3
+    }
+}
+
+void PWM_DUTY(uint8_t canal, uint8_t duty) {  // Fija el duty en 1/256 del período usando la escala precalculada
+    uint8_t timer = PWM_TIMER(canal);  // Temporizador del canal
+    uint16_t valor;  // Valor de comparación
+    if (duty == 255) valor = tope[timer];  // 255 corresponde al 100 %
+    else valor = duty * escala_alta[timer] + (((uint16_t)duty * escala_baja[timer]) >> 8);  // duty * (tope + 1) / 256 con productos de 16 bits
+    PWM_ESCRIBIR(canal, valor);  // Una sola escritura del registro de comparación
+}
+
+void PWM_MOTOR_INICIAR(uint8_t canal, uint16_t minimo, uint16_t arranque) {  // Configura Timer1 para manejar un motor por un canal
+    uint8_t i = canal - PWM_OC1A;  // Índice del canal dentro de Timer1
+    uint16_t t = PWM_TIMER_INICIAR(1, PWM_FASE_CORRECTA, PWM_MOTOR_FRECUENCIA);  // Phase correct a 20 kHz (tope 400)
+    if (minimo > t) minimo = t;  // Se limitan los parámetros al tope
+    if (arranque > t) arranque = t;  // Ídem para el arranque
+    motor_minimo[i] = minimo;  // Se guarda el inicio del tramo útil
+    motor_arranque[i] = arranque;  // Se guarda el duty de arranque
+    motor_escala[i] = (t - minimo) * 64;  // (tope - minimo) * 65536 / 1024, precalculado (entra en 16 bits porque el tope es 400)
+    motor_despegue[i] = 0xFF;  // El motor empieza detenido
+    PWM_CANAL_INICIAR(canal, PWM_NORMAL);  // Se conecta la salida con duty 0
+}
+
+void PWM_MOTOR(uint8_t canal, uint16_t comando) {  // Aplica un comando de 10 bits con compensación de fricción
+    uint8_t i = canal - PWM_OC1A;  // Índice del canal dentro de Timer1
+    uint16_t valor;  // Valor de comparación
+
+    if (comando == 0) {  // Sin comando el motor se apaga
+        motor_despegue[i] = 0xFF;  // El próximo arranque vuelve a necesitar el despegue
+        PWM_ESCRIBIR(canal, 0);  // Duty 0 (en phase correct la salida queda en bajo todo el período)
+        return;  // No hay más que hacer
+    }
+    if (comando >= PWM_MOTOR_MAXIMO) valor = tope[1];  // El comando máximo corresponde al 100 %
+    else valor = motor_minimo[i] + (uint16_t)(((uint32_t)comando * motor_escala[i]) >> 16);  // minimo + comando * (tope - minimo) / 1024: un producto 16x16 (instrucción MUL), sin divisiones
+    if (motor_despegue[i] == 0xFF) motor_despegue[i] = PWM_MOTOR_DESPEGUE;  // El motor estaba detenido: comienza el despegue
+    if (motor_despegue[i]) {  // Mientras dura el despegue
+        motor_despegue[i]--;  // Se cuenta la llamada
+        if (valor < motor_arranque[i]) valor = motor_arranque[i];  // Se aplica al menos el duty de arranque
+    }
+    PWM_ESCRIBIR(canal, valor);  // Una sola escritura del registro de comparación
+}
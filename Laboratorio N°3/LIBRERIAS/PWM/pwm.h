@@ -1,6 +1,10 @@
 #ifndef PWM_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
 #define PWM_H  // Marca el inicio del bloque protegido de inclusión
 
+#ifndef F_CPU  // Verifica si no está definida la frecuencia del microcontrolador
+#define F_CPU 16000000UL  // Define la frecuencia del reloj principal en 16 MHz
+#endif  // Fin de la comprobación de F_CPU
+
 #include <avr/io.h>  // Se incluye la librería que permite acceder a los registros de control del microcontrolador AVR
 #include <stdint.h>  // Se incluye la librería estándar que define tipos de datos con tamaño fijo (uint8_t, uint16_t, etc.)
 
@@ -8,4 +12,67 @@ void PWM_INICIAR(unsigned int prescaler);  // Prototipo de función para inicial
 void PWM_ESTABLECER_DUTY(uint8_t duty);  // Prototipo de función para establecer el ciclo de trabajo (duty cycle) del PWM
 void PWM_DETENER(void);  // Prototipo de función para detener la generación de la señal PWM
 
+// Las tres funciones anteriores manejan solo OC0A (PD6) en Fast PWM de 8 bits. Las siguientes permiten usar las seis
+// salidas PWM del ATmega328P. Cada temporizador se configura una vez con un modo y una frecuencia; ahí se eligen el
+// prescaler y el tope (TOP) y se precalcula la escala del duty, por lo que los cambios en tiempo de ejecución son solo
+// la escritura del registro de comparación, sin divisiones ni aritmética de 32 bits.
+//   Timer0: OC0A (PD6) y OC0B (PD5), 8 bits. También lo usa ADC_DISPARO_TIMER0.
+//   Timer1: OC1A (PB1) y OC1B (PB2), tope de 16 bits en ICR1. También lo usa ADC_DISPARO_TIMER1.
+//   Timer2: OC2A (PB3) y OC2B (PD3), 8 bits. También lo usan las librerías ANIMACION y PWM_SW, que reprograman OCR2A
+//   como tope en su interrupción: son excluyentes con el PWM por hardware de Timer2, y PWM_TIMER_INICIAR(2, ...) las
+//   detiene (deja TIMSK2 en 0).
+// En los temporizadores de 8 bits el tope es siempre 255 y la frecuencia solo se ajusta con el prescaler.
+
+#define PWM_OC0A  0  // Canal OC0A (PD6)
+#define PWM_OC0B  1  // Canal OC0B (PD5)
+#define PWM_OC1A  2  // Canal OC1A (PB1)
+#define PWM_OC1B  3  // Canal OC1B (PB2)
+#define PWM_OC2A  4  // Canal OC2A (PB3)
+#define PWM_OC2B  5  // Canal OC2B (PD3)
+#define PWM_TIMER(canal)  ((canal) >> 1)  // Temporizador (0, 1 o 2) al que pertenece un canal
+
+#define PWM_RAPIDO         0  // Fast PWM: cuenta de 0 a TOP, frecuencia F_CPU / (N * (TOP + 1))
+#define PWM_FASE_CORRECTA  1  // Phase correct: cuenta de 0 a TOP y vuelve, frecuencia F_CPU / (2 * N * TOP), pulsos centrados
+
+#define PWM_NORMAL     0  // Salida en alto mientras el contador es menor que el valor de comparación
+#define PWM_INVERTIDO  1  // Salida en bajo mientras el contador es menor que el valor de comparación
+
+// Tope de Timer1 para una frecuencia y un prescaler, calculado por el compilador cuando los argumentos son constantes
+// (sirve para armar tablas de frecuencias y cambiarlas en ejecución con PWM_TIMER1_TOPE).
+#define PWM_TOPE_RAPIDO(frecuencia_hz, prescaler)  ((uint16_t)(F_CPU / ((uint32_t)(prescaler) * (frecuencia_hz)) - 1))
+#define PWM_TOPE_FASE(frecuencia_hz, prescaler)    ((uint16_t)(F_CPU / (2UL * (prescaler) * (frecuencia_hz))))
+
+uint16_t PWM_TIMER_INICIAR(uint8_t timer, uint8_t modo, uint32_t frecuencia_hz);  // Prototipo que configura un temporizador en el modo y la frecuencia más cercana posible y devuelve el tope (0 sin configurar nada si la frecuencia es 0 o supera la máxima del temporizador)
+void PWM_TIMER1_TOPE(uint16_t tope);  // Prototipo que cambia la frecuencia de Timer1 escribiendo un tope precalculado (ajusta la escala del duty)
+uint16_t PWM_TOPE(uint8_t timer);  // Prototipo que devuelve el tope del temporizador (valor de comparación para 100 %)
+void PWM_TIMER_DETENER(uint8_t timer);  // Prototipo para detener un temporizador y desconectar sus dos salidas
+void PWM_CANAL_INICIAR(uint8_t canal, uint8_t polaridad);  // Prototipo que conecta la salida de un canal al pin y lo configura como salida
+void PWM_CANAL_DETENER(uint8_t canal);  // Prototipo que desconecta la salida de un canal y deja el pin como entrada
+void PWM_DUTY(uint8_t canal, uint8_t duty);  // Prototipo que fija el duty en 1/256 (255 = 100 %) con la escala precalculada, sin importar el tope
+
+// Modo motor: Timer1 en phase correct sin prescaler a 20 kHz (fuera del rango audible) con tope 400, es decir 401
+// niveles (8,6 bits). A 16 MHz no se pueden tener 10 bits por encima de 20 kHz: 10 bits en phase correct dan 7,8 kHz
+// y en fast PWM 15,6 kHz. El comando es de 10 bits (0 a PWM_MOTOR_MAXIMO) y se mapea sobre el tramo útil del motor:
+// 0 apaga, y cualquier otro valor empieza en 'minimo' (duty que vence la fricción dinámica y mantiene el giro), de modo
+// que el control no necesita sumar una zona muerta. Al arrancar desde 0 se aplica al menos 'arranque' durante
+// PWM_MOTOR_DESPEGUE llamadas para vencer la fricción estática, que es mayor que la dinámica.
+#define PWM_MOTOR_FRECUENCIA  20000UL  // Frecuencia del PWM del motor en Hz
+#define PWM_MOTOR_TOPE        PWM_TOPE_FASE(PWM_MOTOR_FRECUENCIA, 1)  // Tope resultante (400)
+#define PWM_MOTOR_MAXIMO      1023  // Comando máximo (100 %)
+#define PWM_MOTOR_DESPEGUE    3  // Llamadas a PWM_MOTOR en las que se sostiene el duty de arranque
+
+void PWM_MOTOR_INICIAR(uint8_t canal, uint16_t minimo, uint16_t arranque);  // Prototipo que configura Timer1 en modo motor y conecta PWM_OC1A o PWM_OC1B ('minimo' y 'arranque' en cuentas de 0 a PWM_MOTOR_TOPE)
+void PWM_MOTOR(uint8_t canal, uint16_t comando);  // Prototipo que aplica un comando de 0 a PWM_MOTOR_MAXIMO con la compensación de fricción
+
+static inline void PWM_ESCRIBIR(uint8_t canal, uint16_t valor) {  // Escribe el valor de comparación de un canal (0 a PWM_TOPE); con 'canal' constante es una sola escritura
+    switch (canal) {  // Se elige el registro de comparación del canal
+        case PWM_OC0A: OCR0A = (uint8_t)valor; break;  // Timer0, canal A
+        case PWM_OC0B: OCR0B = (uint8_t)valor; break;  // Timer0, canal B
+        case PWM_OC1A: OCR1A = valor; break;  // Timer1, canal A (16 bits: no escribir desde una interrupción y desde el programa a la vez)
+        case PWM_OC1B: OCR1B = valor; break;  // Timer1, canal B
+        case PWM_OC2A: OCR2A = (uint8_t)valor; break;  // Timer2, canal A
+        default:       OCR2B = (uint8_t)valor; break;  // Timer2, canal B
+    }
+}
+
 #endif  // Fin de la protección contra inclusiones múltiples del archivo
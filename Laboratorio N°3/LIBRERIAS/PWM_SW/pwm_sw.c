@@ -0,0 +1,80 @@
+#include "pwm_sw.h"  // Se incluye el archivo de cabecera con las definiciones y prototipos del PWM por software
+
+static uint8_t canal_puerto[PWM_SW_CANALES];  // Puerto de cada canal
+static uint8_t canal_mascara[PWM_SW_CANALES];  // Máscara del pin de cada canal dentro de su puerto
+static uint8_t duty[PWM_SW_CANALES];  // Duty guardado de cada canal
+static uint8_t n_canales = 0;  // Cantidad de canales agregados
+
+static uint8_t libres[3] = {0xFF, 0xFF, 0xFF};  // Bits de cada puerto que no maneja el PWM (se conservan en cada escritura)
+static uint8_t estados[2][8][3];  // Doble tabla de estados: para cada tramo, los bits encendidos de los puertos B, C y D
+static uint8_t (*volatile tabla)[3] = estados[0];  // Tabla que recorre la interrupción
+static volatile uint8_t pendiente = 0;  // Indica que la otra tabla tiene duty nuevos para el próximo período
+static volatile uint8_t tramo = 0;  // Tramo que comienza en la próxima interrupción (0 a 7)
+
+ISR(TIMER2_COMPA_vect) {  // Comienzo de un tramo: se escriben los puertos y se programa la duración
+    uint8_t k = tramo;  // Tramo que comienza
+    if (k == 0 && pendiente) {  // Al inicio del período se toma la tabla nueva si la hay
+        tabla = (tabla == estados[0]) ? estados[1] : estados[0];  // Se intercambian las tablas
+        pendiente = 0;  // La tabla nueva ya está en uso
+    }
+    const uint8_t *e = tabla[k];  // Estados del tramo
+    PORTB = (PORTB & libres[0]) | e[0];  // Pines del puerto B
+    PORTC = (PORTC & libres[1]) | e[1];  // Pines del puerto C
+    PORTD = (PORTD & libres[2]) | e[2];  // Pines del puerto D
+    OCR2A = (uint8_t)((1 << k) - 1);  // El tramo k dura 2^k ticks (la cuenta ya volvió a 0 en la comparación)
+    tramo = (k + 1) & 7;  // Se pasa al tramo siguiente
+}
+
+void PWM_SW_INICIAR(void) {  // Configura el Timer2 para generar los tramos
+    TCCR2B = 0;  // Se detiene el temporizador mientras se configura
+    TCCR2A = (1 << WGM21);  // Modo CTC (TOP = OCR2A), sin salidas en los pines
+    TCNT2 = 0;  // Se reinicia la cuenta
+    OCR2A = 0;  // La primera interrupción llega en un tick
+    tramo = 0;  // Se empieza por el primer tramo
+    TIFR2 = (1 << OCF2A);  // Se limpia una bandera pendiente
+    TIMSK2 = (1 << OCIE2A);  // Se habilita la interrupción por coincidencia con OCR2A
+    TCCR2B = (1 << CS22) | (1 << CS21);  // Se arranca con prescaler 256 (tick de 16 µs)
+    sei();  // Se habilitan las interrupciones globales
+}
+
+uint8_t PWM_SW_AGREGAR(uint8_t puerto, uint8_t bit) {  // Agrega un pin como canal de PWM por software
+    if (n_canales >= PWM_SW_CANALES || puerto > PWM_SW_PUERTO_D) return 0xFF;  // No hay lugar o el puerto no existe
+    uint8_t mascara = (uint8_t)(1 << bit);  // Máscara del pin
+    if (puerto == PWM_SW_PUERTO_B) { PORTB &= ~mascara; DDRB |= mascara; }  // Pin del puerto B como salida en bajo
+    else if (puerto == PWM_SW_PUERTO_C) { PORTC &= ~mascara; DDRC |= mascara; }  // Pin del puerto C como salida en bajo
+    else { PORTD &= ~mascara; DDRD |= mascara; }  // Pin del puerto D como salida en bajo
+    canal_puerto[n_canales] = puerto;  // Se guarda el puerto del canal
+    canal_mascara[n_canales] = mascara;  // Se guarda la máscara del canal
+    duty[n_canales] = 0;  // El canal empieza apagado
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // La máscara de bits libres la lee la interrupción
+    libres[puerto] &= ~mascara;  // El pin pasa a ser manejado por el PWM
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+    return n_canales++;  // Se devuelve el número de canal
+}
+
+void PWM_SW_ESTABLECER(uint8_t canal, uint8_t valor) {  // Guarda el duty de un canal
+    if (canal < n_canales) duty[canal] = valor;  // Se ignora un canal inexistente
+}
+
+void PWM_SW_APLICAR(void) {  // Arma la tabla de estados con los duty guardados y la publica
+    while (pendiente);  // Se espera a que la interrupción haya tomado la tabla anterior (la otra tabla queda libre)
+    uint8_t (*nueva)[3] = (tabla == estados[0]) ? estados[1] : estados[0];  // Tabla que no está en uso
+    for (uint8_t k = 0; k < 8; k++) {  // Se recorren los tramos
+        uint8_t bit = (uint8_t)(1 << k);  // Bit del duty que corresponde al tramo
+        nueva[k][0] = nueva[k][1] = nueva[k][2] = 0;  // Se parte de todos los canales apagados
+        for (uint8_t c = 0; c < n_canales; c++) {  // Se recorren los canales
+            if (duty[c] & bit) nueva[k][canal_puerto[c]] |= canal_mascara[c];  // El canal está encendido en este tramo
+        }
+    }
+    pendiente = 1;  // La interrupción tomará la tabla nueva al comenzar el próximo período
+    while (pendiente);  // Se espera a que los duty estén en las salidas (requiere las interrupciones habilitadas)
+}
+
+void PWM_SW_DETENER(void) {  // Detiene el PWM por software
+    TCCR2B = 0;  // Se detiene el temporizador
+    TIMSK2 = 0;  // Se deshabilita la interrupción
+    PORTB &= libres[0];  // Se apagan los pines del puerto B
+    PORTC &= libres[1];  // Se apagan los pines del puerto C
+    PORTD &= libres[2];  // Se apagan los pines del puerto D
+}
@@ -0,0 +1,37 @@
+#ifndef PWM_SW_H  // Se define una directiva de inclusión condicional para evitar múltiples inclusiones del archivo
+#define PWM_SW_H  // Marca el inicio del bloque protegido de inclusión
+
+#ifndef F_CPU  // Verifica si no está definida la frecuencia del microcontrolador
+#define F_CPU 16000000UL  // Define la frecuencia del reloj principal en 16 MHz
+#endif  // Fin de la comprobación de F_CPU
+
+#include <avr/io.h>  // Se incluye la librería para acceder a los puertos y al Timer2
+#include <avr/interrupt.h>  // Se incluye para declarar la interrupción de comparación del Timer2
+#include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido
+
+// PWM por software de 8 bits por modulación de código binario (BCM) sobre cualquier pin de los puertos B, C y D.
+// El período se divide en 8 tramos de 1, 2, 4, ..., 128 ticks; en el tramo k cada pin está encendido si el bit k de
+// su duty vale 1. La interrupción del Timer2 ocurre solo al inicio de cada tramo (8 por período, sin importar la
+// cantidad de canales) y escribe los tres puertos con estados precalculados, sin recorrer los canales.
+//   Tick: prescaler 256 = 16 µs (256 ciclos). Período: 1 + 2 + ... + 128 = 255 ticks = 4,08 ms (245 Hz, sin parpadeo visible).
+//   Interrupción (estimación a mano sobre el código, sin medir en el hardware): ~100 ciclos incluyendo entrada,
+//   guardado de registros y reti; cabe holgada en el tramo más corto (256 ciclos).
+//   Carga de CPU: 8 * ~100 / 65280 ciclos por período ≈ 1,2 %, la misma con 1 o con 16 canales. Comparar una cuenta
+//   por tick contra cada canal necesitaría 255 interrupciones por período, más de la mitad de la CPU con 16 canales.
+// Usa el Timer2 completo (no se puede combinar con ANIMACION ni con las salidas PWM_OC2A/PWM_OC2B). Una sección
+// con interrupciones deshabilitadas de más de 16 µs (por ejemplo WS2812_MOSTRAR) puede alargar un tramo y producir
+// un destello de un período. El duty va de 0 (apagado) a 255 (encendido todo el período).
+
+#define PWM_SW_CANALES  16  // Cantidad máxima de canales
+
+#define PWM_SW_PUERTO_B  0  // Identificador del puerto B
+#define PWM_SW_PUERTO_C  1  // Identificador del puerto C
+#define PWM_SW_PUERTO_D  2  // Identificador del puerto D
+
+void PWM_SW_INICIAR(void);  // Prototipo para configurar el Timer2 y comenzar a generar los tramos (habilita las interrupciones)
+uint8_t PWM_SW_AGREGAR(uint8_t puerto, uint8_t bit);  // Prototipo que configura un pin como salida y devuelve su número de canal (0xFF si no hay lugar)
+void PWM_SW_ESTABLECER(uint8_t canal, uint8_t duty);  // Prototipo que guarda el duty de un canal (se aplica con PWM_SW_APLICAR)
+void PWM_SW_APLICAR(void);  // Prototipo que publica los duty guardados y espera a que comience el período que los usa (hasta 4,1 ms)
+void PWM_SW_DETENER(void);  // Prototipo para detener el Timer2 y apagar todos los canales
+
+#endif  // Fin de la protección contra inclusiones múltiples del archivo
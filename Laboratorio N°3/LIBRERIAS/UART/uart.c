@@ -4,9 +4,37 @@
 
 #include <avr/io.h>  // Se incluye la librería para acceder a los registros de hardware del microcontrolador AVR
 #include <util/delay.h>  // Se incluye para permitir retardos de tiempo mediante _delay_ms() o _delay_us()
+#include <avr/interrupt.h>  // Se incluye para definir la interrupción de recepción completa
 #include <stdio.h>  // Se incluye para el uso de funciones de formato como sprintf()
 #include "uart.h"  // Se incluye el archivo de cabecera del módulo UART
 
+#define UART_RX_MASCARA  (UART_RX_TAM - 1)  // Máscara para que los índices den la vuelta al final del buffer
+
+static volatile uint8_t rx_buffer[UART_RX_TAM];  // Buffer circular donde la interrupción deja los bytes recibidos
+static volatile uint8_t rx_cabeza = 0;  // Posición donde la interrupción escribe el próximo byte
+static volatile uint8_t rx_cola = 0;  // Posición desde donde el programa lee el próximo byte
+static volatile uint8_t rx_desborde = 0;  // Bandera de bytes perdidos
+static uint8_t rx_por_interrupcion = 0;  // Indica si la recepción se atiende por interrupción
+
+ISR(USART_RX_vect) {  // Interrupción de recepción completa: guarda el byte en el buffer circular
+    if (UCSR0A & (1 << DOR0)) rx_desborde = 1;  // El hardware perdió un byte porque la interrupción se atendió tarde
+    uint8_t dato = UDR0;  // Se lee el byte recibido (esto también libera el registro)
+    uint8_t siguiente = (rx_cabeza + 1) & UART_RX_MASCARA;  // Posición siguiente de escritura
+    if (siguiente == rx_cola) {  // Si el buffer está lleno
+        rx_desborde = 1;  // Se descarta el byte y se avisa
+    } else {  // Si hay lugar
+        rx_buffer[rx_cabeza] = dato;  // Se guarda el byte
+        rx_cabeza = siguiente;  // Se avanza la cabeza
+    }
+}
+
+static char uart_sacar(void) {  // Espera un byte en el buffer circular y lo retira
+    while (rx_cabeza == rx_cola);  // Espera hasta que la interrupción deje un byte
+    uint8_t dato = rx_buffer[rx_cola];  // Se toma el byte más antiguo
+    rx_cola = (rx_cola + 1) & UART_RX_MASCARA;  // Se avanza la cola
+    return dato;  // Se devuelve el byte
+}
+
 void UART_INICIAR(unsigned int ubrr) {  // Inicializa el módulo UART con el valor UBRR especificado
     UBRR0H = (unsigned char)(ubrr >> 8);  // Carga la parte alta del valor del divisor de baud rate
     UBRR0L = (unsigned char)ubrr;  // Carga la parte baja del valor del divisor de baud rate
@@ -15,6 +43,7 @@ void UART_INICIAR(unsigned int ubrr) {  // Inicializa el módulo UART con el val
 }
 
 char UART_RECIBIR(void) {  // Espera la recepción de un carácter y lo devuelve
+    if (rx_por_interrupcion) return uart_sacar();  // Si la recepción es por interrupción se lee del buffer circular
     while (!(UCSR0A & (1 << RXC0)));  // Espera hasta que haya un dato recibido disponible
     return UDR0;  // Retorna el byte recibido
 }
@@ -58,10 +87,29 @@ void UART_LEER_CADENA(char *buffer, uint8_t max_len) {  // Lee una cadena de tex
 }
 
 uint8_t UART_DISPONIBLE(void) {  // Devuelve si hay datos disponibles para leer
+    if (rx_por_interrupcion) return (rx_cabeza - rx_cola) & UART_RX_MASCARA;  // Con interrupción se devuelve la cantidad de bytes en el buffer
     return (UCSR0A & (1 << RXC0));  // Retorna 1 si hay un dato disponible, 0 si no
 }
 
 char UART_LEER(void) {  // Bloquea la ejecución hasta recibir un carácter y lo retorna
+    if (rx_por_interrupcion) return uart_sacar();  // Si la recepción es por interrupción se lee del buffer circular
     while (!(UCSR0A & (1 << RXC0)));  // Espera hasta que el dato esté disponible
     return UDR0;  // Retorna el byte recibido
 }
+
+void UART_HABILITAR_RX_INT(void) {  // Pasa la recepción a interrupción para no perder bytes mientras el programa está ocupado
+    rx_cabeza = rx_cola = 0;  // Se vacía el buffer circular
+    rx_desborde = 0;  // Se limpia la bandera de bytes perdidos
+    rx_por_interrupcion = 1;  // Las funciones de lectura pasan a usar el buffer
+    UCSR0B |= (1 << RXCIE0);  // Se habilita la interrupción de recepción completa
+    sei();  // Se habilitan las interrupciones globales
+}
+
+uint8_t UART_RX_DESBORDE(void) {  // Devuelve si se perdieron bytes desde la última consulta
+    uint8_t sreg = SREG;  // Se guarda el estado de las interrupciones
+    cli();  // La interrupción de recepción no debe marcar un desborde entre la lectura y la limpieza
+    uint8_t d = rx_desborde;  // Se copia la bandera
+    rx_desborde = 0;  // Se limpia para la próxima consulta
+    SREG = sreg;  // Se restaura el estado de las interrupciones
+    return d;  // Se devuelve el estado
+}
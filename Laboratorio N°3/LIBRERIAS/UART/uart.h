@@ -9,6 +9,14 @@
 #include <util/delay.h>  // Se incluye para permitir retardos de tiempo mediante las funciones _delay_ms() o _delay_us()
 #include <stdio.h>  // Se incluye para habilitar funciones de formato y manejo de cadenas como sprintf()
 
+#ifndef UART_RX_TAM  // Permite cambiar el tamaño del buffer de recepción desde las opciones del compilador
+#define UART_RX_TAM  128  // Tamaño del buffer circular de recepción por interrupción (potencia de 2, máximo 256)
+#endif  // Fin de la comprobación de UART_RX_TAM
+
+#if (UART_RX_TAM & (UART_RX_TAM - 1)) || (UART_RX_TAM > 256)  // Verifica que el tamaño permita usar índices de 8 bits con máscara
+#error "UART_RX_TAM debe ser potencia de 2 y no mayor a 256"
+#endif  // Fin de la verificación del tamaño del buffer
+
 void UART_INICIAR(unsigned int ubrr);  // Prototipo de función para inicializar la UART con un divisor de baud rate específico
 char UART_RECIBIR(void);  // Prototipo de función para recibir un carácter desde el puerto UART
 void UART_ENVIAR(char c);  // Prototipo de función para enviar un carácter a través del puerto UART
@@ -18,5 +26,7 @@ void UART_IMPRIMIR_HEX_ARRAY(const uint8_t *arr, uint8_t len);  // Prototipo de
 void UART_LEER_CADENA(char *buffer, uint8_t max_len);  // Prototipo de función para leer una cadena de texto ingresada desde UART
 uint8_t UART_DISPONIBLE(void);  // Prototipo de función que indica si hay datos disponibles para lectura
 char UART_LEER(void);  // Prototipo de función que espera y devuelve un carácter recibido por UART
+void UART_HABILITAR_RX_INT(void);  // Prototipo para pasar la recepción a interrupción con buffer circular (las funciones de lectura leen del buffer)
+uint8_t UART_RX_DESBORDE(void);  // Prototipo que indica si se perdieron bytes por buffer lleno o por desborde del hardware (y limpia la bandera)
 
 #endif  // Fin de la protección contra inclusiones múltiples del archivo
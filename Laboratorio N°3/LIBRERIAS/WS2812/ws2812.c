@@ -1,4 +1,5 @@
 #include "ws2812.h"  // Se incluye el archivo de cabecera con las definiciones y prototipos del control de los LEDs WS2812
+#include <string.h>  // Se incluye para borrar el buffer completo con memset()
 
 static inline void WS2812_enviarBit(uint8_t bitVal) {  // Envía un único bit al LED respetando los tiempos de la señal WS2812
     if (bitVal) {  // Si el bit a enviar es 1
@@ -23,12 +24,54 @@ static inline void WS2812_enviarByte(uint8_t byte) {  // Envía un byte completo
         WS2812_enviarBit(byte & (1 << (7 - i)));  // Envía los bits de más significativo a menos significativo
 }
 
+#define WS2812_PANEL_LEDS  ((uint16_t)WS2812_PANEL_ANCHO * WS2812_PANEL_ALTO)  // Cantidad de LEDs de cada panel
+#define WS2812_MAPEO_DIRECTO  (WS2812_MAPEO == WS2812_MAPEO_PROGRESIVO && WS2812_ROTACION == 0 && WS2812_PANEL_ANCHO == WS2812_ANCHO)  // El orden físico coincide con el lógico
+
+static inline uint16_t WS2812_mapear(uint16_t p) {  // Convierte una posición física de la cadena en el índice lógico del buffer
+#if WS2812_MAPEO == WS2812_MAPEO_TABLA  // Si el mapeo lo define una tabla
+#if NUM_LEDS <= 256  // Tabla de índices de 8 bits
+    return pgm_read_byte(&WS2812_TABLA_MAPEO[p]);  // Se lee el índice lógico desde la flash
+#else  // Tabla de índices de 16 bits
+    return pgm_read_word(&WS2812_TABLA_MAPEO[p]);  // Se lee el índice lógico desde la flash
+#endif  // Fin de la selección del ancho de la tabla
+#else  // Si el mapeo se calcula con una fórmula (con tamaños potencia de 2 las divisiones se reducen a desplazamientos)
+    uint16_t panel = p / WS2812_PANEL_LEDS;  // Panel de la cadena al que pertenece el LED
+    uint16_t q = p % WS2812_PANEL_LEDS;  // Posición del LED dentro de su panel
+    uint8_t fila = q / WS2812_PANEL_ANCHO;  // Fila del LED según el cableado del panel
+    uint8_t col = q % WS2812_PANEL_ANCHO;  // Columna del LED según el cableado del panel
+#if WS2812_MAPEO == WS2812_MAPEO_SERPENTINA  // En el cableado serpentina
+    if (fila & 1) col = WS2812_PANEL_ANCHO - 1 - col;  // Las filas impares se recorren de derecha a izquierda
+#endif  // Fin del ajuste de serpentina
+#if WS2812_ROTACION == 1  // Panel girado 90° en sentido horario
+    uint8_t x = WS2812_PANEL_ANCHO - 1 - fila, y = col;  // Coordenadas lógicas dentro del panel
+#elif WS2812_ROTACION == 2  // Panel girado 180°
+    uint8_t x = WS2812_PANEL_ANCHO - 1 - col, y = WS2812_PANEL_ALTO - 1 - fila;  // Coordenadas lógicas dentro del panel
+#elif WS2812_ROTACION == 3  // Panel girado 270° en sentido horario
+    uint8_t x = fila, y = WS2812_PANEL_ALTO - 1 - col;  // Coordenadas lógicas dentro del panel
+#else  // Panel sin rotación
+    uint8_t x = col, y = fila;  // Coordenadas lógicas dentro del panel
+#endif  // Fin de la selección de la rotación
+    x += (panel % WS2812_PANELES_X) * WS2812_PANEL_ANCHO;  // Se desplaza a la columna del panel dentro de la matriz
+    y += (panel / WS2812_PANELES_X) * WS2812_PANEL_ALTO;  // Se desplaza a la fila del panel dentro de la matriz
+    return (uint16_t)y * WS2812_ANCHO + x;  // Se devuelve el índice lógico
+#endif  // Fin de la selección del tipo de mapeo
+}
+
+uint16_t WS2812_FISICO_A_LOGICO(uint16_t fisico) {  // Devuelve el índice lógico del LED conectado en una posición física
+    return WS2812_mapear(fisico);  // Se aplica el mapeo configurado
+}
+
 void WS2812_MOSTRAR(uint8_t (*colores)[3]) {  // Envía la información de color de todos los LEDs a la tira
     cli();  // Deshabilita interrupciones para asegurar precisión en los tiempos
-    for (int i = 0; i < NUM_LEDS; i++) {  // Recorre todos los LEDs definidos
-        WS2812_enviarByte(colores[i][0]);  // Envía componente verde (orden GRB)
-        WS2812_enviarByte(colores[i][1]);  // Envía componente roja
-        WS2812_enviarByte(colores[i][2]);  // Envía componente azul
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {  // Recorre todos los LEDs en el orden físico de la cadena
+#if WS2812_MAPEO_DIRECTO  // Si el cableado coincide con el orden lógico
+        const uint8_t *c = colores[i];  // Se toma el LED directamente
+#else  // Si hay que reordenar los LEDs
+        const uint8_t *c = colores[WS2812_mapear(i)];  // Se busca el LED lógico conectado en esta posición (el cálculo ocurre entre LEDs, muy por debajo del tiempo de reset)
+#endif  // Fin de la selección del mapeo
+        WS2812_enviarByte(c[0]);  // Envía componente verde (orden GRB)
+        WS2812_enviarByte(c[1]);  // Envía componente roja
+        WS2812_enviarByte(c[2]);  // Envía componente azul
     }
     sei();  // Habilita nuevamente las interrupciones
     _delay_us(80);  // Retardo de 80 µs para indicar fin de transmisión
@@ -48,12 +91,11 @@ void WS2812_INICIAR(void) {  // Inicializa el pin de datos para controlar los LE
 }
 
 void WS2812_LIMPIAR(uint8_t (*leds)[3]) {  // Apaga todos los LEDs estableciendo sus valores en 0
-    for (uint8_t i = 0; i < NUM_LEDS; i++)  // Recorre todos los LEDs de la matriz
-        leds[i][0] = leds[i][1] = leds[i][2] = 0;  // Asigna 0 a los tres componentes (G, R, B)
+    memset(leds, 0, NUM_LEDS * 3);  // Asigna 0 a los tres componentes (G, R, B) de todos los LEDs con una sola operación de bloque
 }
 
-uint8_t WS2812_INDICE(uint8_t x, uint8_t y) {  // Calcula el índice lineal de un LED a partir de sus coordenadas (x, y)
-    return y * 8 + x;  // Devuelve el índice correspondiente en una matriz de 8 columnas
+uint16_t WS2812_INDICE(uint8_t x, uint8_t y) {  // Calcula el índice lógico de un LED a partir de sus coordenadas (x, y)
+    return (uint16_t)y * WS2812_ANCHO + x;  // Devuelve el índice correspondiente en una matriz de WS2812_ANCHO columnas
 }
 
 void WS2812_COLOR_ALEATORIO(uint8_t *r, uint8_t *g, uint8_t *b) {  // Genera un color aleatorio asignando valores RGB entre 0 y 255
@@ -11,14 +11,61 @@
 #include <stdlib.h>  // Se incluye para utilizar funciones como rand() para generar colores aleatorios
 #include <stdint.h>  // Se incluye para manejar tipos de datos enteros con tamaño definido (uint8_t, etc.)
 
-#define NUM_LEDS   64  // Define la cantidad total de LEDs en la matriz WS2812
+#include <avr/pgmspace.h>  // Se incluye para leer la tabla de mapeo de píxeles cuando se almacena en la memoria flash
+
+#ifndef WS2812_ANCHO  // Permite elegir el tamaño de la matriz desde las opciones del compilador (por ejemplo 16x16 o varios paneles)
+#define WS2812_ANCHO  8  // Define la cantidad de columnas de la matriz WS2812
+#endif  // Fin de la comprobación de WS2812_ANCHO
+#ifndef WS2812_ALTO  // Permite elegir la cantidad de filas desde las opciones del compilador
+#define WS2812_ALTO   8  // Define la cantidad de filas de la matriz WS2812
+#endif  // Fin de la comprobación de WS2812_ALTO
+#define NUM_LEDS   (WS2812_ANCHO * WS2812_ALTO)  // Define la cantidad total de LEDs en la matriz WS2812
 #define LED_PIN    PB0  // Define el pin físico del puerto B que se utiliza para la señal de datos de los LEDs
 
+// El buffer de colores se guarda siempre en orden lógico (fila por fila, índice = y * WS2812_ANCHO + x)
+// y el mapeo al cableado físico se aplica al enviar los datos en WS2812_MOSTRAR
+#define WS2812_MAPEO_PROGRESIVO  0  // Todas las filas del panel se cablean de izquierda a derecha
+#define WS2812_MAPEO_SERPENTINA  1  // Las filas impares del panel se cablean de derecha a izquierda
+#define WS2812_MAPEO_TABLA       2  // El orden físico lo define la tabla WS2812_TABLA_MAPEO en flash
+
+#ifndef WS2812_MAPEO  // Permite elegir el mapeo desde las opciones del compilador
+#define WS2812_MAPEO  WS2812_MAPEO_PROGRESIVO  // Mapeo por defecto: un único panel progresivo (comportamiento original)
+#endif  // Fin de la comprobación de WS2812_MAPEO
+
+#ifndef WS2812_ROTACION  // Permite indicar cómo está montado cada panel
+#define WS2812_ROTACION  0  // Rotación del panel en pasos de 90° en sentido horario (0 a 3)
+#endif  // Fin de la comprobación de WS2812_ROTACION
+
+#ifndef WS2812_PANEL_ANCHO  // Permite armar la matriz con varios paneles encadenados
+#define WS2812_PANEL_ANCHO  WS2812_ANCHO  // Columnas de cada panel (por defecto un único panel)
+#define WS2812_PANEL_ALTO   WS2812_ALTO  // Filas de cada panel (por defecto un único panel)
+#endif  // Fin de la comprobación de WS2812_PANEL_ANCHO
+
+#define WS2812_PANELES_X  (WS2812_ANCHO / WS2812_PANEL_ANCHO)  // Cantidad de paneles por fila, encadenados de izquierda a derecha y de arriba hacia abajo
+
+#if (WS2812_ANCHO % WS2812_PANEL_ANCHO) || (WS2812_ALTO % WS2812_PANEL_ALTO)  // Verifica que los paneles cubran la matriz completa
+#error "WS2812_ANCHO y WS2812_ALTO deben ser múltiplos del tamaño del panel"
+#endif  // Fin de la verificación del tamaño de los paneles
+#if (WS2812_ROTACION & 1) && (WS2812_PANEL_ANCHO != WS2812_PANEL_ALTO)  // Verifica que la rotación de 90° o 270° sea posible
+#error "Las rotaciones de 90 y 270 grados requieren paneles cuadrados"
+#endif  // Fin de la verificación de la rotación
+
+#if NUM_LEDS <= 256  // Se elige el tipo más chico capaz de indexar todos los LEDs
+typedef uint8_t ws2812_indice_t;  // Índice de LED de 8 bits (hasta una matriz de 16x16)
+#else  // Para matrices de más de 256 LEDs
+typedef uint16_t ws2812_indice_t;  // Índice de LED de 16 bits
+#endif  // Fin de la selección del tipo de índice
+
+#if WS2812_MAPEO == WS2812_MAPEO_TABLA  // Solo si el mapeo es por tabla
+extern const ws2812_indice_t WS2812_TABLA_MAPEO[NUM_LEDS] PROGMEM;  // Tabla que el programa debe definir: para cada posición física, el índice lógico del LED
+#endif  // Fin de la declaración de la tabla de mapeo
+
 void WS2812_INICIAR(void);  // Prototipo de función para inicializar el pin de control del WS2812
 void WS2812_MOSTRAR(uint8_t (*colores)[3]);  // Prototipo de función para enviar los colores actuales a todos los LEDs
 void WS2812_SETEAR_LED(uint8_t (*leds)[3], int indice, uint8_t r, uint8_t g, uint8_t b);  // Prototipo para asignar un color específico a un LED determinado
 void WS2812_LIMPIAR(uint8_t (*leds)[3]);  // Prototipo para apagar todos los LEDs estableciendo sus valores RGB en 0
-uint8_t WS2812_INDICE(uint8_t x, uint8_t y);  // Prototipo para calcular el índice lineal de un LED según sus coordenadas (x, y)
+uint16_t WS2812_INDICE(uint8_t x, uint8_t y);  // Prototipo para calcular el índice lógico de un LED según sus coordenadas (x, y)
+uint16_t WS2812_FISICO_A_LOGICO(uint16_t fisico);  // Prototipo que devuelve el índice lógico del LED conectado en una posición física de la cadena
 void WS2812_COLOR_ALEATORIO(uint8_t *r, uint8_t *g, uint8_t *b);  // Prototipo para generar un color aleatorio en formato RGB
 
 #endif  // Fin de la protección contra inclusiones múltiples del archivo